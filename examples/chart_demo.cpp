@@ -0,0 +1,31 @@
+/// @file chart_demo.cpp
+/// @brief Demonstration of Sparkline and Chart over a large series
+
+#include <scan/scan.hpp>
+
+#include <cmath>
+#include <iostream>
+
+int main() {
+    // A million samples: slow wave, fast ripple and a few spikes
+    scan::Chart chart;
+    scan::Sparkline spark;
+    chart.title("requests/s (1M samples)").width(70).height(10);
+    spark.width(40);
+
+    for (int i = 0; i < 1000000; i++) {
+        double v = 50 + 30 * std::sin(i / 40000.0) + 5 * std::sin(i / 300.0);
+        if (i % 250000 == 123456) {
+            v += 40;
+        }
+        chart.push(v);
+        spark.push(v);
+    }
+
+    std::cout << chart.render() << "\n\n";
+    std::cout << "trend " << spark.render() << "\n";
+
+    // Window over the most recent points only
+    std::cout << "last  " << spark.window(5000).render() << "\n";
+    return 0;
+}
@@ -0,0 +1,32 @@
+/// @file diffview_demo.cpp
+/// @brief Demonstration of the DiffView component
+
+#include <scan/scan.hpp>
+
+#include <iostream>
+
+int main(int argc, char *argv[]) {
+    scan::DiffView view;
+
+    if (argc > 2) {
+        view.files(argv[1], argv[2]);
+    } else {
+        // Two generated config dumps with a few scattered edits
+        std::string before, after;
+        for (int i = 0; i < 200000; i++) {
+            std::string line = "service." + std::to_string(i / 10) + ".option" + std::to_string(i % 10) + " = " +
+                               std::to_string(i * 7 % 1000) + "\n";
+            before += line;
+            if (i % 25000 == 1234) {
+                after += "service." + std::to_string(i / 10) + ".option" + std::to_string(i % 10) + " = changed\n";
+            } else if (i % 40000 != 999) {
+                after += line;
+            }
+        }
+        view.texts(before, after).names("before.conf", "after.conf");
+    }
+
+    std::cout << "n/p: next/previous hunk, s: side-by-side, q: quit\n";
+    view.height(30).alt_screen().run();
+    return 0;
+}
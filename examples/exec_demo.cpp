@@ -0,0 +1,33 @@
+/// @file exec_demo.cpp
+/// @brief Demonstration of the ExecView component streaming a command's output
+
+#include <scan/scan.hpp>
+
+#include <iostream>
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> command;
+    for (int i = 1; i < argc; i++) {
+        command.push_back(argv[i]);
+    }
+    if (command.empty()) {
+        // A noisy stand-in for a build: numbered lines with a progress counter
+        command = {"sh", "-c",
+                   "for i in $(seq 1 2000); do echo \"[$i/2000] compiling unit_$i.cpp\"; "
+                   "[ $((i % 500)) -eq 0 ] && echo \"warning: unit_$i.cpp is slow\" 1>&2; done; exit 0"};
+    }
+
+    auto code = scan::ExecView()
+                    .command(command)
+                    .title("$ " + command[0])
+                    .height(15)
+                    .max_lines(5000)
+                    .run();
+
+    if (code) {
+        std::cout << "\nCommand exited with " << *code << "\n";
+    } else {
+        std::cout << "\nCommand was cancelled or failed to start\n";
+    }
+    return code.value_or(1);
+}
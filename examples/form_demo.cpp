@@ -5,76 +5,33 @@
 #include <iostream>
 
 int main() {
-    std::cout << "=== User Registration Form ===\n\n";
-
-    // Step 1: Get username
-    std::cout << "Step 1 of 4\n";
-    auto username = scan::TextInput()
-        .prompt("Username: ")
-        .placeholder("Enter username")
-        .char_limit(20)
-        .run();
-
-    if (!username) {
-        std::cout << "Registration cancelled.\n";
-        return 1;
-    }
-
-    // Step 2: Get email
-    std::cout << "\nStep 2 of 4\n";
-    auto email = scan::TextInput()
-        .prompt("Email: ")
-        .placeholder("user@example.com")
-        .run();
-
-    if (!email) {
-        std::cout << "Registration cancelled.\n";
-        return 1;
-    }
-
-    // Step 3: Get password
-    std::cout << "\nStep 3 of 4\n";
-    auto password = scan::TextInput()
-        .prompt("Password: ")
-        .placeholder("Enter password")
-        .password(true)
-        .run();
-
-    if (!password) {
+    // Every field lives in one Program: Tab/Shift+Tab move between them,
+    // Enter advances, and only the field being edited is redrawn.
+    scan::Form form;
+    form.title("=== User Registration Form ===")
+        .input("username", scan::TextInput().prompt("Username: ").placeholder("Enter username").char_limit(20))
+        .input("email", scan::TextInput().prompt("Email: ").placeholder("user@example.com"))
+        .input("password", scan::TextInput().prompt("Password: ").placeholder("Enter password").password(true))
+        .text("Select your role:")
+        .list("role", scan::List().items({"Developer", "Designer", "Manager", "Other"}).cursor("> ").height(4))
+        .confirm("create", scan::Confirm().prompt("Create account?").affirmative("Create").negative("Cancel"));
+
+    if (!form.run()) {
         std::cout << "Registration cancelled.\n";
         return 1;
     }
 
-    // Step 4: Select role
-    std::cout << "\nStep 4 of 4\n";
-    std::cout << "Select your role:\n";
-    auto role = scan::List()
-        .items({"Developer", "Designer", "Manager", "Other"})
-        .cursor("> ")
-        .run();
-
-    if (!role) {
-        std::cout << "Registration cancelled.\n";
-        return 1;
-    }
-
-    // Confirmation
-    std::cout << "\n--- Review ---\n";
-    std::cout << "Username: " << *username << "\n";
-    std::cout << "Email: " << *email << "\n";
-    std::cout << "Password: " << std::string(password->length(), '*') << "\n";
-    std::cout << "Role: " << *role << "\n\n";
-
-    auto confirm = scan::Confirm()
-        .prompt("Create account?")
-        .affirmative("Create")
-        .negative("Cancel")
-        .run();
+    // Review
+    std::cout << "--- Review ---\n";
+    std::cout << "Username: " << form.value("username").value_or("") << "\n";
+    std::cout << "Email: " << form.value("email").value_or("") << "\n";
+    std::cout << "Password: " << std::string(form.value("password").value_or("").length(), '*') << "\n";
+    std::cout << "Role: " << form.value("role").value_or("") << "\n\n";
 
-    if (confirm && *confirm) {
-        std::cout << "\n✓ Account created successfully!\n";
+    if (form.value("create") == std::string("yes")) {
+        std::cout << "✓ Account created successfully!\n";
     } else {
-        std::cout << "\n✗ Account creation cancelled.\n";
+        std::cout << "✗ Account creation cancelled.\n";
     }
 
     return 0;
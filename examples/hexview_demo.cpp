@@ -0,0 +1,25 @@
+/// @file hexview_demo.cpp
+/// @brief Demonstration of the HexView component on a memory-mapped file
+
+#include <scan/scan.hpp>
+
+#include <iostream>
+
+int main(int argc, char *argv[]) {
+    std::string path = argc > 1 ? argv[1] : argv[0]; // Default: view this binary
+
+    scan::HexView viewer;
+    viewer.file(path).title(path).height(24).alt_screen();
+    if (!viewer.model().message.empty()) {
+        std::cerr << viewer.model().message << "\n";
+        return 1;
+    }
+
+    auto offset = viewer.run();
+    if (offset) {
+        std::cout << "Selected offset: 0x" << std::hex << *offset << std::dec << " (" << *offset << ")\n";
+    } else {
+        std::cout << "Cancelled\n";
+    }
+    return 0;
+}
@@ -0,0 +1,32 @@
+/// @file logview_demo.cpp
+/// @brief Demonstration of the LogView component under a heavy stream of lines
+
+#include <scan/scan.hpp>
+
+#include <chrono>
+#include <thread>
+
+int main() {
+    const char *levels[] = {"DEBUG", "INFO", "INFO", "INFO", "WARN", "ERROR"};
+
+    scan::LogView()
+        .title("service.log  (/ filter, 1-5 level, t timestamps, q quit)")
+        .height(20)
+        .capacity(100000)
+        .run([&](const scan::LogEmit &emit) {
+            // About 200k lines per second, sent in small batches
+            for (int i = 0;; i++) {
+                std::string batch;
+                for (int j = 0; j < 200; j++) {
+                    int n = i * 200 + j;
+                    batch += std::string(levels[n % 6]) + " worker=" + std::to_string(n % 8) + " handled request " +
+                             std::to_string(n) + "\n";
+                }
+                if (!emit(batch)) {
+                    return;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    return 0;
+}
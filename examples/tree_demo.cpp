@@ -0,0 +1,39 @@
+/// @file tree_demo.cpp
+/// @brief Demonstration of the Tree component browsing the filesystem lazily
+
+#include <scan/scan.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char *argv[]) {
+    fs::path root = argc > 1 ? fs::path(argv[1]) : fs::current_path();
+
+    // Directories are read only when expanded, on a background thread
+    auto loader = [](const scan::TreeItem &parent) {
+        std::vector<scan::TreeItem> children;
+        for (const auto &entry : fs::directory_iterator(parent.key, fs::directory_options::skip_permission_denied)) {
+            bool is_dir = entry.is_directory() && !entry.is_symlink();
+            children.emplace_back(entry.path().filename().string(), entry.path().string(), is_dir);
+        }
+        std::sort(children.begin(), children.end(), [](const auto &a, const auto &b) {
+            return a.has_children != b.has_children ? a.has_children : a.label < b.label;
+        });
+        return children;
+    };
+
+    std::cout << "Browse " << root.string() << " (arrows/hjkl, space toggles, enter selects)\n";
+
+    scan::Tree tree;
+    auto chosen = tree.items({{root.string(), root.string(), true}}).loader(loader).async().height(20).run();
+
+    if (chosen) {
+        std::cout << "Selected: " << chosen->key << "\n";
+    } else {
+        std::cout << "Cancelled\n";
+    }
+    return 0;
+}
@@ -59,12 +59,18 @@
 
 // Core types and utilities
 #include <argu/core/arg.hpp>
+#include <argu/core/arg_ref.hpp>
 #include <argu/core/command.hpp>
 #include <argu/core/error.hpp>
 #include <argu/core/group.hpp>
 #include <argu/core/levenshtein.hpp>
+#include <argu/core/lookup.hpp>
+#include <argu/core/matchers.hpp>
+#include <argu/core/schema.hpp>
+#include <argu/core/tokens.hpp>
 #include <argu/core/types.hpp>
 #include <argu/core/validators.hpp>
+#include <argu/core/worker_pool.hpp>
 
 // Style and formatting
 #include <argu/style/colors.hpp>
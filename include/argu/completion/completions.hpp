@@ -410,6 +410,7 @@ namespace argu {
 
     // Implementation of Command::generate_completions
     inline std::string Command::generate_completions(Shell shell) const {
+        build_subcommands(); // The scripts describe every subcommand's options
         CompletionGenerator gen(*this);
         return gen.generate(shell);
     }
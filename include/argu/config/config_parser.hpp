@@ -3,6 +3,7 @@
 /// @file argu/config/config_parser.hpp
 /// @brief Configuration file parsing (INI, TOML-like, JSON-like)
 
+#include <argu/core/config.hpp>
 #include <argu/core/error.hpp>
 
 #include <algorithm>
@@ -12,6 +13,7 @@
 #include <optional>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -94,14 +96,31 @@ namespace argu {
         Json, ///< Simple JSON format
     };
 
+    /// Result of parsing a configuration file: the data, or the error describing why it could not be read
+    using ConfigResult = Expected<ConfigData, ConfigFileError>;
+
     /// Configuration file parser
     class ConfigParser {
       public:
         /// Parse configuration from file
+        ///
+        /// Throws ConfigFileError if the file cannot be read or parsed; see try_parse_file for a non-throwing variant.
         static ConfigData parse_file(const std::string &path, ConfigFormat format = ConfigFormat::Auto) {
+            return unwrap(try_parse_file(path, format));
+        }
+
+        /// Parse configuration from string
+        ///
+        /// Throws ConfigFileError on a syntax error; see try_parse_string for a non-throwing variant.
+        static ConfigData parse_string(const std::string &content, ConfigFormat format = ConfigFormat::Ini) {
+            return unwrap(try_parse_string(content, format));
+        }
+
+        /// Parse configuration from file, returning the error instead of throwing it
+        static ConfigResult try_parse_file(const std::string &path, ConfigFormat format = ConfigFormat::Auto) {
             std::ifstream file(path);
             if (!file.is_open()) {
-                throw ConfigFileError(path, "cannot open file");
+                return ConfigFileError(path, "cannot open file");
             }
 
             std::stringstream buffer;
@@ -123,8 +142,8 @@ namespace argu {
             }
         }
 
-        /// Parse configuration from string
-        static ConfigData parse_string(const std::string &content, ConfigFormat format = ConfigFormat::Ini) {
+        /// Parse configuration from string, returning the error instead of throwing it
+        static ConfigResult try_parse_string(const std::string &content, ConfigFormat format = ConfigFormat::Ini) {
             switch (format) {
             case ConfigFormat::Json:
                 return parse_json(content, "<string>");
@@ -134,6 +153,13 @@ namespace argu {
         }
 
       private:
+        static ConfigData unwrap(ConfigResult result) {
+            if (!result) {
+                ARGU_THROW(result.error());
+            }
+            return std::move(result).value();
+        }
+
         static ConfigFormat detect_format(const std::string &path) {
             auto dot_pos = path.rfind('.');
             if (dot_pos == std::string::npos)
@@ -161,7 +187,7 @@ namespace argu {
             return s.substr(start, end - start + 1);
         }
 
-        static ConfigData parse_ini(const std::string &content, const std::string &filename) {
+        static ConfigResult parse_ini(const std::string &content, const std::string &filename) {
             ConfigData data;
             std::istringstream stream(content);
             std::string line;
@@ -180,7 +206,7 @@ namespace argu {
                 if (line[0] == '[') {
                     auto end = line.find(']');
                     if (end == std::string::npos) {
-                        throw ConfigFileError(filename, "unterminated section at line " + std::to_string(line_num));
+                        return ConfigFileError(filename, "unterminated section at line " + std::to_string(line_num));
                     }
                     current_section = trim(line.substr(1, end - 1));
                     continue;
@@ -193,7 +219,7 @@ namespace argu {
                     eq_pos = line.find(':');
                 }
                 if (eq_pos == std::string::npos) {
-                    throw ConfigFileError(filename, "invalid syntax at line " + std::to_string(line_num));
+                    return ConfigFileError(filename, "invalid syntax at line " + std::to_string(line_num));
                 }
 
                 std::string key = trim(line.substr(0, eq_pos));
@@ -244,7 +270,7 @@ namespace argu {
             return data;
         }
 
-        static ConfigData parse_json(const std::string &content, const std::string &filename) {
+        static ConfigResult parse_json(const std::string &content, const std::string &filename) {
             ConfigData data;
 
             // Simple JSON parser (handles basic object with string/array values)
@@ -254,9 +280,12 @@ namespace argu {
                     ++pos;
             };
 
-            auto parse_string = [&]() -> std::string {
+            // Errors inside parse_string are recorded here; the lambda then returns nullopt
+            std::optional<ConfigFileError> error;
+            auto parse_string = [&]() -> std::optional<std::string> {
                 if (content[pos] != '"') {
-                    throw ConfigFileError(filename, "expected '\"' at position " + std::to_string(pos));
+                    error = ConfigFileError(filename, "expected '\"' at position " + std::to_string(pos));
+                    return std::nullopt;
                 }
                 ++pos;
                 std::string result;
@@ -289,7 +318,8 @@ namespace argu {
                     ++pos;
                 }
                 if (pos >= content.size()) {
-                    throw ConfigFileError(filename, "unterminated string");
+                    error = ConfigFileError(filename, "unterminated string");
+                    return std::nullopt;
                 }
                 ++pos; // Skip closing quote
                 return result;
@@ -297,7 +327,7 @@ namespace argu {
 
             skip_ws();
             if (pos >= content.size() || content[pos] != '{') {
-                throw ConfigFileError(filename, "expected '{' at start of JSON");
+                return ConfigFileError(filename, "expected '{' at start of JSON");
             }
             ++pos;
 
@@ -307,18 +337,25 @@ namespace argu {
                     break;
 
                 // Parse key
-                std::string key = parse_string();
+                auto key = parse_string();
+                if (!key) {
+                    return *error;
+                }
                 skip_ws();
 
                 if (content[pos] != ':') {
-                    throw ConfigFileError(filename, "expected ':' after key");
+                    return ConfigFileError(filename, "expected ':' after key");
                 }
                 ++pos;
                 skip_ws();
 
                 // Parse value (string or array)
                 if (content[pos] == '"') {
-                    data.set(key, parse_string());
+                    auto value = parse_string();
+                    if (!value) {
+                        return *error;
+                    }
+                    data.set(*key, *value);
                 } else if (content[pos] == '[') {
                     ++pos;
                     std::vector<std::string> values;
@@ -326,20 +363,24 @@ namespace argu {
                         skip_ws();
                         if (content[pos] == ']')
                             break;
-                        values.push_back(parse_string());
+                        auto value = parse_string();
+                        if (!value) {
+                            return *error;
+                        }
+                        values.push_back(std::move(*value));
                         skip_ws();
                         if (content[pos] == ',')
                             ++pos;
                     }
                     ++pos; // Skip ]
-                    data.set(key, values);
+                    data.set(*key, values);
                 } else if (content[pos] == 't' || content[pos] == 'f') {
                     // Boolean
                     if (content.substr(pos, 4) == "true") {
-                        data.set(key, "true");
+                        data.set(*key, "true");
                         pos += 4;
                     } else if (content.substr(pos, 5) == "false") {
-                        data.set(key, "false");
+                        data.set(*key, "false");
                         pos += 5;
                     }
                 } else if (std::isdigit(static_cast<unsigned char>(content[pos])) || content[pos] == '-') {
@@ -350,9 +391,9 @@ namespace argu {
                             content[pos] == '-' || content[pos] == 'e' || content[pos] == 'E')) {
                         ++pos;
                     }
-                    data.set(key, content.substr(start, pos - start));
+                    data.set(*key, content.substr(start, pos - start));
                 } else {
-                    throw ConfigFileError(filename, "unexpected character at position " + std::to_string(pos));
+                    return ConfigFileError(filename, "unexpected character at position " + std::to_string(pos));
                 }
 
                 skip_ws();
@@ -3,6 +3,7 @@
 /// @file argu/core/arg.hpp
 /// @brief Argument definition with builder pattern (CLAP-style)
 
+#include <argu/core/arg_ref.hpp>
 #include <argu/core/error.hpp>
 #include <argu/core/types.hpp>
 
@@ -12,6 +13,7 @@
 #include <functional>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace argu {
@@ -401,6 +403,16 @@ namespace argu {
             return *this;
         }
 
+        /// Deliver each value to `sink` as it is read instead of storing it (positional arguments)
+        ///
+        /// Values are transformed and validated first. The match keeps only a count (occurrences), so a list
+        /// of any length, e.g. from a response file, is processed in constant memory. The string passed is
+        /// reused for the next value. The sink also runs in const parses, where it may be called concurrently.
+        Arg &stream_to(ValueCallback sink) {
+            m_stream = std::move(sink);
+            return *this;
+        }
+
         /// Add a callback for flag values
         Arg &on_flag(FlagCallback cb) {
             m_flag_callbacks.push_back(std::move(cb));
@@ -413,6 +425,12 @@ namespace argu {
             return *this;
         }
 
+        /// Bind a typed handle; its values are converted once, when parsing finishes
+        template <typename T> Arg &bind(const ArgRef<T> &handle) {
+            m_sinks.push_back(handle.sink());
+            return *this;
+        }
+
         /// Add a callback that transforms and validates the value
         Arg &each(std::function<std::string(const std::string &)> transform) {
             m_transformers.push_back(std::move(transform));
@@ -575,6 +593,9 @@ namespace argu {
         bool is_last_wins() const { return m_last_wins; }
         std::size_t get_max_occurrences() const { return m_max_occurrences; }
 
+        /// Dense ID assigned when the argument is added to a command: its slot in Matches
+        std::size_t id() const { return m_id; }
+
         /// Check if this arg matches a short option
         bool matches_short(char c) const { return m_short.has_value() && m_short.value() == c; }
 
@@ -604,9 +625,9 @@ namespace argu {
         }
 
         /// Check if this is a negated match (--no-flag)
-        bool is_negated_match(const std::string &name) const {
+        bool is_negated_match(std::string_view name) const {
             if (m_negatable && m_long.has_value()) {
-                return name == "no-" + *m_long;
+                return name.starts_with("no-") && name.substr(3) == *m_long;
             }
             return false;
         }
@@ -622,14 +643,19 @@ namespace argu {
         }
 
         /// Apply transformers to a value
-        std::string apply_transformers(const std::string &value) const {
-            std::string result = value;
+        std::string apply_transformers(std::string value) const {
             for (const auto &t : m_transformers) {
-                result = t(result);
+                value = t(value);
             }
-            return result;
+            return value;
         }
 
+        /// True if values go to a stream_to() sink instead of the match
+        bool is_streamed() const { return static_cast<bool>(m_stream); }
+
+        /// Hand a value to the stream_to() sink
+        void stream_value(const std::string &value) const { m_stream(value); }
+
         /// Apply value to bound target
         void apply_value(const std::string &value) const {
             // Invoke value callbacks
@@ -801,6 +827,7 @@ namespace argu {
         std::vector<Validator> m_validators;
         std::vector<Transformer> m_transformers;
         std::vector<ValueCallback> m_value_callbacks;
+        ValueCallback m_stream;
         std::vector<FlagCallback> m_flag_callbacks;
         std::vector<CountCallback> m_count_callbacks;
         std::function<void()> m_missing_callback;
@@ -837,6 +864,8 @@ namespace argu {
         bool m_global = false;
         void *m_target = nullptr;
         TargetType m_target_type = TargetType::None;
+        std::vector<detail::MatchSink> m_sinks;
+        std::size_t m_id = 0;
     };
 
 } // namespace argu
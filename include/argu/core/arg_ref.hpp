@@ -0,0 +1,89 @@
+#pragma once
+
+/// @file argu/core/arg_ref.hpp
+/// @brief Typed handles to parsed values, converted once while parsing
+
+#include <argu/core/types.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace argu {
+
+    namespace detail {
+        /// Converts a finished match into a handle's storage; returns the first value that failed to convert
+        using MatchSink = std::function<std::optional<std::string>(const ArgMatch &)>;
+
+        template <typename T> struct TypedValues {
+            std::vector<T> values;
+            T first{}; // Copy of values.front(), so get() can return a reference even for std::vector<bool>
+            std::size_t occurrences = 0;
+            ValueSource source = ValueSource::Default;
+        };
+    } // namespace detail
+
+    /// Typed handle to one argument's parsed values
+    ///
+    /// Bind it with `Arg::bind(handle)`. The parser converts each value to T
+    /// once, after defaults are applied; reading the handle afterwards is a
+    /// plain member access with no name lookup or string conversion. A value
+    /// that does not convert to T fails the parse with an InvalidValueError.
+    /// Copies share the same storage.
+    ///
+    ///     argu::ArgRef<int> jobs;
+    ///     auto cmd = argu::Command("make").arg(argu::Arg("jobs").short_name('j').default_value("1").bind(jobs));
+    ///     cmd.parse(argc, argv);
+    ///     for (...) { if (*jobs > 1) ... }
+    template <typename T> class ArgRef {
+      public:
+        ArgRef() : m_data(std::make_shared<detail::TypedValues<T>>()) {}
+
+        /// True if the argument was given, came from the environment or a config file, or has a default
+        bool present() const { return m_data->occurrences > 0; }
+        explicit operator bool() const { return present(); }
+
+        std::size_t occurrences() const { return m_data->occurrences; }
+        ValueSource source() const { return m_data->source; }
+
+        /// First value (as Matches::get<T> returns); a value-initialized T if there is none
+        ///
+        /// For flags, which take no value, ArgRef<bool> yields whether the flag is present.
+        const T &get() const { return m_data->first; }
+        const T &operator*() const { return get(); }
+        const T *operator->() const { return &get(); }
+
+        /// Every value, in the order given
+        const std::vector<T> &values() const { return m_data->values; }
+
+        /// Conversion step run by the parser for the bound argument
+        detail::MatchSink sink() const {
+            return [data = m_data](const ArgMatch &match) -> std::optional<std::string> {
+                data->values.clear();
+                data->occurrences = match.occurrences;
+                data->source = match.source;
+                for (const auto &value : match.values) {
+                    auto converted = detail::Converter<T>::convert(value);
+                    if (!converted) {
+                        return value;
+                    }
+                    data->values.push_back(std::move(*converted));
+                }
+                if constexpr (std::is_same_v<T, bool>) {
+                    if (match.values.empty() && match.occurrences > 0) {
+                        data->values.push_back(true);
+                    }
+                }
+                data->first = data->values.empty() ? T{} : T(data->values.front());
+                return std::nullopt;
+            };
+        }
+
+      private:
+        std::shared_ptr<detail::TypedValues<T>> m_data;
+    };
+
+} // namespace argu
@@ -6,6 +6,7 @@
 #include <argu/core/arg.hpp>
 #include <argu/core/error.hpp>
 #include <argu/core/group.hpp>
+#include <argu/core/lookup.hpp>
 #include <argu/core/types.hpp>
 #include <argu/style/colors.hpp>
 
@@ -16,6 +17,8 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -65,8 +68,17 @@ namespace argu {
     };
 
     /// Matches - result of parsing containing matched arguments
+    ///
+    /// Matches are stored in an array indexed by argument ID (see Arg::id()),
+    /// with a hash table from names to IDs, so every query below is a single
+    /// hash probe. For values read in hot loops, bind an ArgRef instead: it is
+    /// converted once while parsing and needs no lookup at all.
+    ///
+    /// Every parse starts from a copy of the command's empty layout; the name
+    /// table is shared by those copies rather than rebuilt.
     class Matches {
         friend class Parser;
+        friend class Command;
 
       public:
         Matches() = default;
@@ -78,7 +90,7 @@ namespace argu {
 
         // Copy constructor - deep copies subcommand matches
         Matches(const Matches &other)
-            : m_matches(other.m_matches), m_subcommand(other.m_subcommand),
+            : m_matches(other.m_matches), m_ids(other.m_ids), m_subcommand(other.m_subcommand),
               m_external_subcommand(other.m_external_subcommand), m_external_args(other.m_external_args) {
             if (other.m_subcommand_matches) {
                 m_subcommand_matches = std::make_unique<Matches>(*other.m_subcommand_matches);
@@ -89,6 +101,7 @@ namespace argu {
         Matches &operator=(const Matches &other) {
             if (this != &other) {
                 m_matches = other.m_matches;
+                m_ids = other.m_ids;
                 m_subcommand = other.m_subcommand;
                 m_external_subcommand = other.m_external_subcommand;
                 m_external_args = other.m_external_args;
@@ -102,57 +115,52 @@ namespace argu {
         }
 
         /// Check if an argument was present
-        bool contains(const std::string &name) const {
-            return std::any_of(m_matches.begin(), m_matches.end(),
-                               [&](const ArgMatch &m) { return m.name == name && m.occurrences > 0; });
+        bool contains(std::string_view name) const {
+            const ArgMatch *m = find_match(name);
+            return m && m->occurrences > 0;
         }
 
         /// Get number of occurrences of an argument
-        std::size_t occurrences(const std::string &name) const {
-            auto it =
-                std::find_if(m_matches.begin(), m_matches.end(), [&](const ArgMatch &m) { return m.name == name; });
-            return it != m_matches.end() ? it->occurrences : 0;
+        std::size_t occurrences(std::string_view name) const {
+            const ArgMatch *m = find_match(name);
+            return m ? m->occurrences : 0;
         }
 
         /// Get single value as string
-        std::optional<std::string> get_one(const std::string &name) const {
-            auto it =
-                std::find_if(m_matches.begin(), m_matches.end(), [&](const ArgMatch &m) { return m.name == name; });
-            if (it != m_matches.end() && !it->values.empty()) {
-                return it->values.front();
+        std::optional<std::string> get_one(std::string_view name) const {
+            const ArgMatch *m = find_match(name);
+            if (m && !m->values.empty()) {
+                return m->values.front();
             }
             return std::nullopt;
         }
 
         /// Get all values as strings
-        std::vector<std::string> get_many(const std::string &name) const {
-            auto it =
-                std::find_if(m_matches.begin(), m_matches.end(), [&](const ArgMatch &m) { return m.name == name; });
-            if (it != m_matches.end()) {
-                return it->values;
-            }
-            return {};
+        const std::vector<std::string> &get_many(std::string_view name) const {
+            static const std::vector<std::string> none;
+            const ArgMatch *m = find_match(name);
+            return m ? m->values : none;
         }
 
-        /// Get value converted to type T
-        template <typename T> std::optional<T> get(const std::string &name) const {
-            auto str = get_one(name);
-            if (!str)
+        /// Get value converted to type T (converted on every call; see ArgRef for hot paths)
+        template <typename T> std::optional<T> get(std::string_view name) const {
+            const ArgMatch *m = find_match(name);
+            if (!m || m->values.empty())
                 return std::nullopt;
-            return detail::Converter<T>::convert(*str);
+            return detail::Converter<T>::convert(m->values.front());
         }
 
         /// Get value with default
-        template <typename T> T get_or(const std::string &name, const T &default_value) const {
+        template <typename T> T get_or(std::string_view name, const T &default_value) const {
             auto result = get<T>(name);
             return result.value_or(default_value);
         }
 
         /// Get flag value (true if present)
-        bool get_flag(const std::string &name) const { return contains(name); }
+        bool get_flag(std::string_view name) const { return contains(name); }
 
         /// Get count value
-        std::size_t get_count(const std::string &name) const { return occurrences(name); }
+        std::size_t get_count(std::string_view name) const { return occurrences(name); }
 
         /// Get subcommand name if any was matched
         std::optional<std::string> subcommand() const { return m_subcommand; }
@@ -188,50 +196,61 @@ namespace argu {
         const std::vector<std::string> &external_args() const { return m_external_args; }
 
         /// Check if value came from environment variable
-        bool is_from_env(const std::string &name) const {
-            auto it =
-                std::find_if(m_matches.begin(), m_matches.end(), [&](const ArgMatch &m) { return m.name == name; });
-            return it != m_matches.end() && it->from_env;
+        bool is_from_env(std::string_view name) const {
+            const ArgMatch *m = find_match(name);
+            return m && m->from_env;
         }
 
         /// Check if value came from config file
-        bool is_from_config(const std::string &name) const {
-            auto it =
-                std::find_if(m_matches.begin(), m_matches.end(), [&](const ArgMatch &m) { return m.name == name; });
-            return it != m_matches.end() && it->from_config;
+        bool is_from_config(std::string_view name) const {
+            const ArgMatch *m = find_match(name);
+            return m && m->from_config;
         }
 
         /// Get the source of a value (precedence tracking)
-        ValueSource value_source(const std::string &name) const {
-            auto it =
-                std::find_if(m_matches.begin(), m_matches.end(), [&](const ArgMatch &m) { return m.name == name; });
-            if (it != m_matches.end()) {
-                return it->source;
-            }
-            return ValueSource::Default;
+        ValueSource value_source(std::string_view name) const {
+            const ArgMatch *m = find_match(name);
+            return m ? m->source : ValueSource::Default;
         }
 
       private:
-        std::vector<ArgMatch> m_matches;
+        using IdMap = std::unordered_map<std::string, std::size_t, detail::NameHash, std::equal_to<>>;
+
+        std::vector<ArgMatch> m_matches;  // Indexed by argument ID
+        std::shared_ptr<IdMap> m_ids;     // Shared with copies, so copied before a name is added to a shared one
         std::optional<std::string> m_subcommand;
         std::unique_ptr<Matches> m_subcommand_matches;
         bool m_external_subcommand = false;
         std::vector<std::string> m_external_args;
 
-        void add_match(ArgMatch match) { m_matches.push_back(std::move(match)); }
-
-        ArgMatch *find_match(const std::string &name) {
-            auto it =
-                std::find_if(m_matches.begin(), m_matches.end(), [&](const ArgMatch &m) { return m.name == name; });
-            return it != m_matches.end() ? &(*it) : nullptr;
+        /// ID for a name, allocating an empty slot the first time the name is seen
+        std::size_t id_of(const std::string &name) {
+            if (m_ids) {
+                auto it = m_ids->find(name);
+                if (it != m_ids->end()) {
+                    return it->second;
+                }
+            }
+            // Copy on write: matches from earlier parses may still hold the current table
+            if (!m_ids) {
+                m_ids = std::make_shared<IdMap>();
+            } else if (m_ids.use_count() > 1) {
+                m_ids = std::make_shared<IdMap>(*m_ids);
+            }
+            m_ids->emplace(name, m_matches.size());
+            m_matches.push_back(ArgMatch{name, {}, 0, false, false});
+            return m_matches.size() - 1;
         }
 
-        ArgMatch &get_or_create_match(const std::string &name) {
-            if (auto *m = find_match(name)) {
-                return *m;
+        ArgMatch &at(std::size_t id) { return m_matches[id]; }
+        bool present(std::size_t id) const { return m_matches[id].occurrences > 0; }
+
+        const ArgMatch *find_match(std::string_view name) const {
+            if (!m_ids) {
+                return nullptr;
             }
-            m_matches.push_back(ArgMatch{name, {}, 0, false, false});
-            return m_matches.back();
+            auto it = m_ids->find(name);
+            return it != m_ids->end() ? &m_matches[it->second] : nullptr;
         }
     };
 
@@ -285,7 +304,9 @@ namespace argu {
             if (m_args.empty() && !m_disable_help) {
                 add_default_help();
             }
+            argument.m_id = m_layout.id_of(argument.name());
             m_args.push_back(std::move(argument));
+            invalidate();
             return *this;
         }
 
@@ -306,9 +327,24 @@ namespace argu {
         /// Add a subcommand
         Command &subcommand(Command cmd) {
             m_subcommands.push_back(std::make_shared<Command>(std::move(cmd)));
+            invalidate();
             return *this;
         }
 
+        /// Add a subcommand that is only built when it is needed
+        ///
+        /// `stub` is what the parent sees before that: its name, aliases, about
+        /// text and hidden flag are used for lookup and the parent's help. The
+        /// factory runs when parsing reaches the subcommand, or when finalize()
+        /// or generate_completions() needs the whole tree; its command replaces
+        /// the stub and should keep the same name and aliases.
+        ///
+        ///     cli.subcommand(argu::Command("logs").about("Print logs").alias("log"), build_logs);
+        Command &subcommand(Command stub, std::function<Command()> factory) {
+            stub.m_factory = std::move(factory);
+            return subcommand(std::move(stub));
+        }
+
         /// Require a subcommand
         Command &subcommand_required(bool required = true) {
             m_subcommand_required = required;
@@ -547,6 +583,44 @@ namespace argu {
             return *this;
         }
 
+        /// Set how many threads check the built-in filesystem validators (path_exists(), file_exists(), ...)
+        ///
+        /// By default (1) each path is checked as it is read, on the parsing thread. Above 1, paths are collected
+        /// and checked together once the command line has been read, on a worker pool shared by every parse.
+        Command &validation_threads(std::size_t threads) {
+            m_validation_threads = threads;
+            return *this;
+        }
+
+        /// Run batched work (see validation_threads()) on the application's own threads
+        ///
+        /// Without one, argu falls back to a small pool of its own. An application that
+        /// already has a thread pool should route it there instead, so the two do not
+        /// compete for cores; scan applications can pass scan::parallel_executor().
+        /// Subcommands without an executor of their own inherit this one.
+        Command &executor(Executor run) {
+            m_executor = std::move(run);
+            return *this;
+        }
+
+        /// Expand `@path` arguments into the arguments listed in the file (see also args_from())
+        ///
+        /// The file holds one argument per line, or NUL-separated arguments; it may name further response
+        /// files, up to `max_depth` levels deep. Set on the top-level command; subcommands read the same tokens.
+        Command &response_files(bool enable = true, std::size_t max_depth = 16) {
+            m_response_files = enable;
+            m_response_file_depth = max_depth;
+            return *this;
+        }
+
+        /// Read arguments from a file given as `--<arg_name> PATH`, or from standard input for `-`
+        ///
+        /// The file has the format of a response file (see response_files()). An empty name disables it.
+        Command &args_from(std::string arg_name = "args-from") {
+            m_args_from = std::move(arg_name);
+            return *this;
+        }
+
         /// Set maximum terminal width for help
         Command &max_term_width(std::size_t width) {
             m_max_term_width = width;
@@ -559,6 +633,37 @@ namespace argu {
         /// Parse arguments from vector
         ParseResult parse(const std::vector<std::string> &args);
 
+        /// Set up the whole subcommand tree for parsing, so the command is only read while parsing
+        ///
+        /// Builds lazy subcommands, adds the help and version flags, passes global
+        /// arguments down to subcommands and builds every lookup table. Afterwards
+        /// the const parse() overloads can run on any number of threads at once
+        /// against this one command. Adding arguments or subcommands undoes it;
+        /// call finalize() again after the last change.
+        Command &finalize() {
+            prepare();
+            for (const auto &sub : m_subcommands) {
+                sub->build();
+                inherit_into(*sub);
+                sub->finalize();
+            }
+            m_finalized = true;
+            return *this;
+        }
+
+        /// True once finalize() has run and nothing has been added since
+        bool is_finalized() const { return m_finalized; }
+
+        /// Parse into caller-owned matches, leaving the (finalized) command untouched
+        ///
+        /// Safe to call concurrently. Only `matches` is written: variables bound
+        /// with value_of(), flag() or ArgRef are not, as every parse would share
+        /// them. Callbacks still run, on the calling thread.
+        ParseResult parse(int argc, char *argv[], Matches &matches) const;
+
+        /// Parse a vector into caller-owned matches (see above)
+        ParseResult parse(const std::vector<std::string> &args, Matches &matches) const;
+
         /// Get matches (call after parse)
         Matches &matches() { return m_matches; }
         const Matches &matches() const { return m_matches; }
@@ -581,6 +686,7 @@ namespace argu {
         const std::vector<std::shared_ptr<Command>> &get_subcommands() const { return m_subcommands; }
         bool is_subcommand_required() const { return m_subcommand_required; }
         bool is_hidden() const { return m_hidden; }
+        bool is_lazy() const { return static_cast<bool>(m_factory); } // Registered with a factory and not built yet
         const std::vector<std::string> &get_aliases() const { return m_aliases; }
         const std::vector<std::string> &get_visible_aliases() const { return m_visible_aliases; }
         ColorMode get_color_mode() const { return m_color_mode; }
@@ -612,15 +718,13 @@ namespace argu {
         bool ignores_errors() const { return m_ignore_errors; }
         bool shows_help_on_error() const { return m_help_on_error; }
         ErrorMode get_error_mode() const { return m_error_mode; }
+        std::size_t get_validation_threads() const { return m_validation_threads; }
+        const Executor &get_executor() const { return m_executor; }
+        bool has_response_files() const { return m_response_files; }
+        const std::string &get_args_from() const { return m_args_from; }
         std::size_t get_max_term_width() const { return m_max_term_width; }
 
-        const Arg *find_arg_by_name(const std::string &name) const {
-            for (const auto &arg : m_args) {
-                if (arg.name() == name)
-                    return &arg;
-            }
-            return nullptr;
-        }
+        const Arg *find_arg_by_name(std::string_view name) const { return arg_at(index().names.find(name)); }
 
       private:
         std::string m_name;
@@ -642,7 +746,9 @@ namespace argu {
         std::function<void()> m_pre_parse;
         std::function<void(Matches &)> m_parse_complete;
         std::function<void(const Matches &)> m_final_callback;
-        Matches m_matches;
+        std::function<Command()> m_factory; // Set on the stub of a lazy subcommand until it is built
+        Matches m_layout;  // No values: argument IDs only; each parse starts from a copy
+        Matches m_matches; // Result of the last non-const parse()
         ColorMode m_color_mode = ColorMode::Auto;
         ConflictMode m_conflict_mode = ConflictMode::Error;
         HelpTheme m_theme;
@@ -661,6 +767,10 @@ namespace argu {
         std::map<std::string, int> m_group_order;
         std::size_t m_suggest_threshold = 3;
         std::size_t m_max_term_width = 100;
+        std::size_t m_validation_threads = 1; // 1 = check each path as it is read
+        Executor m_executor;                  // Empty = detail::WorkerPool
+        std::string m_args_from;              // Long name read by args_from(); empty = off
+        std::size_t m_response_file_depth = 16;
         int m_display_order = 0;
         bool m_subcommand_required = false;
         bool m_allow_external = false;
@@ -676,7 +786,157 @@ namespace argu {
         bool m_help_on_error = true;
         bool m_hidden = false;
         bool m_auto_exit = false;
+        bool m_response_files = false;
         ErrorMode m_error_mode = ErrorMode::FirstError;
+        bool m_finalized = false;
+        std::size_t m_trailing_id = 0; // Match slot for trailing_var_arg values
+        mutable detail::LookupIndex m_index;
+
+        /// Replace a lazy subcommand's stub with the command its factory builds (no-op once built)
+        void build() {
+            if (!m_factory) {
+                return;
+            }
+            auto factory = std::move(m_factory);
+            m_factory = nullptr;
+            *this = factory();
+        }
+
+        /// Build every lazy subcommand below this one (subcommands are shared_ptrs, so this works on a const command)
+        void build_subcommands() const {
+            for (const auto &sub : m_subcommands) {
+                sub->build();
+                sub->build_subcommands();
+            }
+        }
+
+        /// Forget the lookup tables and the finalized state after a structural change
+        void invalidate() {
+            m_index.built = false;
+            m_finalized = false;
+        }
+
+        /// Add the default flags and build the lookup tables (parse() does this for each command it reaches)
+        void prepare() {
+            ensure_default_flags();
+            if (!m_index.built) {
+                build_index();
+            }
+            if (m_trailing_var_arg) {
+                m_trailing_id = m_layout.id_of(m_trailing_values_name);
+            }
+        }
+
+        /// Pass global arguments, the executor (and the version, if propagated) down to a subcommand, once each
+        void inherit_into(Command &sub) const {
+            if (m_propagate_version && m_version && !sub.m_version) {
+                sub.m_version = m_version;
+            }
+            if (m_executor && !sub.m_executor) {
+                sub.m_executor = m_executor;
+            }
+            for (const auto &arg : m_args) {
+                if (!arg.is_global()) {
+                    continue;
+                }
+                bool inherited = std::any_of(sub.m_args.begin(), sub.m_args.end(),
+                                             [&arg](const Arg &own) { return own.name() == arg.name(); });
+                if (!inherited) {
+                    sub.m_args.push_back(arg);
+                    sub.m_args.back().m_id = sub.m_layout.id_of(arg.name());
+                    sub.invalidate();
+                }
+            }
+        }
+
+        /// Insert the help and version flags unless present or disabled
+        void ensure_default_flags() {
+            bool has_help = false;
+            bool has_version = false;
+            for (const auto &arg : m_args) {
+                has_help = has_help || arg.get_action() == ValueAction::Help;
+                has_version = has_version || arg.get_action() == ValueAction::Version;
+            }
+
+            bool add_help = !has_help && !m_disable_help;
+            if (add_help) {
+                auto it = m_args.insert(m_args.begin(), Arg("help")
+                                                            .short_name('h')
+                                                            .long_name("help")
+                                                            .help("Print help information")
+                                                            .flag()
+                                                            .action(ValueAction::Help));
+                it->m_id = m_layout.id_of(it->name());
+                invalidate();
+            }
+
+            if (!has_version && m_version && !m_disable_version) {
+                auto it = m_args.insert(m_args.begin() + (add_help ? 1 : 0), Arg("version")
+                                                                                 .short_name('V')
+                                                                                 .long_name("version")
+                                                                                 .help("Print version information")
+                                                                                 .flag()
+                                                                                 .action(ValueAction::Version));
+                it->m_id = m_layout.id_of(it->name());
+                invalidate();
+            }
+        }
+
+        /// Lookup tables for the current args and subcommands, built on first use
+        const detail::LookupIndex &index() const {
+            if (!m_index.built) {
+                build_index();
+            }
+            return m_index;
+        }
+
+        /// (Re)build the lookup tables; prepare() calls this once the default flags are in place
+        void build_index() const {
+            m_index.clear();
+            for (uint32_t i = 0; i < m_args.size(); ++i) {
+                const Arg &arg = m_args[i];
+                m_index.names.add(arg.name(), i, false);
+                if (arg.short_opt()) {
+                    auto &slot = m_index.shorts[static_cast<unsigned char>(*arg.short_opt())];
+                    if (slot == detail::LookupIndex::none) {
+                        slot = i;
+                    }
+                }
+                // The same names Arg::matches_long accepts; prefixes match long names and visible aliases
+                if (arg.long_opt()) {
+                    m_index.longs.add(*arg.long_opt(), i);
+                    if (arg.is_negatable()) {
+                        m_index.longs.add("no-" + *arg.long_opt(), i, false);
+                    }
+                }
+                for (const auto &alias : arg.get_visible_aliases()) {
+                    m_index.longs.add(alias, i);
+                }
+                for (const auto &alias : arg.get_hidden_aliases()) {
+                    m_index.longs.add(alias, i, false);
+                }
+                if (arg.get_renamed_from()) {
+                    m_index.longs.add(*arg.get_renamed_from(), i, false);
+                }
+                if (arg.is_positional()) {
+                    m_index.positionals.push_back(i);
+                }
+            }
+            std::stable_sort(m_index.positionals.begin(), m_index.positionals.end(), [this](uint32_t a, uint32_t b) {
+                return m_args[a].get_index().value_or(SIZE_MAX) < m_args[b].get_index().value_or(SIZE_MAX);
+            });
+            for (uint32_t i = 0; i < m_subcommands.size(); ++i) {
+                m_index.subcommands.add(m_subcommands[i]->m_name, i);
+                for (const auto &alias : m_subcommands[i]->m_aliases) {
+                    m_index.subcommands.add(alias, i);
+                }
+            }
+            m_index.longs.seal();
+            m_index.subcommands.seal();
+            m_index.built = true;
+        }
+
+        const Arg *arg_at(uint32_t slot) const { return slot == detail::LookupIndex::none ? nullptr : &m_args[slot]; }
 
         void add_default_help() {
             m_args.push_back(Arg("help")
@@ -685,6 +945,8 @@ namespace argu {
                                  .help("Print help information")
                                  .flag()
                                  .action(ValueAction::Help));
+            m_args.back().m_id = m_layout.id_of(m_args.back().name());
+            invalidate();
         }
 
         void add_default_version() {
@@ -695,61 +957,32 @@ namespace argu {
                                      .help("Print version information")
                                      .flag()
                                      .action(ValueAction::Version));
+                m_args.back().m_id = m_layout.id_of(m_args.back().name());
+                invalidate();
             }
         }
 
-        const Arg *find_arg_by_short(char c) const {
-            for (const auto &arg : m_args) {
-                if (arg.matches_short(c))
-                    return &arg;
-            }
-            return nullptr;
-        }
+        const Arg *find_arg_by_short(char c) const { return arg_at(index().shorts[static_cast<unsigned char>(c)]); }
 
-        const Arg *find_arg_by_long(const std::string &name) const {
-            for (const auto &arg : m_args) {
-                if (arg.matches_long(name))
-                    return &arg;
-            }
-            return nullptr;
-        }
-
-        Command *find_subcommand(const std::string &name) {
-            // First try exact match
-            for (auto &sub : m_subcommands) {
-                if (sub->m_name == name)
-                    return sub.get();
-                for (const auto &alias : sub->m_aliases) {
-                    if (alias == name)
-                        return sub.get();
-                }
-            }
+        const Arg *find_arg_by_long(std::string_view name) const { return arg_at(index().longs.find(name)); }
 
-            // Try prefix matching if enabled
-            if (m_allow_subcommand_prefix && !name.empty()) {
-                Command *match = nullptr;
-                int match_count = 0;
+        /// Unambiguous prefix of a long name or visible alias (for partial matching)
+        const Arg *find_arg_by_prefix(std::string_view prefix) const {
+            return arg_at(index().longs.find_unique_prefix(prefix));
+        }
 
-                for (auto &sub : m_subcommands) {
-                    if (sub->m_name.starts_with(name)) {
-                        match = sub.get();
-                        ++match_count;
-                    }
-                    for (const auto &alias : sub->m_aliases) {
-                        if (alias.starts_with(name)) {
-                            match = sub.get();
-                            ++match_count;
-                        }
-                    }
-                }
+        /// Positional arguments in the order they take values
+        const std::vector<uint32_t> &positional_slots() const { return index().positionals; }
 
-                // Only return if unambiguous match
-                if (match_count == 1) {
-                    return match;
-                }
+        /// Subcommands are held by shared_ptr, so even a const command hands out a mutable one (for prepare())
+        Command *find_subcommand(std::string_view name) const {
+            const auto &subs = index().subcommands;
+            uint32_t slot = subs.find(name);
+            // Try prefix matching if enabled (only an unambiguous prefix matches)
+            if (slot == detail::LookupIndex::none && m_allow_subcommand_prefix && !name.empty()) {
+                slot = subs.find_unique_prefix(name);
             }
-
-            return nullptr;
+            return slot == detail::LookupIndex::none ? nullptr : m_subcommands[slot].get();
         }
 
         /// Get all available short option names
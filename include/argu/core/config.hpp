@@ -0,0 +1,30 @@
+#pragma once
+
+/// @file argu/core/config.hpp
+/// @brief Build switches: header-only or compiled library, exceptions on or off
+///
+/// argu is header-only by default. When SCAN_COMPILED_LIB is defined (the CMake
+/// option SCAN_HEADER_ONLY=OFF does this), headers that have an `_impl.hpp`
+/// counterpart keep only declarations, and the definitions are compiled once
+/// into the library from src/argu/argu.cpp.
+
+#if !defined(SCAN_COMPILED_LIB) && !defined(SCAN_HEADER_ONLY)
+#define SCAN_HEADER_ONLY
+#endif
+
+#ifdef SCAN_HEADER_ONLY
+#define ARGU_INLINE inline
+#else
+#define ARGU_INLINE
+#endif
+
+// argu's parser never throws, so it also builds with exceptions disabled (-fno-exceptions).
+// The few convenience APIs that report failure by throwing abort instead in that case.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define ARGU_EXCEPTIONS 1
+#define ARGU_THROW(error) throw error
+#else
+#include <cstdlib>
+#define ARGU_EXCEPTIONS 0
+#define ARGU_THROW(error) (static_cast<void>(sizeof(error)), std::abort())
+#endif
@@ -5,6 +5,7 @@
 
 #include <exception>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -321,6 +322,20 @@ namespace argu {
         std::string m_reason;
     };
 
+    /// Error: Response file (@file or --args-from) could not be read
+    class ResponseFileError : public Error {
+      public:
+        ResponseFileError(const std::string &file, const std::string &reason)
+            : Error("Error in response file '" + file + "': " + reason), m_file(file), m_reason(reason) {}
+
+        const std::string &file() const noexcept { return m_file; }
+        const std::string &reason() const noexcept { return m_reason; }
+
+      private:
+        std::string m_file;
+        std::string m_reason;
+    };
+
     /// Special "error" for help/version display (exit code 0)
     class HelpRequested : public Error {
       public:
@@ -406,4 +421,30 @@ namespace argu {
         }
     };
 
+    /// A value, or the error that would otherwise have been thrown (a C++20 stand-in for std::expected)
+    template <typename T, typename E = Error> class Expected {
+      public:
+        Expected(T value) : m_value(std::move(value)) {}
+        Expected(E error) : m_error(std::move(error)) {}
+
+        bool has_value() const noexcept { return m_value.has_value(); }
+        explicit operator bool() const noexcept { return has_value(); }
+
+        /// The value; only valid when has_value()
+        T &value() & { return *m_value; }
+        const T &value() const & { return *m_value; }
+        T &&value() && { return std::move(*m_value); }
+        T &operator*() & { return *m_value; }
+        const T &operator*() const & { return *m_value; }
+        T *operator->() { return &*m_value; }
+        const T *operator->() const { return &*m_value; }
+
+        /// The error; only valid when !has_value()
+        const E &error() const & { return *m_error; }
+
+      private:
+        std::optional<T> m_value;
+        std::optional<E> m_error;
+    };
+
 } // namespace argu
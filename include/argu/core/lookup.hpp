@@ -0,0 +1,104 @@
+#pragma once
+
+/// @file argu/core/lookup.hpp
+/// @brief Lookup tables for resolving option and subcommand names while parsing
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace argu {
+    namespace detail {
+
+        /// Hash accepting std::string and std::string_view alike, so lookups never build a string
+        struct NameHash {
+            using is_transparent = void;
+            std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+        };
+
+        /// Names mapped to slots (indices into the owner's vector), for exact and prefix queries
+        ///
+        /// Exact lookup is a hash probe. Prefix lookup is a binary search over the
+        /// sorted names; a prefix is only accepted if exactly one name starts with it.
+        /// When a name is added twice the first slot wins, as in a front-to-back scan.
+        /// Call seal() after the last add() and before any prefix query.
+        class NameIndex {
+          public:
+            static constexpr uint32_t none = UINT32_MAX;
+
+            /// Add a name; `prefixable` names also take part in prefix queries
+            void add(const std::string &name, uint32_t slot, bool prefixable = true) {
+                m_exact.emplace(name, slot);
+                if (prefixable) {
+                    m_sorted.emplace_back(name, slot);
+                }
+            }
+
+            /// Sort the prefix table (equal names keep the order they were added in)
+            void seal() {
+                std::stable_sort(m_sorted.begin(), m_sorted.end(),
+                                 [](const auto &a, const auto &b) { return a.first < b.first; });
+            }
+
+            /// Slot registered for exactly this name, or none
+            uint32_t find(std::string_view name) const {
+                auto it = m_exact.find(name);
+                return it != m_exact.end() ? it->second : none;
+            }
+
+            /// Slot of the only prefixable name starting with `prefix`, or none (no match or ambiguous)
+            uint32_t find_unique_prefix(std::string_view prefix) const {
+                auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), prefix,
+                                           [](const auto &entry, std::string_view p) { return entry.first < p; });
+                if (it == m_sorted.end() || !it->first.starts_with(prefix)) {
+                    return none;
+                }
+                auto next = std::next(it);
+                if (next != m_sorted.end() && next->first.starts_with(prefix)) {
+                    return none;
+                }
+                return it->second;
+            }
+
+            void clear() {
+                m_exact.clear();
+                m_sorted.clear();
+            }
+
+          private:
+            std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> m_exact;
+            std::vector<std::pair<std::string, uint32_t>> m_sorted;
+        };
+
+        /// Everything a Command looks up per token, built once before parsing
+        ///
+        /// Slots are indices into the command's argument and subcommand vectors,
+        /// so the tables stay valid when the command is copied.
+        struct LookupIndex {
+            static constexpr uint32_t none = NameIndex::none;
+
+            NameIndex names;                    // Argument names (Arg("name"))
+            NameIndex longs;                    // Long names, aliases and --no- forms
+            std::array<uint32_t, 256> shorts{}; // Short flag character -> argument
+            std::vector<uint32_t> positionals;  // Positional arguments in index order
+            NameIndex subcommands;              // Subcommand names and aliases
+            bool built = false;
+
+            void clear() {
+                names.clear();
+                longs.clear();
+                shorts.fill(none);
+                positionals.clear();
+                subcommands.clear();
+                built = false;
+            }
+        };
+
+    } // namespace detail
+} // namespace argu
@@ -0,0 +1,250 @@
+#pragma once
+
+/// @file argu/core/matchers.hpp
+/// @brief Hand-written matchers for the formats checked by the built-in validators
+///
+/// Each matcher accepts exactly the strings the corresponding pattern in the
+/// comment accepts under std::regex_match, in one pass and without allocating.
+
+#include <cstddef>
+#include <string_view>
+
+namespace argu {
+    namespace detail {
+
+        constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+        constexpr bool is_lower(char c) { return c >= 'a' && c <= 'z'; }
+        constexpr bool is_alpha(char c) { return is_lower(c) || (c >= 'A' && c <= 'Z'); }
+        constexpr bool is_alnum(char c) { return is_alpha(c) || is_digit(c); }
+        constexpr bool is_hex(char c) { return is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'); }
+        constexpr bool is_space(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+        /// True if every character of s satisfies pred
+        template <typename Pred> constexpr bool all_chars(std::string_view s, Pred pred) {
+            for (char c : s) {
+                if (!pred(c))
+                    return false;
+            }
+            return true;
+        }
+
+        /// True if s is exactly `count` hex digits
+        constexpr bool is_hex_run(std::string_view s, std::size_t count) {
+            return s.size() == count && all_chars(s, is_hex);
+        }
+
+        /// `[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}`
+        constexpr bool match_email(std::string_view s) {
+            auto at = s.find('@');
+            if (at == 0 || at == std::string_view::npos)
+                return false;
+            auto local = s.substr(0, at);
+            auto domain = s.substr(at + 1);
+            auto local_char = [](char c) {
+                return is_alnum(c) || std::string_view("._%+-").find(c) != std::string_view::npos;
+            };
+            if (!all_chars(local, local_char))
+                return false;
+            if (!all_chars(domain, [](char c) { return is_alnum(c) || c == '.' || c == '-'; }))
+                return false;
+            // The top-level part has no dots, so it follows the last one
+            auto dot = domain.rfind('.');
+            return dot != std::string_view::npos && dot > 0 && domain.size() - dot - 1 >= 2 &&
+                   all_chars(domain.substr(dot + 1), is_alpha);
+        }
+
+        /// `https?://[^\s/$.?#].[^\s]*`
+        constexpr bool match_url(std::string_view s) {
+            if (s.starts_with("https://")) {
+                s.remove_prefix(8);
+            } else if (s.starts_with("http://")) {
+                s.remove_prefix(7);
+            } else {
+                return false;
+            }
+            if (s.size() < 2 || is_space(s[0]) || std::string_view("/$.?#").find(s[0]) != std::string_view::npos)
+                return false;
+            if (s[1] == '\n' || s[1] == '\r')
+                return false;
+            return all_chars(s.substr(2), [](char c) { return !is_space(c); });
+        }
+
+        /// `(\d{1,3}\.){3}\d{1,3}`; each octet is also checked to be at most 255
+        enum class Ipv4Match { Ok, BadFormat, OutOfRange };
+        constexpr Ipv4Match match_ipv4(std::string_view s) {
+            bool out_of_range = false;
+            for (int part = 0; part < 4; ++part) {
+                if (part > 0) {
+                    if (s.empty() || s[0] != '.')
+                        return Ipv4Match::BadFormat;
+                    s.remove_prefix(1);
+                }
+                int value = 0;
+                std::size_t digits = 0;
+                while (digits < s.size() && is_digit(s[digits])) {
+                    if (digits == 3)
+                        return Ipv4Match::BadFormat; // A fourth digit: stop before `value` can overflow
+                    value = value * 10 + (s[digits] - '0');
+                    ++digits;
+                }
+                if (digits < 1)
+                    return Ipv4Match::BadFormat;
+                out_of_range = out_of_range || value > 255;
+                s.remove_prefix(digits);
+            }
+            if (!s.empty())
+                return Ipv4Match::BadFormat;
+            return out_of_range ? Ipv4Match::OutOfRange : Ipv4Match::Ok;
+        }
+
+        /// `([0-9a-fA-F]{0,4}:){2,7}[0-9a-fA-F]{0,4}`
+        constexpr bool match_ipv6(std::string_view s) {
+            std::size_t colons = 0;
+            std::size_t run = 0;
+            for (char c : s) {
+                if (c == ':') {
+                    ++colons;
+                    run = 0;
+                } else if (!is_hex(c) || ++run > 4) {
+                    return false;
+                }
+            }
+            return colons >= 2 && colons <= 7;
+        }
+
+        /// Dot-separated labels of `[a-zA-Z0-9]([a-zA-Z0-9-]{0,61}[a-zA-Z0-9])?`
+        constexpr bool match_hostname(std::string_view s) {
+            while (true) {
+                auto dot = s.find('.');
+                auto label = s.substr(0, dot);
+                if (label.empty() || label.size() > 63 || !is_alnum(label.front()) || !is_alnum(label.back()) ||
+                    !all_chars(label, [](char c) { return is_alnum(c) || c == '-'; }))
+                    return false;
+                if (dot == std::string_view::npos)
+                    return true;
+                s.remove_prefix(dot + 1);
+            }
+        }
+
+        /// `0|[1-9]\d*`
+        constexpr bool is_numeric_id(std::string_view s) {
+            return !s.empty() && all_chars(s, is_digit) && (s.size() == 1 || s[0] != '0');
+        }
+
+        /// Dot-separated identifiers, each non-empty, made of `[0-9a-zA-Z-]` and accepted by valid()
+        template <typename Valid> constexpr bool match_dotted(std::string_view s, Valid valid) {
+            while (true) {
+                auto dot = s.find('.');
+                auto id = s.substr(0, dot);
+                if (id.empty() || !all_chars(id, [](char c) { return is_alnum(c) || c == '-'; }) || !valid(id))
+                    return false;
+                if (dot == std::string_view::npos)
+                    return true;
+                s.remove_prefix(dot + 1);
+            }
+        }
+
+        /// Semantic Versioning 2.0.0: `X.Y.Z[-prerelease][+build]`
+        constexpr bool match_semver(std::string_view s) {
+            auto plus = s.find('+');
+            if (plus != std::string_view::npos) {
+                if (!match_dotted(s.substr(plus + 1), [](std::string_view) { return true; }))
+                    return false;
+                s = s.substr(0, plus);
+            }
+            auto dash = s.find('-');
+            if (dash != std::string_view::npos) {
+                // A pre-release identifier is numeric without leading zeros, or contains a non-digit
+                auto prerelease_id = [](std::string_view id) { return is_numeric_id(id) || !all_chars(id, is_digit); };
+                if (!match_dotted(s.substr(dash + 1), prerelease_id))
+                    return false;
+                s = s.substr(0, dash);
+            }
+            for (int part = 0; part < 3; ++part) {
+                auto dot = s.find('.');
+                if ((part < 2) == (dot == std::string_view::npos) || !is_numeric_id(s.substr(0, dot)))
+                    return false;
+                s.remove_prefix(part < 2 ? dot + 1 : s.size());
+            }
+            return true;
+        }
+
+        /// Two digits forming a number in [min, max]
+        constexpr bool is_two_digit(std::string_view s, int min, int max) {
+            if (s.size() != 2 || !is_digit(s[0]) || !is_digit(s[1]))
+                return false;
+            int value = (s[0] - '0') * 10 + (s[1] - '0');
+            return value >= min && value <= max;
+        }
+
+        /// `\d{4}-(0[1-9]|1[0-2])-(0[1-9]|[12]\d|3[01])`
+        constexpr bool match_date_iso(std::string_view s) {
+            return s.size() == 10 && all_chars(s.substr(0, 4), is_digit) && s[4] == '-' &&
+                   is_two_digit(s.substr(5, 2), 1, 12) && s[7] == '-' && is_two_digit(s.substr(8, 2), 1, 31);
+        }
+
+        /// `([01]\d|2[0-3]):([0-5]\d):([0-5]\d)`
+        constexpr bool match_time_iso(std::string_view s) {
+            return s.size() == 8 && is_two_digit(s.substr(0, 2), 0, 23) && s[2] == ':' &&
+                   is_two_digit(s.substr(3, 2), 0, 59) && s[5] == ':' && is_two_digit(s.substr(6, 2), 0, 59);
+        }
+
+        /// `(\d+d)?(\d+h)?(\d+m)?(\d+s)?(\d+ms)?`, non-empty
+        constexpr bool match_compact_duration(std::string_view s) {
+            constexpr std::string_view units[] = {"d", "h", "m", "s", "ms"};
+            std::size_t next_unit = 0;
+            if (s.empty())
+                return false;
+            while (!s.empty()) {
+                std::size_t digits = 0;
+                while (digits < s.size() && is_digit(s[digits]))
+                    ++digits;
+                if (digits == 0)
+                    return false;
+                s.remove_prefix(digits);
+                // A unit is always followed by a number, so "ms" can only be the ms unit, never m then s
+                std::size_t unit = next_unit;
+                while (unit < 5 && !(s.starts_with(units[unit]) && (unit != 2 || !s.starts_with("ms"))))
+                    ++unit;
+                if (unit == 5)
+                    return false;
+                s.remove_prefix(units[unit].size());
+                next_unit = unit + 1;
+            }
+            return true;
+        }
+
+        /// `[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}`
+        constexpr bool match_uuid(std::string_view s) {
+            return s.size() == 36 && is_hex_run(s.substr(0, 8), 8) && s[8] == '-' && is_hex_run(s.substr(9, 4), 4) &&
+                   s[13] == '-' && is_hex_run(s.substr(14, 4), 4) && s[18] == '-' && is_hex_run(s.substr(19, 4), 4) &&
+                   s[23] == '-' && is_hex_run(s.substr(24), 12);
+        }
+
+        /// A UUID whose version digit is 4 and whose variant digit is one of `[89abAB]`
+        constexpr bool match_uuid_v4(std::string_view s) {
+            return match_uuid(s) && s[14] == '4' && std::string_view("89abAB").find(s[19]) != std::string_view::npos;
+        }
+
+        /// `#([0-9a-fA-F]{3}|[0-9a-fA-F]{6})`
+        constexpr bool match_hex_color(std::string_view s) {
+            return (s.size() == 4 || s.size() == 7) && s[0] == '#' && all_chars(s.substr(1), is_hex);
+        }
+
+        /// `[a-z][a-z0-9]*(<sep>[a-z0-9]+)*`
+        constexpr bool match_separated_lower(std::string_view s, char sep) {
+            if (s.empty() || !is_lower(s.front()) || s.back() == sep)
+                return false;
+            for (std::size_t i = 1; i < s.size(); ++i) {
+                if (s[i] == sep) {
+                    if (s[i - 1] == sep)
+                        return false;
+                } else if (!is_lower(s[i]) && !is_digit(s[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    } // namespace detail
+} // namespace argu
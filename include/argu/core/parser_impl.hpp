@@ -0,0 +1,1092 @@
+#pragma once
+
+/// @file argu/core/parser_impl.hpp
+/// @brief Argument parsing implementation
+///
+/// Included by parser.hpp in header-only builds, and compiled once into the
+/// library otherwise (see argu/core/config.hpp).
+
+#include <argu/config/config_parser.hpp>
+#include <argu/core/arg.hpp>
+#include <argu/core/command.hpp>
+#include <argu/core/config.hpp>
+#include <argu/core/error.hpp>
+#include <argu/core/levenshtein.hpp>
+#include <argu/core/tokens.hpp>
+#include <argu/core/validators.hpp>
+#include <argu/core/worker_pool.hpp>
+#include <argu/style/help_formatter.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace argu {
+
+    /// Internal parser implementation
+    ///
+    /// Reads the command and writes only `matches`, plus the bound targets
+    /// unless `shared` is set (a const parse against a finalized command).
+    class Parser {
+      public:
+        Parser(const Command &cmd, Matches &matches, bool shared = false)
+            : m_cmd(cmd), m_matches(matches), m_shared(shared) {}
+
+        /// Tokens are views into the caller's strings (argv or a vector); only stored values are copied
+        using Args = std::span<const std::string_view>;
+
+        /// Parse command line arguments
+        ParseResult parse(int argc, char *argv[]) {
+            std::vector<std::string_view> args;
+            args.reserve(argc > 1 ? static_cast<std::size_t>(argc - 1) : 0);
+
+            // Skip program name (argv[0])
+            for (int i = 1; i < argc; ++i) {
+                args.emplace_back(argv[i]);
+            }
+
+            return parse(Args(args));
+        }
+
+        /// Parse arguments from vector
+        ParseResult parse(const std::vector<std::string> &args) {
+            std::vector<std::string_view> views(args.begin(), args.end());
+            return parse(Args(views));
+        }
+
+        /// Parse arguments, expanding response files if the command enables them
+        ParseResult parse(Args args) {
+            detail::TokenStream tokens(args, m_cmd.m_response_files, m_cmd.m_args_from, m_cmd.m_response_file_depth);
+            return parse(tokens);
+        }
+
+        /// Parse the tokens; subcommands go on reading the same stream
+        ///
+        /// Nothing on this path throws: each step records the first error (or help/version output) in
+        /// m_stop and the remaining steps are skipped, so argu also builds with -fno-exceptions.
+        ParseResult parse(detail::TokenStream &tokens) {
+            m_tokens = &tokens;
+            run();
+
+            if (!m_stop) {
+                return ParseResult();
+            }
+            // Help or version output
+            if (m_stop->success() && m_cmd.m_auto_exit) {
+                std::cout << m_stop->message() << std::endl;
+                std::exit(0);
+            }
+            return *m_stop;
+        }
+
+      private:
+        const Command &m_cmd;
+        Matches &m_matches;
+        bool m_shared;                        // Leave bound targets alone; the command is finalized
+        std::size_t m_positional_index = 0;
+        bool m_positionals_only = false;      // After seeing --
+        AggregatedErrors m_aggregated_errors; // For ErrorMode::Aggregate
+        std::optional<ParseResult> m_stop;    // First error or help/version output; ends the parse
+        detail::TokenStream *m_tokens = nullptr;
+        std::string m_scratch;                // Current value of a streamed positional
+
+        /// A filesystem validator call deferred to run_path_checks()
+        struct PathCheck {
+            const Arg *arg;
+            detail::PathValidator check;
+            std::string value;
+        };
+        std::vector<PathCheck> m_path_checks; // In command-line order
+
+        void run() {
+            // Load config file if specified (named on the command line itself, not in a response file)
+            apply_config_file(m_tokens->argv_rest());
+            if (stopped())
+                return;
+
+            // Check environment variables first
+            apply_env_defaults();
+
+            // Parse the arguments
+            parse_args();
+
+            // Run the queued filesystem checks; they precede whatever token stopped the parse, so their errors win
+            run_path_checks();
+            if (stopped())
+                return;
+
+            // Validate required arguments
+            validate_required();
+            if (stopped())
+                return;
+
+            // Validate constraints
+            validate_constraints();
+            if (stopped())
+                return;
+
+            // Validate argument groups
+            validate_groups();
+            if (stopped())
+                return;
+
+            // If in aggregate mode and we collected errors, report them now
+            if (m_cmd.get_error_mode() == ErrorMode::Aggregate && !m_aggregated_errors.empty()) {
+                m_stop = ParseResult(m_aggregated_errors);
+                return;
+            }
+
+            // Apply defaults for missing values
+            apply_defaults();
+
+            // Convert values once for bound ArgRef handles
+            if (!m_shared) {
+                fill_handles();
+                if (stopped())
+                    return;
+            }
+
+            // Run callback if set
+            if (m_cmd.m_callback) {
+                m_cmd.m_callback(m_matches);
+            }
+        }
+
+        bool stopped() const { return m_stop.has_value(); }
+
+        /// End the parse with an error; the first one recorded wins
+        void fail(const Error &error) {
+            if (!m_stop) {
+                m_stop = ParseResult(error);
+            }
+        }
+
+        /// End the parse successfully with text to print (help or version)
+        void output(std::string text) {
+            if (!m_stop) {
+                m_stop = ParseResult(true, 0, std::move(text));
+            }
+        }
+
+        /// Read the next token; a response file that cannot be read ends the parse
+        bool next_token(std::string_view &token) {
+            if (m_tokens->next(token)) {
+                return true;
+            }
+            if (m_tokens->error()) {
+                fail(*m_tokens->error());
+            }
+            return false;
+        }
+
+        bool peek_token(std::string_view &token) {
+            if (m_tokens->peek(token)) {
+                return true;
+            }
+            if (m_tokens->error()) {
+                fail(*m_tokens->error());
+            }
+            return false;
+        }
+
+        /// Add an error (either end the parse now or collect it for later)
+        template <typename E> void add_error(E &&error) {
+            if (m_cmd.get_error_mode() == ErrorMode::Aggregate) {
+                m_aggregated_errors.add_error(std::forward<E>(error));
+            } else {
+                fail(error);
+            }
+        }
+
+        void apply_config_file(Args args) {
+            // First, apply layered config files (in order, lower priority first)
+            for (const auto &layer : m_cmd.m_config_layers) {
+                apply_single_config(layer.path, layer.required);
+                if (stopped())
+                    return;
+            }
+
+            // Then apply CLI-specified or default config file (highest priority)
+            if (!m_cmd.m_config_arg.empty()) {
+                std::string config_path;
+
+                // Look for config file argument
+                std::string flag = "--" + m_cmd.m_config_arg;
+                for (std::size_t i = 0; i < args.size(); ++i) {
+                    if (args[i] == flag && i + 1 < args.size()) {
+                        config_path = args[i + 1];
+                        break;
+                    }
+                    if (args[i].starts_with(flag) && args[i].size() > flag.size() && args[i][flag.size()] == '=') {
+                        config_path = args[i].substr(flag.size() + 1);
+                        break;
+                    }
+                }
+
+                // Use default if not specified
+                if (config_path.empty() && !m_cmd.m_default_config_path.empty()) {
+                    std::error_code ec;
+                    if (std::filesystem::exists(m_cmd.m_default_config_path, ec)) {
+                        config_path = m_cmd.m_default_config_path;
+                    }
+                }
+
+                if (!config_path.empty()) {
+                    apply_single_config(config_path, config_path != m_cmd.m_default_config_path);
+                }
+            }
+        }
+
+        void apply_single_config(const std::string &config_path, bool required) {
+            std::error_code ec;
+            if (!std::filesystem::exists(config_path, ec)) {
+                if (required) {
+                    fail(ConfigFileError(config_path, "file not found"));
+                }
+                return;
+            }
+
+            auto config = ConfigParser::try_parse_file(config_path);
+            if (!config) {
+                if (required) {
+                    fail(config.error());
+                }
+                return;
+            }
+
+            for (const auto &arg : m_cmd.m_args) {
+                // Try arg name
+                std::optional<std::string> value = config->get(arg.name());
+
+                // Try long name
+                if (!value && arg.long_opt()) {
+                    value = config->get(*arg.long_opt());
+                }
+
+                if (value) {
+                    auto &match = m_matches.at(arg.id());
+                    // Higher priority configs are processed last and override
+                    match.values.clear();
+                    match.values.push_back(*value);
+                    match.occurrences = 1;
+                    match.from_config = true;
+                    match.source = ValueSource::ConfigFile;
+                    set_value(arg, *value);
+                }
+            }
+        }
+
+        void apply_env_defaults() {
+            for (const auto &arg : m_cmd.m_args) {
+                // Try to get env var value from multiple sources (in priority order):
+                // 1. Explicit env var name set on the argument
+                // 2. Arg-level prefix + arg name
+                // 3. Command-level prefix + arg name
+                const char *env_val = nullptr;
+                std::string env_var_used;
+
+                // 1. Check explicit env var
+                if (arg.get_env()) {
+                    env_val = std::getenv(arg.get_env()->c_str());
+                    if (env_val) {
+                        env_var_used = *arg.get_env();
+                    }
+                }
+
+                // 2. Check arg-level prefix + arg name (uppercase, underscores)
+                if (!env_val && arg.get_env_prefix()) {
+                    std::string auto_var = make_env_var_name(*arg.get_env_prefix(), arg.name());
+                    env_val = std::getenv(auto_var.c_str());
+                    if (env_val) {
+                        env_var_used = auto_var;
+                    }
+                }
+
+                // 3. Check command-level prefix + arg name
+                if (!env_val && m_cmd.m_env_prefix) {
+                    std::string auto_var = make_env_var_name(*m_cmd.m_env_prefix, arg.name());
+                    env_val = std::getenv(auto_var.c_str());
+                    if (env_val) {
+                        env_var_used = auto_var;
+                    }
+                }
+
+                if (env_val) {
+                    auto &match = m_matches.at(arg.id());
+
+                    // Handle value delimiters for multi-value args
+                    if (arg.get_value_delimiter() && arg.get_action() == ValueAction::Append) {
+                        std::vector<std::string> split_values = split_by_delimiter(env_val, *arg.get_value_delimiter());
+                        for (const auto &val : split_values) {
+                            std::string transformed = arg.apply_transformers(val);
+                            match.values.push_back(transformed);
+                            add_value(arg, transformed);
+                        }
+                        match.occurrences = split_values.size();
+                    } else {
+                        std::string transformed = arg.apply_transformers(env_val);
+                        match.values.push_back(transformed);
+                        match.occurrences = 1;
+                        set_value(arg, transformed);
+                    }
+
+                    match.from_env = true;
+                    match.source = ValueSource::Environment;
+                }
+            }
+        }
+
+        /// Convert arg name to environment variable name
+        /// E.g., "my-option" with prefix "MYAPP_" becomes "MYAPP_MY_OPTION"
+        static std::string make_env_var_name(const std::string &prefix, const std::string &arg_name) {
+            std::string result = prefix;
+            for (char c : arg_name) {
+                if (c == '-' || c == '.') {
+                    result += '_';
+                } else {
+                    result += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+                }
+            }
+            return result;
+        }
+
+        /// Split a string by a delimiter
+        static std::vector<std::string> split_by_delimiter(std::string_view str, char delim) {
+            std::vector<std::string> result;
+            std::string current;
+            for (char c : str) {
+                if (c == delim) {
+                    if (!current.empty()) {
+                        result.push_back(current);
+                        current.clear();
+                    }
+                } else {
+                    current += c;
+                }
+            }
+            if (!current.empty()) {
+                result.push_back(current);
+            }
+            return result;
+        }
+
+        void parse_args() {
+            std::string_view arg;
+            while (next_token(arg)) {
+                if (m_positionals_only) {
+                    handle_positional(arg);
+                    if (stopped())
+                        return;
+                    continue;
+                }
+
+                if (arg == "--") {
+                    m_positionals_only = true;
+                    m_tokens->literal();
+                    continue;
+                }
+
+                if (arg.starts_with("--")) {
+                    handle_long_option(arg);
+                } else if (arg.starts_with("-") && arg.size() > 1) {
+                    handle_short_option(arg);
+                } else {
+                    // Check if it's a subcommand
+                    if (auto *sub = m_cmd.find_subcommand(arg)) {
+                        // Settle this command's filesystem checks before the subcommand runs (and its callback)
+                        run_path_checks();
+                        if (stopped())
+                            return;
+                        parse_subcommand(sub);
+                        return;
+                    }
+
+                    // Check if external subcommands are allowed
+                    if (m_cmd.m_allow_external && !m_cmd.m_subcommands.empty()) {
+                        // This might be an external subcommand - capture remaining args
+                        handle_external_subcommand(arg);
+                        return;
+                    }
+
+                    // Check for trailing var arg capture
+                    if (m_cmd.m_trailing_var_arg) {
+                        handle_trailing_args(arg);
+                        return;
+                    }
+
+                    handle_positional(arg);
+                }
+
+                if (stopped())
+                    return;
+            }
+        }
+
+        void handle_long_option(std::string_view token) {
+            std::string_view arg = token.substr(2); // Remove --
+            std::string_view value;
+            bool has_inline_value = false;
+
+            // Check for --option=value syntax
+            auto eq_pos = arg.find('=');
+            if (eq_pos != std::string::npos) {
+                value = arg.substr(eq_pos + 1);
+                arg = arg.substr(0, eq_pos);
+                has_inline_value = true;
+            }
+
+            const Arg *opt = m_cmd.find_arg_by_long(arg);
+
+            // Try partial matching if enabled and not found
+            if (!opt && m_cmd.m_allow_partial_matching) {
+                opt = m_cmd.find_arg_by_prefix(arg);
+            }
+
+            if (!opt) {
+                // Try to suggest similar options
+                auto suggestions = detail::find_closest_matches(std::string(arg), m_cmd.get_long_options(),
+                                                                m_cmd.get_suggest_threshold());
+                fail(UnknownArgumentError("--" + std::string(arg), [&suggestions]() {
+                    std::vector<std::string> result;
+                    for (const auto &s : suggestions)
+                        result.push_back("--" + s);
+                    return result;
+                }()));
+                return;
+            }
+
+            // Handle special actions
+            if (opt->get_action() == ValueAction::Help) {
+                output(m_cmd.help());
+                return;
+            }
+            if (opt->get_action() == ValueAction::Version) {
+                output(m_cmd.version_string());
+                return;
+            }
+
+            auto &match = m_matches.at(opt->id());
+
+            // Command line takes precedence - clear env/config values if "last wins" or first CLI occurrence
+            bool should_override = (match.source != ValueSource::CommandLine) ||
+                                   (opt->is_last_wins() || m_cmd.m_conflict_mode == ConflictMode::LastWins);
+
+            if (should_override && match.source != ValueSource::CommandLine) {
+                // First CLI value overrides env/config
+                match.values.clear();
+                match.occurrences = 0;
+            }
+
+            match.occurrences++;
+            match.source = ValueSource::CommandLine;
+
+            // Handle negatable flags
+            if (opt->is_negatable() && opt->is_negated_match(arg)) {
+                set_flag(*opt, false);
+                return;
+            }
+
+            if (opt->is_flag()) {
+                set_flag(*opt, opt->get_action() == ValueAction::StoreTrue);
+                return;
+            }
+
+            if (opt->is_count()) {
+                set_count(*opt, static_cast<int>(match.occurrences));
+                return;
+            }
+
+            // Get values
+            std::size_t first_new = match.values.size();
+            if (has_inline_value) {
+                // Handle value delimiter for multi-value in single arg
+                if (opt->get_value_delimiter()) {
+                    auto split_values = split_by_delimiter(value, *opt->get_value_delimiter());
+                    for (auto &v : split_values) {
+                        match.values.push_back(opt->apply_transformers(std::move(v)));
+                        if (opt->get_action() == ValueAction::Append) {
+                            add_value(*opt, match.values.back());
+                        }
+                    }
+                    if (!match.values.empty() && opt->get_action() != ValueAction::Append) {
+                        set_value(*opt, match.values.back());
+                    }
+                } else {
+                    store_value(*opt, match, value);
+                }
+            } else {
+                // Collect required values
+                std::size_t values_needed = opt->value_count().min;
+                std::size_t values_max = opt->value_count().max;
+                std::size_t collected = 0;
+
+                std::string_view next;
+                while (collected < values_max && peek_token(next)) {
+                    // Allow values starting with - if:
+                    // 1. allow_negative_numbers is true (for -42)
+                    // 2. allow_hyphen_values is true (for arbitrary - values)
+                    if (next.starts_with("-") && !m_cmd.m_allow_negative && !m_cmd.m_allow_hyphen_values) {
+                        break;
+                    }
+                    m_tokens->next(next);
+                    match.values.push_back(opt->apply_transformers(std::string(next)));
+                    if (opt->get_action() == ValueAction::Append) {
+                        add_value(*opt, match.values.back());
+                    }
+                    ++collected;
+                }
+
+                // If no values collected but has implicit value, use it
+                if (collected == 0 && opt->get_implicit_value()) {
+                    std::string transformed = opt->apply_transformers(*opt->get_implicit_value());
+                    match.values.push_back(transformed);
+                    set_value(*opt, transformed);
+                    return;
+                }
+
+                if (collected < values_needed) {
+                    fail(MissingValueError(opt->name()));
+                    return;
+                }
+
+                if (!match.values.empty() && opt->get_action() != ValueAction::Append) {
+                    set_value(*opt, match.values.back());
+                }
+            }
+
+            // Validate choices and run validators on the values this occurrence added
+            if (validate_choices(*opt, added_since(match, first_new))) {
+                validate_value(*opt, added_since(match, first_new));
+            }
+        }
+
+        void handle_short_option(std::string_view arg) {
+            // Handle combined short options like -abc
+            for (std::size_t j = 1; j < arg.size(); ++j) {
+                char c = arg[j];
+                const Arg *opt = m_cmd.find_arg_by_short(c);
+
+                if (!opt) {
+                    // Try to suggest
+                    auto suggestions = detail::find_closest_matches(std::string(1, c), m_cmd.get_short_options(), 1);
+                    std::vector<std::string> formatted;
+                    for (const auto &s : suggestions)
+                        formatted.push_back("-" + s);
+                    fail(UnknownArgumentError(std::string("-") + c, formatted));
+                    return;
+                }
+
+                // Handle special actions
+                if (opt->get_action() == ValueAction::Help) {
+                    output(m_cmd.help());
+                    return;
+                }
+                if (opt->get_action() == ValueAction::Version) {
+                    output(m_cmd.version_string());
+                    return;
+                }
+
+                auto &match = m_matches.at(opt->id());
+
+                // Command line takes precedence
+                if (match.source != ValueSource::CommandLine) {
+                    match.values.clear();
+                    match.occurrences = 0;
+                }
+
+                match.occurrences++;
+                match.source = ValueSource::CommandLine;
+
+                if (opt->is_flag()) {
+                    set_flag(*opt, opt->get_action() == ValueAction::StoreTrue);
+                    continue;
+                }
+
+                if (opt->is_count()) {
+                    set_count(*opt, static_cast<int>(match.occurrences));
+                    continue;
+                }
+
+                // Option takes a value
+                std::string_view value;
+
+                // Check if remaining chars are the value: -oVALUE
+                if (j + 1 < arg.size()) {
+                    value = arg.substr(j + 1);
+                    j = arg.size(); // Exit loop
+                } else if (!next_token(value)) {
+                    // Next arg is the value
+                    fail(MissingValueError(opt->name()));
+                    return;
+                }
+
+                store_value(*opt, match, value);
+                if (!validate_choices(*opt, added_since(match, match.values.size() - 1)) ||
+                    !validate_value(*opt, added_since(match, match.values.size() - 1))) {
+                    return;
+                }
+            }
+        }
+
+        void handle_positional(std::string_view value) {
+            // Positional arguments, sorted by index if specified
+            const auto &positionals = m_cmd.positional_slots();
+
+            if (m_positional_index >= positionals.size()) {
+                // Check if last positional takes multiple values
+                if (!positionals.empty()) {
+                    const Arg *last = &m_cmd.m_args[positionals.back()];
+                    if (last->value_count().max > 1 || last->value_count().max == ValueCount::unlimited) {
+                        auto &match = m_matches.at(last->id());
+                        if (last->is_streamed()) {
+                            stream_value(*last, match, value);
+                            return;
+                        }
+                        store_value(*last, match, value);
+                        match.occurrences++;
+                        return;
+                    }
+                }
+
+                // Check if it might be a mistyped subcommand
+                auto subcommand_names = m_cmd.get_subcommand_names(false); // Exclude hidden
+                auto suggestions =
+                    detail::find_closest_matches(std::string(value), subcommand_names, m_cmd.get_suggest_threshold());
+                if (!suggestions.empty()) {
+                    fail(UnknownSubcommandError(std::string(value), suggestions));
+                    return;
+                }
+
+                fail(TooManyArgumentsError(std::string(value)));
+                return;
+            }
+
+            const Arg *pos = &m_cmd.m_args[positionals[m_positional_index]];
+            auto &match = m_matches.at(pos->id());
+            if (pos->is_streamed()) {
+                if (stream_value(*pos, match, value) && match.occurrences >= pos->value_count().max) {
+                    ++m_positional_index;
+                }
+                return;
+            }
+            store_value(*pos, match, value);
+            match.occurrences++;
+
+            if (!validate_choices(*pos, added_since(match, match.values.size() - 1)) ||
+                !validate_value(*pos, added_since(match, match.values.size() - 1))) {
+                return;
+            }
+
+            // Move to next positional if this one is satisfied
+            if (match.values.size() >= pos->value_count().max) {
+                ++m_positional_index;
+            }
+        }
+
+        /// Transform and validate a value of a stream_to() argument and pass it to the sink; only the count is kept
+        bool stream_value(const Arg &arg, ArgMatch &match, std::string_view token) {
+            m_scratch.assign(token);
+            if (!arg.get_transformers().empty()) {
+                m_scratch = arg.apply_transformers(std::move(m_scratch));
+            }
+            std::span<const std::string> value(&m_scratch, 1);
+            // Nothing is stored for a later batch, so filesystem checks run now
+            if (!validate_choices(arg, value) || !validate_value(arg, value, false)) {
+                return false;
+            }
+            match.occurrences++;
+            match.source = ValueSource::CommandLine;
+            arg.stream_value(m_scratch);
+            return true;
+        }
+
+        void parse_subcommand(Command *sub) {
+            // A subcommand is built and set up when first reached; a shared parse relies on finalize() having done it
+            if (!m_shared) {
+                sub->build();
+                m_cmd.inherit_into(*sub);
+                sub->prepare();
+            }
+
+            // Parse subcommand over the remaining tokens (no copy)
+            auto sub_matches = std::make_unique<Matches>(sub->m_layout);
+            Parser sub_parser(*sub, *sub_matches, m_shared);
+            auto result = sub_parser.parse(*m_tokens);
+
+            // Store subcommand info
+            m_matches.m_subcommand = sub->name();
+            m_matches.m_subcommand_matches = std::move(sub_matches);
+
+            // Pass up help/version output (exit_code 0 with message) and errors from the subcommand
+            if (result.exit_code() == 0 && !result.message().empty()) {
+                output(result.message());
+            } else if (!result.success()) {
+                m_stop = std::move(result);
+            }
+        }
+
+        void handle_external_subcommand(std::string_view subcommand) {
+            // Store the external subcommand name and remaining args
+            m_matches.m_subcommand = std::string(subcommand);
+            m_matches.m_external_subcommand = true;
+
+            // Capture all remaining args as external args, passed on as written (no response file expansion)
+            m_tokens->literal();
+            for (std::string_view token; next_token(token);) {
+                m_matches.m_external_args.emplace_back(token);
+            }
+        }
+
+        void handle_trailing_args(std::string_view first) {
+            // Capture all remaining args as trailing args, as written
+            auto &match = m_matches.at(m_cmd.m_trailing_id);
+            m_tokens->literal();
+            match.values.emplace_back(first);
+            match.occurrences++;
+            for (std::string_view token; next_token(token);) {
+                match.values.emplace_back(token);
+                match.occurrences++;
+            }
+            match.source = ValueSource::CommandLine;
+        }
+
+        void validate_required() {
+            for (const auto &arg : m_cmd.m_args) {
+                bool arg_present = m_matches.present(arg.id());
+                bool arg_required = arg.is_required();
+
+                // Check required_unless: arg is required unless one of the listed args is present
+                if (!arg_present && !arg.get_required_unless().empty()) {
+                    bool any_unless_present = false;
+                    for (const auto &unless_arg : arg.get_required_unless()) {
+                        if (m_matches.contains(unless_arg)) {
+                            any_unless_present = true;
+                            break;
+                        }
+                    }
+                    if (!any_unless_present && !arg.default_val()) {
+                        add_error(MissingRequiredError(arg.name()));
+                        continue;
+                    }
+                }
+
+                // Check required_if_eq: arg is required if another arg equals specific value
+                if (!arg_present) {
+                    for (const auto &[other_arg, other_value] : arg.get_required_if_eq()) {
+                        auto match_value = m_matches.get_one(other_arg);
+                        if (match_value && *match_value == other_value) {
+                            if (!arg.default_val()) {
+                                add_error(MissingRequiredError(arg.name()));
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                // Check basic required
+                if (arg_required && !arg_present) {
+                    if (!arg.default_val()) {
+                        add_error(MissingRequiredError(arg.name()));
+                    }
+                }
+            }
+
+            // Check if subcommand is required
+            if (m_cmd.m_subcommand_required && !m_matches.m_subcommand && !m_cmd.m_subcommands.empty()) {
+                std::vector<std::string> available;
+                for (const auto &sub : m_cmd.m_subcommands) {
+                    if (!sub->is_hidden()) {
+                        available.push_back(sub->name());
+                    }
+                }
+                add_error(MissingSubcommandError(available));
+            }
+        }
+
+        void validate_constraints() {
+            for (const auto &arg : m_cmd.m_args) {
+                if (!m_matches.present(arg.id()))
+                    continue;
+
+                // Check conflicts
+                for (const auto &conflict : arg.get_conflicts()) {
+                    if (m_matches.contains(conflict)) {
+                        add_error(ConflictError(arg.name(), conflict));
+                    }
+                }
+
+                // Check requires
+                for (const auto &req : arg.get_requires()) {
+                    if (!m_matches.contains(req)) {
+                        add_error(DependencyError(arg.name(), req));
+                    }
+                }
+
+                // Check requires_if: this arg requires another arg if it has specific value
+                for (const auto &[req_arg, req_value] : arg.get_requires_if()) {
+                    auto this_value = m_matches.get_one(arg.name());
+                    if (this_value && *this_value == req_value) {
+                        if (!m_matches.contains(req_arg)) {
+                            add_error(DependencyError(arg.name(), req_arg));
+                        }
+                    }
+                }
+            }
+        }
+
+        void validate_groups() {
+            for (const auto &group : m_cmd.m_groups) {
+                std::vector<std::string> present;
+                std::vector<std::string> missing;
+
+                for (const auto &arg_name : group.get_args()) {
+                    if (m_matches.contains(arg_name)) {
+                        present.push_back(arg_name);
+                    } else {
+                        missing.push_back(arg_name);
+                    }
+                }
+
+                switch (group.get_type()) {
+                case GroupType::MutuallyExclusive:
+                    if (present.size() > 1) {
+                        add_error(MutexGroupError(group.get_name(), present));
+                    }
+                    break;
+
+                case GroupType::RequiredTogether:
+                    if (!present.empty() && !missing.empty()) {
+                        add_error(RequiredTogetherError(group.get_name(), present, missing));
+                    }
+                    break;
+
+                case GroupType::AtLeastOne:
+                    if (group.is_required() && present.empty()) {
+                        add_error(AtLeastOneRequiredError(group.get_name(), group.get_args()));
+                    }
+                    break;
+
+                default:
+                    break;
+                }
+            }
+        }
+
+        void fill_handles() {
+            for (const auto &arg : m_cmd.m_args) {
+                for (const auto &sink : arg.m_sinks) {
+                    if (auto bad = sink(m_matches.at(arg.id()))) {
+                        fail(InvalidValueError(arg.name(), *bad, "cannot be converted to the bound type"));
+                        return;
+                    }
+                }
+            }
+        }
+
+        /// Transform a token, store it in the match (the one copy made of it) and apply it to the bound target
+        void store_value(const Arg &arg, ArgMatch &match, std::string_view token) const {
+            match.values.push_back(arg.apply_transformers(std::string(token)));
+            if (arg.get_action() == ValueAction::Append) {
+                add_value(arg, match.values.back());
+            } else {
+                set_value(arg, match.values.back());
+            }
+        }
+
+        // Writes to bound targets, which a shared parse skips
+        void set_value(const Arg &arg, const std::string &value) const {
+            if (!m_shared) {
+                arg.apply_value(value);
+            }
+        }
+        void add_value(const Arg &arg, const std::string &value) const {
+            if (!m_shared) {
+                arg.append_value(value);
+            }
+        }
+        void set_flag(const Arg &arg, bool value) const {
+            if (!m_shared) {
+                arg.apply_flag(value);
+            }
+        }
+        void set_count(const Arg &arg, int count) const {
+            if (!m_shared) {
+                arg.apply_count(count);
+            }
+        }
+
+        /// Values added to a match from index `first` on (earlier ones were already validated)
+        static std::span<const std::string> added_since(const ArgMatch &match, std::size_t first) {
+            return std::span<const std::string>(match.values).subspan(first);
+        }
+
+        /// Check values against the argument's choices; on failure ends the parse and returns false
+        bool validate_choices(const Arg &arg, std::span<const std::string> values) {
+            const auto &choices = arg.get_choices();
+            if (choices.empty())
+                return true;
+
+            for (const auto &val : values) {
+                if (std::find(choices.begin(), choices.end(), val) == choices.end()) {
+                    std::string valid;
+                    for (std::size_t i = 0; i < choices.size(); ++i) {
+                        if (i > 0)
+                            valid += ", ";
+                        valid += choices[i];
+                    }
+                    fail(InvalidValueError(arg.name(), val, "valid values are: " + valid));
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// Run the argument's validators over values; on failure ends the parse and returns false
+        ///
+        /// With validation_threads() above 1, built-in filesystem validators are queued for run_path_checks()
+        /// instead of run here.
+        bool validate_value(const Arg &arg, std::span<const std::string> values, bool defer_path_checks = true) {
+            defer_path_checks = defer_path_checks && m_cmd.get_validation_threads() > 1;
+            for (const auto &validator : arg.get_validators()) {
+                const auto *path_check = defer_path_checks ? validator.target<detail::PathValidator>() : nullptr;
+                if (path_check) {
+                    for (const auto &val : values) {
+                        m_path_checks.push_back({&arg, *path_check, val});
+                    }
+                    continue;
+                }
+                for (const auto &val : values) {
+                    auto error = validator(val);
+                    if (error) {
+                        fail(ValidationError(arg.name(), *error));
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /// Run the queued filesystem checks, on the command's executor when there are many, and fail on the first error
+        void run_path_checks() {
+            if (m_path_checks.empty())
+                return;
+
+            std::size_t threads = path_check_threads();
+            if (threads == 1) {
+                for (const auto &path_check : m_path_checks) {
+                    if (auto error = path_check.check(path_check.value)) {
+                        m_stop = ParseResult(ValidationError(path_check.arg->name(), *error));
+                        break;
+                    }
+                }
+                m_path_checks.clear();
+                return;
+            }
+
+            std::vector<std::optional<std::string>> errors(m_path_checks.size());
+            std::function<void(std::size_t)> check = [this, &errors](std::size_t i) {
+                errors[i] = m_path_checks[i].check(m_path_checks[i].value);
+            };
+            if (const auto &executor = m_cmd.get_executor()) {
+                executor(m_path_checks.size(), check);
+            } else {
+                detail::WorkerPool::shared().parallel_for(m_path_checks.size(), threads, check);
+            }
+
+            for (std::size_t i = 0; i < errors.size(); ++i) {
+                if (errors[i]) {
+                    m_stop = ParseResult(ValidationError(m_path_checks[i].arg->name(), *errors[i]));
+                    break;
+                }
+            }
+            m_path_checks.clear();
+        }
+
+        /// Threads for run_path_checks(): the command's setting, with at least 16 paths per thread
+        ///
+        /// Smaller batches are checked on the parsing thread, where handing them out would cost more than it saves.
+        std::size_t path_check_threads() const {
+            std::size_t threads = std::min(m_cmd.get_validation_threads(), m_path_checks.size() / 16);
+            return std::max<std::size_t>(threads, 1);
+        }
+
+        void apply_defaults() {
+            for (const auto &arg : m_cmd.m_args) {
+                if (m_matches.present(arg.id()))
+                    continue;
+
+                // Check default_value_if: conditional default based on another arg's value
+                bool conditional_default_applied = false;
+                for (const auto &[other_arg, other_value, default_val] : arg.get_default_value_if()) {
+                    auto match_value = m_matches.get_one(other_arg);
+                    if (match_value && *match_value == other_value) {
+                        auto &match = m_matches.at(arg.id());
+                        match.values.push_back(default_val);
+                        match.occurrences = 1;
+                        match.source = ValueSource::Default;
+                        set_value(arg, default_val);
+                        conditional_default_applied = true;
+                        break;
+                    }
+                }
+
+                // Apply regular default if no conditional default was applied
+                if (!conditional_default_applied && arg.default_val()) {
+                    if (!m_shared) {
+                        arg.apply_default();
+                    }
+                    auto &match = m_matches.at(arg.id());
+                    match.values.push_back(*arg.default_val());
+                    match.occurrences = 1;
+                }
+            }
+        }
+    };
+
+    // Implementation of Command::parse methods
+    ARGU_INLINE ParseResult Command::parse(int argc, char *argv[]) {
+        prepare();
+        m_matches = m_layout;
+        Parser parser(*this, m_matches);
+        return parser.parse(argc, argv);
+    }
+
+    ARGU_INLINE ParseResult Command::parse(const std::vector<std::string> &args) {
+        prepare();
+        m_matches = m_layout;
+        Parser parser(*this, m_matches);
+        return parser.parse(args);
+    }
+
+    ARGU_INLINE ParseResult Command::parse(int argc, char *argv[], Matches &matches) const {
+        if (!m_finalized) {
+            return ParseResult(Error("command '" + m_name + "' must be finalized before a const parse"));
+        }
+        matches = m_layout;
+        Parser parser(*this, matches, true);
+        return parser.parse(argc, argv);
+    }
+
+    ARGU_INLINE ParseResult Command::parse(const std::vector<std::string> &args, Matches &matches) const {
+        if (!m_finalized) {
+            return ParseResult(Error("command '" + m_name + "' must be finalized before a const parse"));
+        }
+        matches = m_layout;
+        Parser parser(*this, matches, true);
+        return parser.parse(args);
+    }
+
+    // Implementation of Command::help
+    ARGU_INLINE std::string Command::help() const {
+        HelpFormatter formatter(*this);
+        return formatter.format();
+    }
+
+} // namespace argu
@@ -0,0 +1,614 @@
+#pragma once
+
+/// @file argu/core/schema.hpp
+/// @brief Compile-time argument schemas parsed straight into a struct
+///
+/// A Schema is a constexpr description of a command line: names, short flags,
+/// arity, choices and the struct member each option writes. Its lookup tables
+/// are built at compile time, and parsing converts each token in place into
+/// the target struct without allocating. Errors are reported with argu's error
+/// types, and help goes through a runtime Command built from the schema.
+///
+///     struct Options { bool verbose = false; int jobs = 1; std::string_view mode = "fast"; std::string_view input; };
+///
+///     constexpr auto cli = argu::schema<Options>("tool",
+///         argu::opt("verbose", &Options::verbose).short_name('v').help("Verbose output"),
+///         argu::opt("jobs", &Options::jobs).short_name('j').value_name("N"),
+///         argu::opt("mode", &Options::mode).choices({"fast", "slow"}),
+///         argu::positional("input", &Options::input).required());
+///
+///     Options options;
+///     if (auto result = cli.parse(options, argc, argv); result.should_exit()) return result.exit();
+
+#include <argu/core/command.hpp>
+#include <argu/core/config.hpp>
+#include <argu/core/error.hpp>
+#include <argu/core/levenshtein.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace argu {
+
+    /// How a schema option takes its values
+    enum class OptKind : uint8_t {
+        Flag,       ///< Sets a bool member
+        Count,      ///< Increments an integer member per occurrence
+        Value,      ///< Option followed by one value (or N for a std::array member)
+        Positional, ///< Takes the next free positional value(s)
+    };
+
+    namespace detail {
+        template <typename T> struct IsStdArray : std::false_type {};
+        template <typename T, std::size_t N> struct IsStdArray<std::array<T, N>> : std::true_type {};
+
+        template <typename T> struct IsOptional : std::false_type {};
+        template <typename T> struct IsOptional<std::optional<T>> : std::true_type {};
+
+        /// Values one occurrence of a member of type T takes
+        template <typename T> constexpr std::size_t schema_arity() {
+            if constexpr (IsStdArray<T>::value) {
+                return std::tuple_size_v<T>;
+            } else {
+                return 1;
+            }
+        }
+
+        /// Convert one token into `out` without allocating (except into std::string); false if it does not convert
+        ///
+        /// Integers accept the same 0x / 0b / 0o prefixes as Converter.
+        template <typename T> bool parse_token(std::string_view s, T &out) {
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                out = s;
+                return true;
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                out.assign(s);
+                return true;
+            } else if constexpr (IsOptional<T>::value) {
+                typename T::value_type value{};
+                if (!parse_token(s, value)) {
+                    return false;
+                }
+                out = std::move(value);
+                return true;
+            } else if constexpr (std::is_same_v<T, bool>) {
+                auto is = [s](std::string_view word) {
+                    return std::equal(s.begin(), s.end(), word.begin(), word.end(), [](char a, char b) {
+                        return static_cast<char>(std::tolower(static_cast<unsigned char>(a))) == b;
+                    });
+                };
+                if (is("true") || is("1") || is("yes") || is("on") || is("y")) {
+                    out = true;
+                    return true;
+                }
+                if (is("false") || is("0") || is("no") || is("off") || is("n")) {
+                    out = false;
+                    return true;
+                }
+                return false;
+            } else if constexpr (std::is_integral_v<T>) {
+                int base = 10;
+                if (s.size() > 2 && s[0] == '0') {
+                    switch (s[1]) {
+                    case 'x':
+                    case 'X':
+                        base = 16;
+                        break;
+                    case 'b':
+                    case 'B':
+                        base = 2;
+                        break;
+                    case 'o':
+                    case 'O':
+                        base = 8;
+                        break;
+                    default:
+                        break;
+                    }
+                    if (base != 10) {
+                        s.remove_prefix(2);
+                    }
+                }
+                auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out, base);
+                return ec == std::errc{} && ptr == s.data() + s.size() && !s.empty();
+            } else if constexpr (std::is_floating_point_v<T>) {
+                auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+                return ec == std::errc{} && ptr == s.data() + s.size() && !s.empty();
+            } else {
+                static_assert(sizeof(T) == 0, "argu::schema: unsupported member type");
+            }
+        }
+
+        /// Not constexpr: reaching it while building a constexpr schema turns the mistake into a compile error
+        inline void schema_error(const char *what) { ARGU_THROW(std::logic_error(what)); }
+
+        /// Per-option facts the parser needs, the same shape for every member type
+        struct OptInfo {
+            std::string_view name;
+            std::string_view long_name;
+            char short_name = 0;
+            OptKind kind = OptKind::Value;
+            uint16_t arity = 1;
+            bool required = false;
+        };
+    } // namespace detail
+
+    /// One option of a Schema: its names and the member of S it writes
+    template <typename S, typename T> class Opt {
+      public:
+        static constexpr std::size_t max_choices = 16;
+
+        constexpr Opt(std::string_view name, T S::*member, OptKind kind)
+            : m_name(name), m_long(kind == OptKind::Positional ? std::string_view{} : name), m_member(member),
+              m_kind(kind) {}
+
+        constexpr Opt &short_name(char c) {
+            m_short = c;
+            return *this;
+        }
+
+        constexpr Opt &long_name(std::string_view name) {
+            m_long = name;
+            return *this;
+        }
+
+        constexpr Opt &help(std::string_view text) {
+            m_help = text;
+            return *this;
+        }
+
+        constexpr Opt &value_name(std::string_view name) {
+            m_value_name = name;
+            return *this;
+        }
+
+        constexpr Opt &required(bool req = true) {
+            m_required = req;
+            return *this;
+        }
+
+        /// Count occurrences into an integer member (-vvv)
+        constexpr Opt &count() {
+            static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "count() needs an integer member");
+            m_kind = OptKind::Count;
+            return *this;
+        }
+
+        /// Accept only these values (compared before conversion)
+        constexpr Opt &choices(std::initializer_list<std::string_view> values) {
+            if (values.size() > max_choices) {
+                detail::schema_error("argu::schema: too many choices");
+            }
+            m_choice_count = 0;
+            for (auto value : values) {
+                m_choices[m_choice_count++] = value;
+            }
+            return *this;
+        }
+
+        constexpr detail::OptInfo info() const {
+            uint16_t arity = m_kind == OptKind::Flag || m_kind == OptKind::Count
+                                 ? 0
+                                 : static_cast<uint16_t>(detail::schema_arity<T>());
+            return {m_name, m_long, m_short, m_kind, arity, m_required};
+        }
+
+        /// Write one occurrence (flags, counts) or the value for `slot` (0 .. arity - 1) into `out`
+        ///
+        /// Returns nullptr on success, or the reason the token was rejected.
+        const char *store(S &out, std::string_view token, std::size_t slot) const {
+            T &target = out.*m_member;
+            if constexpr (std::is_same_v<T, bool>) {
+                if (m_kind == OptKind::Flag) {
+                    target = true;
+                    return nullptr;
+                }
+            } else if constexpr (std::is_integral_v<T>) {
+                if (m_kind == OptKind::Count) {
+                    ++target;
+                    return nullptr;
+                }
+            }
+            if (m_choice_count > 0 &&
+                std::find(m_choices.begin(), m_choices.begin() + m_choice_count, token) ==
+                    m_choices.begin() + m_choice_count) {
+                return "is not one of the accepted values";
+            }
+            bool ok;
+            if constexpr (detail::IsStdArray<T>::value) {
+                ok = detail::parse_token(token, target[slot]);
+            } else {
+                (void)slot;
+                ok = detail::parse_token(token, target);
+            }
+            return ok ? nullptr : "cannot be converted to the member type";
+        }
+
+        /// The runtime argument this option corresponds to (for help output)
+        Arg to_arg() const {
+            Arg arg{std::string(m_name)};
+            if (!m_help.empty()) {
+                arg.help(std::string(m_help));
+            }
+            if (m_short) {
+                arg.short_name(m_short);
+            }
+            if (m_kind != OptKind::Positional && !m_long.empty()) {
+                arg.long_name(std::string(m_long));
+            }
+            switch (m_kind) {
+            case OptKind::Flag:
+                arg.flag();
+                break;
+            case OptKind::Count:
+                arg.count();
+                break;
+            case OptKind::Positional:
+                arg.positional();
+                [[fallthrough]];
+            case OptKind::Value:
+                arg.num_values(ValueCount::exactly(detail::schema_arity<T>()));
+                if (!m_value_name.empty()) {
+                    arg.value_name(std::string(m_value_name));
+                }
+                break;
+            }
+            if (m_required) {
+                arg.required();
+            }
+            if (m_choice_count > 0) {
+                arg.choices(std::vector<std::string>(m_choices.begin(), m_choices.begin() + m_choice_count));
+            }
+            return arg;
+        }
+
+      private:
+        std::string_view m_name;
+        std::string_view m_long;
+        std::string_view m_help;
+        std::string_view m_value_name;
+        T S::*m_member;
+        std::array<std::string_view, max_choices> m_choices{};
+        std::size_t m_choice_count = 0;
+        OptKind m_kind;
+        char m_short = 0;
+        bool m_required = false;
+    };
+
+    /// Option writing `member`: a flag for bool members, otherwise an option taking a value
+    template <typename S, typename T> constexpr Opt<S, T> opt(std::string_view name, T S::*member) {
+        return Opt<S, T>(name, member, std::is_same_v<T, bool> ? OptKind::Flag : OptKind::Value);
+    }
+
+    /// Positional argument writing `member`, filled in declaration order
+    template <typename S, typename T> constexpr Opt<S, T> positional(std::string_view name, T S::*member) {
+        return Opt<S, T>(name, member, OptKind::Positional);
+    }
+
+    /// A command line fixed at compile time, parsed without allocating into an S
+    ///
+    /// Long names are kept sorted for binary search, short flags in a 128-entry
+    /// table, and each option's store function in an array indexed like the
+    /// options, so a token resolves without hashing or string building. Name
+    /// clashes are reported when the constexpr schema is compiled. -h/--help
+    /// (and -V/--version once a version is set) are answered unless the schema
+    /// defines them itself.
+    template <typename S, typename... Ts> class Schema {
+      public:
+        static constexpr std::size_t size = sizeof...(Ts);
+        static_assert(size < UINT16_MAX, "argu::schema: too many options");
+
+        constexpr explicit Schema(std::string_view name, Opt<S, Ts>... opts)
+            : m_name(name), m_opts(opts...), m_info{opts.info()...} {
+            m_shorts.fill(none);
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto &info = m_info[i];
+                if (info.kind == OptKind::Positional) {
+                    m_positionals[m_positional_count++] = static_cast<uint16_t>(i);
+                    continue;
+                }
+                if (info.short_name) {
+                    auto c = static_cast<unsigned char>(info.short_name);
+                    if (c >= m_shorts.size() || m_shorts[c] != none) {
+                        detail::schema_error("argu::schema: short name used twice or not ASCII");
+                    }
+                    m_shorts[c] = static_cast<uint16_t>(i);
+                }
+                if (!info.long_name.empty()) {
+                    m_longs[m_long_count++] = {info.long_name, static_cast<uint16_t>(i)};
+                }
+            }
+            std::sort(m_longs.begin(), m_longs.begin() + m_long_count,
+                      [](const auto &a, const auto &b) { return a.first < b.first; });
+            for (std::size_t i = 1; i < m_long_count; ++i) {
+                if (m_longs[i - 1].first == m_longs[i].first) {
+                    detail::schema_error("argu::schema: long name used twice");
+                }
+            }
+        }
+
+        constexpr Schema &about(std::string_view text) {
+            m_about = text;
+            return *this;
+        }
+
+        constexpr Schema &version(std::string_view ver) {
+            m_version = ver;
+            return *this;
+        }
+
+        constexpr std::string_view name() const { return m_name; }
+
+        /// Parse argv (skipping argv[0]) into `out`; members of options not given keep their values
+        ParseResult parse(S &out, int argc, char *argv[]) const {
+            State state;
+            for (int i = 1; i < argc; ++i) {
+                auto step = next(out, state, argv[i], [&](std::size_t ahead) -> std::optional<std::string_view> {
+                    return i + static_cast<int>(ahead) < argc ? std::optional<std::string_view>(argv[i + ahead])
+                                                               : std::nullopt;
+                });
+                if (!step.done) {
+                    return std::move(step.result);
+                }
+                i += static_cast<int>(step.consumed);
+            }
+            return finish(state);
+        }
+
+        /// Parse tokens (no program name) into `out`
+        ParseResult parse(S &out, std::span<const std::string_view> args) const {
+            State state;
+            for (std::size_t i = 0; i < args.size(); ++i) {
+                auto step = next(out, state, args[i], [&](std::size_t ahead) -> std::optional<std::string_view> {
+                    return i + ahead < args.size() ? std::optional<std::string_view>(args[i + ahead]) : std::nullopt;
+                });
+                if (!step.done) {
+                    return std::move(step.result);
+                }
+                i += step.consumed;
+            }
+            return finish(state);
+        }
+
+        /// Runtime view of the schema, for help text and completions
+        Command command() const {
+            Command cmd{std::string(m_name)};
+            if (!m_about.empty()) {
+                cmd.about(std::string(m_about));
+            }
+            if (!m_version.empty()) {
+                cmd.version(std::string(m_version));
+            }
+            std::apply([&cmd](const auto &...opts) { (cmd.arg(opts.to_arg()), ...); }, m_opts);
+            return cmd;
+        }
+
+        std::string help() const { return command().help(); }
+
+      private:
+        static constexpr uint16_t none = UINT16_MAX;
+
+        using Store = const char *(*)(const Schema &, S &, std::string_view, std::size_t);
+
+        template <std::size_t I> static const char *store_at(const Schema &s, S &out, std::string_view token, std::size_t slot) {
+            return std::get<I>(s.m_opts).store(out, token, slot);
+        }
+
+        template <std::size_t... I> static constexpr std::array<Store, size> make_stores(std::index_sequence<I...>) {
+            return {&store_at<I>...};
+        }
+
+        static constexpr std::array<Store, size> stores = make_stores(std::index_sequence_for<Ts...>{});
+
+        /// Parse progress; fixed size, so it lives on the stack
+        struct State {
+            std::array<uint32_t, size> seen{}; // Occurrences per option
+            std::size_t positional = 0;         // Next positional to fill
+            std::size_t positional_slot = 0;    // Next value of that positional (array members)
+            bool positionals_only = false;      // After --
+        };
+
+        /// What one token did: `consumed` following tokens were used as values, or parsing stops with `result`
+        struct Step {
+            bool done = true;
+            std::size_t consumed = 0;
+            ParseResult result;
+        };
+
+        static Step stop(ParseResult result) { return Step{false, 0, std::move(result)}; }
+        static Step stop(const Error &error) { return stop(ParseResult(error)); }
+
+        uint16_t find_long(std::string_view name) const {
+            auto end = m_longs.begin() + m_long_count;
+            auto it = std::lower_bound(m_longs.begin(), end, name,
+                                       [](const auto &entry, std::string_view n) { return entry.first < n; });
+            return it != end && it->first == name ? it->second : none;
+        }
+
+        uint16_t find_short(char c) const {
+            auto u = static_cast<unsigned char>(c);
+            return u < m_shorts.size() ? m_shorts[u] : none;
+        }
+
+        const char *store(S &out, uint16_t index, std::string_view token, std::size_t slot) const {
+            return stores[index](*this, out, token, slot);
+        }
+
+        Step invalid(uint16_t index, std::string_view token, const char *why) const {
+            return stop(InvalidValueError(std::string(m_info[index].name), std::string(token), why));
+        }
+
+        /// Help or version output; only built when asked for
+        ParseResult help_result() const { return ParseResult(true, 0, help()); }
+        ParseResult version_result() const { return ParseResult(true, 0, command().version_string()); }
+
+        template <typename Peek> Step next(S &out, State &state, std::string_view token, Peek peek) const {
+            if (state.positionals_only || token == "-" || !token.starts_with('-')) {
+                return take_positional(out, state, token);
+            }
+            if (token == "--") {
+                state.positionals_only = true;
+                return {};
+            }
+            if (token.starts_with("--")) {
+                return take_long(out, state, token.substr(2), peek);
+            }
+            return take_shorts(out, state, token, peek);
+        }
+
+        template <typename Peek> Step take_long(S &out, State &state, std::string_view name, Peek peek) const {
+            std::optional<std::string_view> inline_value;
+            if (auto eq = name.find('='); eq != std::string_view::npos) {
+                inline_value = name.substr(eq + 1);
+                name = name.substr(0, eq);
+            }
+
+            uint16_t index = find_long(name);
+            if (index == none) {
+                if (name == "help") {
+                    return stop(help_result());
+                }
+                if (name == "version" && !m_version.empty()) {
+                    return stop(version_result());
+                }
+                std::vector<std::string> longs;
+                for (std::size_t i = 0; i < m_long_count; ++i) {
+                    longs.emplace_back(m_longs[i].first);
+                }
+                auto suggestions = detail::find_closest_matches(std::string(name), longs);
+                for (auto &s : suggestions) {
+                    s.insert(0, "--");
+                }
+                return stop(UnknownArgumentError("--" + std::string(name), suggestions));
+            }
+
+            const auto &info = m_info[index];
+            ++state.seen[index];
+            if (info.arity == 0) {
+                if (inline_value) {
+                    return invalid(index, *inline_value, "takes no value");
+                }
+                store(out, index, {}, 0);
+                return {};
+            }
+
+            Step step;
+            for (std::size_t slot = 0; slot < info.arity; ++slot) {
+                std::optional<std::string_view> value;
+                if (slot == 0 && inline_value) {
+                    value = inline_value;
+                } else {
+                    value = peek(++step.consumed);
+                }
+                if (!value) {
+                    return stop(MissingValueError(std::string(info.name)));
+                }
+                if (const char *why = store(out, index, *value, slot)) {
+                    return invalid(index, *value, why);
+                }
+            }
+            return step;
+        }
+
+        template <typename Peek> Step take_shorts(S &out, State &state, std::string_view token, Peek peek) const {
+            Step step;
+            for (std::size_t j = 1; j < token.size(); ++j) {
+                char c = token[j];
+                uint16_t index = find_short(c);
+                if (index == none) {
+                    if (c == 'h') {
+                        return stop(help_result());
+                    }
+                    if (c == 'V' && !m_version.empty()) {
+                        return stop(version_result());
+                    }
+                    return stop(UnknownArgumentError(std::string("-") + c));
+                }
+
+                const auto &info = m_info[index];
+                ++state.seen[index];
+                if (info.arity == 0) {
+                    store(out, index, {}, 0);
+                    continue;
+                }
+
+                // The rest of the token is the first value (-j4), otherwise the values follow
+                for (std::size_t slot = 0; slot < info.arity; ++slot) {
+                    std::optional<std::string_view> value;
+                    if (slot == 0 && j + 1 < token.size()) {
+                        value = token.substr(j + 1);
+                    } else {
+                        value = peek(++step.consumed);
+                    }
+                    if (!value) {
+                        return stop(MissingValueError(std::string(info.name)));
+                    }
+                    if (const char *why = store(out, index, *value, slot)) {
+                        return invalid(index, *value, why);
+                    }
+                }
+                break;
+            }
+            return step;
+        }
+
+        Step take_positional(S &out, State &state, std::string_view token) const {
+            if (state.positional >= m_positional_count) {
+                return stop(TooManyArgumentsError(std::string(token)));
+            }
+            uint16_t index = m_positionals[state.positional];
+            if (const char *why = store(out, index, token, state.positional_slot)) {
+                return invalid(index, token, why);
+            }
+            ++state.seen[index];
+            if (++state.positional_slot == m_info[index].arity) {
+                ++state.positional;
+                state.positional_slot = 0;
+            }
+            return {};
+        }
+
+        ParseResult finish(const State &state) const {
+            if (state.positional_slot != 0) {
+                return ParseResult(MissingValueError(std::string(m_info[m_positionals[state.positional]].name)));
+            }
+            for (std::size_t i = 0; i < size; ++i) {
+                if (m_info[i].required && state.seen[i] == 0) {
+                    return ParseResult(MissingRequiredError(std::string(m_info[i].name)));
+                }
+            }
+            return ParseResult();
+        }
+
+        std::string_view m_name;
+        std::string_view m_about;
+        std::string_view m_version;
+        std::tuple<Opt<S, Ts>...> m_opts;
+        std::array<detail::OptInfo, size> m_info;
+        std::array<std::pair<std::string_view, uint16_t>, size> m_longs{}; // Sorted by name
+        std::size_t m_long_count = 0;
+        std::array<uint16_t, 128> m_shorts{};      // ASCII short flag -> option
+        std::array<uint16_t, size> m_positionals{}; // Positional options in declaration order
+        std::size_t m_positional_count = 0;
+    };
+
+    /// Build a Schema for struct S; declare the result constexpr to build its tables at compile time
+    template <typename S, typename... Ts> constexpr Schema<S, Ts...> schema(std::string_view name, Opt<S, Ts>... opts) {
+        return Schema<S, Ts...>(name, opts...);
+    }
+
+} // namespace argu
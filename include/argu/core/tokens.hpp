@@ -0,0 +1,382 @@
+#pragma once
+
+/// @file argu/core/tokens.hpp
+/// @brief Command-line token stream with response file expansion
+///
+/// The parser reads its tokens from a TokenStream: the argv tokens, with `@path`
+/// and `--args-from PATH` replaced by the arguments listed in that file. Files
+/// are tokenized lazily, one argument per read, so an argument list far larger
+/// than ARG_MAX never has to be held in memory at once.
+
+#include <argu/core/error.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ARGU_HAS_MMAP 1
+#endif
+
+namespace argu {
+    namespace detail {
+
+        /// The arguments of one response file, or of standard input for "-"
+        ///
+        /// Arguments are separated by NUL bytes or by newlines, whichever of the two
+        /// comes first in the file (so `find -print0` output and plain lists both work).
+        /// With newlines, a trailing `\r` is dropped and empty lines are skipped; with
+        /// NUL bytes, every record is an argument, empty ones included.
+        ///
+        /// Regular files are memory-mapped and read as views into the mapping. Pipes,
+        /// terminals and (on Windows) all files are read in chunks; their arguments are
+        /// copied into a small ring of buffers, see TokenStream for the lifetime this gives.
+        class ResponseFile {
+          public:
+            /// Open `path` ("-" for standard input); returns null with `error` set on failure
+            static std::unique_ptr<ResponseFile> open(const std::string &path, std::string &error) {
+                std::unique_ptr<ResponseFile> file(new ResponseFile());
+                bool is_stdin = path == "-";
+#ifdef ARGU_HAS_MMAP
+                int fd = is_stdin ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0) {
+                    error = std::strerror(errno);
+                    return nullptr;
+                }
+                struct stat st {};
+                if (::fstat(fd, &st) != 0) {
+                    error = std::strerror(errno);
+                } else if (S_ISDIR(st.st_mode)) {
+                    error = "is a directory";
+                } else if (!S_ISREG(st.st_mode) || !file->map(fd, static_cast<std::size_t>(st.st_size))) {
+                    // A pipe or terminal, or a file that cannot be mapped: read it in chunks
+                    if (std::FILE *stream = is_stdin ? stdin : ::fdopen(fd, "rb")) {
+                        file->m_file = stream;
+                        file->m_owns_file = !is_stdin;
+                        return file;
+                    }
+                    error = std::strerror(errno);
+                }
+                // A mapping does not need the descriptor
+                if (!is_stdin) {
+                    ::close(fd);
+                }
+                if (!error.empty()) {
+                    return nullptr;
+                }
+                return file;
+#else
+                std::FILE *stream = is_stdin ? stdin : std::fopen(path.c_str(), "rb");
+                if (!stream) {
+                    error = std::strerror(errno);
+                    return nullptr;
+                }
+                file->m_file = stream;
+                file->m_owns_file = !is_stdin;
+                return file;
+#endif
+            }
+
+            ResponseFile(const ResponseFile &) = delete;
+            ResponseFile &operator=(const ResponseFile &) = delete;
+
+            ~ResponseFile() {
+#ifdef ARGU_HAS_MMAP
+                if (m_map) {
+                    ::munmap(m_map, m_map_size);
+                }
+#endif
+                if (m_owns_file) {
+                    std::fclose(m_file);
+                }
+            }
+
+            /// Read the next argument; false at the end of the file or on a read error (see read_error())
+            bool next(std::string_view &token) {
+                return m_file ? next_buffered(token) : next_mapped(token);
+            }
+
+            /// Set if reading stopped early because of an I/O error
+            const std::string &read_error() const { return m_read_error; }
+
+          private:
+            ResponseFile() = default;
+
+            static constexpr std::size_t chunk_size = 64 * 1024;
+
+            // Memory-mapped file: the bytes not yet tokenized
+            void *m_map = nullptr;
+            std::size_t m_map_size = 0;
+            std::string_view m_rest;
+
+            // Any other input, read in chunks; tokens are copied into m_slots
+            std::FILE *m_file = nullptr;
+            bool m_owns_file = false;
+            std::vector<char> m_buffer;
+            std::size_t m_begin = 0;
+            std::size_t m_end = 0;
+            bool m_eof = false;
+            std::array<std::string, 4> m_slots;
+            std::size_t m_slot = 0;
+
+            char m_delim = '\n';
+            bool m_delim_known = false;
+            std::string m_read_error;
+
+#ifdef ARGU_HAS_MMAP
+            /// Map the rest of a regular file (from the current offset, which matters for redirected stdin)
+            bool map(int fd, std::size_t size) {
+                off_t offset = ::lseek(fd, 0, SEEK_CUR);
+                std::size_t start = offset > 0 ? static_cast<std::size_t>(offset) : 0;
+                if (start >= size) {
+                    return true;
+                }
+                void *map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (map == MAP_FAILED) {
+                    return false;
+                }
+                ::madvise(map, size, MADV_SEQUENTIAL);
+                m_map = map;
+                m_map_size = size;
+                m_rest = std::string_view(static_cast<const char *>(map) + start, size - start);
+                return true;
+            }
+#endif
+
+            /// Pick the delimiter from the first NUL or newline in `bytes`; false if there is neither yet
+            bool detect_delimiter(std::string_view bytes) {
+                auto pos = bytes.find_first_of(std::string_view("\0\n", 2));
+                if (pos == std::string_view::npos) {
+                    return false;
+                }
+                m_delim = bytes[pos];
+                m_delim_known = true;
+                return true;
+            }
+
+            /// Normalize a record; false if it is skipped
+            bool accept(std::string_view &token) const {
+                if (m_delim == '\0') {
+                    return true;
+                }
+                if (token.ends_with('\r')) {
+                    token.remove_suffix(1);
+                }
+                return !token.empty();
+            }
+
+            bool next_mapped(std::string_view &token) {
+                if (!m_delim_known) {
+                    detect_delimiter(m_rest);
+                }
+                while (!m_rest.empty()) {
+                    auto end = m_rest.find(m_delim);
+                    std::string_view record = m_rest.substr(0, end);
+                    m_rest.remove_prefix(end == std::string_view::npos ? m_rest.size() : end + 1);
+                    if (accept(record)) {
+                        token = record;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            bool next_buffered(std::string_view &token) {
+                while (true) {
+                    std::string_view pending(m_buffer.data() + m_begin, m_end - m_begin);
+                    if (!m_delim_known && !detect_delimiter(pending) && !m_eof) {
+                        fill();
+                        continue;
+                    }
+                    auto end = pending.find(m_delim);
+                    if (end == std::string_view::npos && !m_eof) {
+                        fill();
+                        continue;
+                    }
+                    if (pending.empty()) {
+                        return false;
+                    }
+                    std::string_view record = pending.substr(0, end);
+                    m_begin += end == std::string_view::npos ? pending.size() : end + 1;
+                    if (accept(record)) {
+                        auto &slot = m_slots[m_slot++ % m_slots.size()];
+                        slot.assign(record);
+                        token = slot;
+                        return true;
+                    }
+                }
+            }
+
+            /// Read another chunk after the pending bytes, growing the buffer only for an argument longer than it
+            void fill() {
+                std::size_t pending = m_end - m_begin;
+                if (m_begin > 0) {
+                    std::memmove(m_buffer.data(), m_buffer.data() + m_begin, pending);
+                    m_begin = 0;
+                    m_end = pending;
+                }
+                if (m_buffer.size() - m_end < chunk_size / 2) {
+                    m_buffer.resize(std::max(chunk_size, m_buffer.size() * 2));
+                }
+                std::size_t read = std::fread(m_buffer.data() + m_end, 1, m_buffer.size() - m_end, m_file);
+                m_end += read;
+                if (read == 0) {
+                    m_eof = true;
+                    if (std::ferror(m_file)) {
+                        m_read_error = std::strerror(errno);
+                    }
+                }
+            }
+        };
+
+        /// The tokens of a command line, with response files expanded in place
+        ///
+        /// `@path` (if enabled) and `--<args_from> path` / `--<args_from>=path` are replaced
+        /// by the arguments in that file; a response file may name further response files,
+        /// up to `max_depth` levels. After literal() (the parser calls it at `--`), tokens are
+        /// passed through unexpanded.
+        ///
+        /// Tokens are views: argv tokens into the caller's strings, response-file tokens
+        /// into the file mapping or a read buffer. All files stay open until the stream is
+        /// destroyed, and a token stays valid while at most three more tokens are read, so
+        /// callers copy a token before reading further ahead than that.
+        class TokenStream {
+          public:
+            using Args = std::span<const std::string_view>;
+
+            TokenStream(Args argv, bool at_files, const std::string &args_from, std::size_t max_depth)
+                : m_argv(argv), m_at_files(at_files), m_args_from(args_from.empty() ? "" : "--" + args_from),
+                  m_max_depth(max_depth), m_expand(at_files || !args_from.empty()) {}
+
+            /// Read the next token; false at the end of the command line or on error (see error())
+            bool next(std::string_view &token) {
+                if (m_peeked) {
+                    token = *m_peeked;
+                    m_peeked.reset();
+                    return true;
+                }
+                return read(token);
+            }
+
+            /// Look at the next token without consuming it
+            bool peek(std::string_view &token) {
+                if (!m_peeked) {
+                    std::string_view read_token;
+                    if (!read(read_token)) {
+                        return false;
+                    }
+                    m_peeked = read_token;
+                }
+                token = *m_peeked;
+                return true;
+            }
+
+            /// Stop expanding response files; the remaining tokens are passed through as they are
+            void literal() { m_expand = false; }
+
+            /// Set when reading stopped because a response file could not be read
+            const std::optional<Error> &error() const { return m_error; }
+
+            /// The argv tokens not read yet (tokens still to come from open response files are not included)
+            Args argv_rest() const { return m_argv.subspan(m_pos); }
+
+          private:
+            Args m_argv;
+            std::size_t m_pos = 0;
+            bool m_at_files;
+            std::string m_args_from; // "--args-from", or empty if disabled
+            std::size_t m_max_depth;
+            bool m_expand;
+            std::vector<std::unique_ptr<ResponseFile>> m_open; // Innermost last
+            std::vector<std::unique_ptr<ResponseFile>> m_done; // Kept alive: tokens may still point into them
+            std::optional<std::string_view> m_peeked;
+            std::vector<std::string> m_open_paths;             // Parallel to m_open, for error messages
+            std::optional<Error> m_error;
+
+            /// Next token from the innermost open file, else from argv
+            bool read_raw(std::string_view &token) {
+                while (!m_open.empty()) {
+                    if (m_open.back()->next(token)) {
+                        return true;
+                    }
+                    if (!m_open.back()->read_error().empty()) {
+                        m_error = ResponseFileError(m_open_paths.back(), m_open.back()->read_error());
+                        return false;
+                    }
+                    m_done.push_back(std::move(m_open.back()));
+                    m_open.pop_back();
+                    m_open_paths.pop_back();
+                }
+                if (m_pos < m_argv.size()) {
+                    token = m_argv[m_pos++];
+                    return true;
+                }
+                return false;
+            }
+
+            bool read(std::string_view &token) {
+                while (!m_error && read_raw(token)) {
+                    if (!m_expand) {
+                        return true;
+                    }
+                    if (m_at_files && token.size() > 1 && token[0] == '@') {
+                        open(token.substr(1));
+                        continue;
+                    }
+                    if (!m_args_from.empty() && token.starts_with(m_args_from)) {
+                        std::string_view rest = token.substr(m_args_from.size());
+                        if (rest.empty()) {
+                            std::string_view path;
+                            if (!read_raw(path)) {
+                                if (!m_error) {
+                                    m_error = MissingValueError(m_args_from.substr(2));
+                                }
+                                return false;
+                            }
+                            open(path);
+                            continue;
+                        }
+                        if (rest[0] == '=') {
+                            open(rest.substr(1));
+                            continue;
+                        }
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+            void open(std::string_view path_view) {
+                std::string path(path_view);
+                if (m_open.size() >= m_max_depth) {
+                    m_error = ResponseFileError(path, "response files nested more than " + std::to_string(m_max_depth) +
+                                                          " levels deep");
+                    return;
+                }
+                std::string reason;
+                auto file = ResponseFile::open(path, reason);
+                if (!file) {
+                    m_error = ResponseFileError(path, reason);
+                    return;
+                }
+                m_open.push_back(std::move(file));
+                m_open_paths.push_back(std::move(path));
+            }
+        };
+
+    } // namespace detail
+} // namespace argu
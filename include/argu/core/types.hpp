@@ -3,10 +3,14 @@
 /// @file argu/core/types.hpp
 /// @brief Core type definitions for argu
 
+#include <argu/core/config.hpp>
+
 #include <any>
+#include <cerrno>
 #include <charconv>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <limits>
 #include <optional>
@@ -167,27 +171,21 @@ namespace argu {
                     }
                     return std::nullopt;
                 } else if constexpr (std::is_floating_point_v<T>) {
-                    try {
-                        std::size_t pos = 0;
-                        if constexpr (std::is_same_v<T, float>) {
-                            float val = std::stof(s, &pos);
-                            if (pos == s.size())
-                                return val;
-                            return std::nullopt;
-                        } else if constexpr (std::is_same_v<T, double>) {
-                            double val = std::stod(s, &pos);
-                            if (pos == s.size())
-                                return val;
-                            return std::nullopt;
-                        } else {
-                            long double val = std::stold(s, &pos);
-                            if (pos == s.size())
-                                return val;
-                            return std::nullopt;
-                        }
-                    } catch (...) {
-                        return std::nullopt;
+                    // strto* rather than sto*, which report failure by throwing
+                    const char *begin = s.c_str();
+                    char *end = nullptr;
+                    errno = 0;
+                    T val{};
+                    if constexpr (std::is_same_v<T, float>) {
+                        val = std::strtof(begin, &end);
+                    } else if constexpr (std::is_same_v<T, double>) {
+                        val = std::strtod(begin, &end);
+                    } else {
+                        val = std::strtold(begin, &end);
                     }
+                    if (s.empty() || end != begin + s.size() || errno == ERANGE)
+                        return std::nullopt;
+                    return val;
                 } else {
                     // Try stream extraction as fallback
                     std::istringstream iss(s);
@@ -226,6 +224,20 @@ namespace argu {
                 return std::optional<T>{*inner};
             }
         };
+
+#ifndef SCAN_HEADER_ONLY
+        // The common conversions are instantiated once, in src/argu/argu.cpp
+        extern template struct Converter<std::string>;
+        extern template struct Converter<bool>;
+        extern template struct Converter<int>;
+        extern template struct Converter<long>;
+        extern template struct Converter<long long>;
+        extern template struct Converter<unsigned>;
+        extern template struct Converter<unsigned long>;
+        extern template struct Converter<unsigned long long>;
+        extern template struct Converter<float>;
+        extern template struct Converter<double>;
+#endif
     } // namespace detail
 
     /// Validator function type - returns error message if validation fails
@@ -237,4 +249,7 @@ namespace argu {
     /// Completer function type - returns possible completions
     using Completer = std::function<std::vector<std::string>(const std::string &partial)>;
 
+    /// Executor function type - runs body(0) .. body(n - 1), possibly in parallel, and returns once all have run
+    using Executor = std::function<void(std::size_t n, const std::function<void(std::size_t)> &body)>;
+
 } // namespace argu
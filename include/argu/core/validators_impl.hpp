@@ -0,0 +1,621 @@
+#pragma once
+
+/// @file argu/core/validators_impl.hpp
+/// @brief Definitions of the built-in validators and transformers
+///
+/// Included by validators.hpp in header-only builds, and compiled once into
+/// the library otherwise (see argu/core/config.hpp).
+
+#include <argu/core/matchers.hpp>
+#include <argu/core/validators.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <string>
+#include <system_error>
+
+namespace argu {
+
+    namespace detail {
+
+        // error_code overloads: a path that cannot be examined (e.g. permission denied) simply fails the check
+        ARGU_INLINE std::optional<std::string> PathValidator::operator()(const std::string &value) const {
+            std::error_code ec;
+            switch (check) {
+            case PathCheck::Exists:
+                if (!std::filesystem::exists(value, ec)) {
+                    return "path does not exist: " + value;
+                }
+                break;
+            case PathCheck::IsFile:
+                if (!std::filesystem::is_regular_file(value, ec)) {
+                    return "file does not exist: " + value;
+                }
+                break;
+            case PathCheck::IsDir:
+                if (!std::filesystem::is_directory(value, ec)) {
+                    return "directory does not exist: " + value;
+                }
+                break;
+            case PathCheck::NotExists:
+                if (std::filesystem::exists(value, ec)) {
+                    return "path already exists: " + value;
+                }
+                break;
+            case PathCheck::ParentExists: {
+                auto parent = std::filesystem::path(value).parent_path();
+                if (!parent.empty() && !std::filesystem::exists(parent, ec)) {
+                    return "parent directory does not exist: " + parent.string();
+                }
+                break;
+            }
+            }
+            return std::nullopt;
+        }
+
+    } // namespace detail
+
+    namespace validators {
+
+        ARGU_INLINE Validator path_exists() { return detail::PathValidator{detail::PathCheck::Exists}; }
+
+        ARGU_INLINE Validator file_exists() { return detail::PathValidator{detail::PathCheck::IsFile}; }
+
+        ARGU_INLINE Validator dir_exists() { return detail::PathValidator{detail::PathCheck::IsDir}; }
+
+        ARGU_INLINE Validator path_not_exists() { return detail::PathValidator{detail::PathCheck::NotExists}; }
+
+        ARGU_INLINE Validator parent_exists() { return detail::PathValidator{detail::PathCheck::ParentExists}; }
+
+        ARGU_INLINE Validator has_extension(const std::vector<std::string> &extensions) {
+            return [extensions](const std::string &value) -> std::optional<std::string> {
+                std::filesystem::path p(value);
+                std::string ext = p.extension().string();
+                if (!ext.empty() && ext[0] == '.')
+                    ext = ext.substr(1);
+
+                for (auto &c : ext)
+                    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+                for (const auto &e : extensions) {
+                    std::string lower_e = e;
+                    for (auto &c : lower_e)
+                        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                    if (lower_e[0] == '.')
+                        lower_e = lower_e.substr(1);
+                    if (ext == lower_e)
+                        return std::nullopt;
+                }
+
+                std::string valid;
+                for (std::size_t i = 0; i < extensions.size(); ++i) {
+                    if (i > 0)
+                        valid += ", ";
+                    valid += extensions[i];
+                }
+                return "file must have extension: " + valid;
+            };
+        }
+
+        ARGU_INLINE Validator non_empty() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (value.empty()) {
+                    return "value cannot be empty";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator min_length(std::size_t min) {
+            return [min](const std::string &value) -> std::optional<std::string> {
+                if (value.length() < min) {
+                    return "value must be at least " + std::to_string(min) + " characters";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator max_length(std::size_t max) {
+            return [max](const std::string &value) -> std::optional<std::string> {
+                if (value.length() > max) {
+                    return "value must be at most " + std::to_string(max) + " characters";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator length_range(std::size_t min, std::size_t max) {
+            return [min, max](const std::string &value) -> std::optional<std::string> {
+                if (value.length() < min || value.length() > max) {
+                    return "value length must be between " + std::to_string(min) + " and " + std::to_string(max);
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator alphanumeric() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!std::all_of(value.begin(), value.end(),
+                                 [](char c) { return std::isalnum(static_cast<unsigned char>(c)); })) {
+                    return "value must be alphanumeric";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator alphabetic() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!std::all_of(value.begin(), value.end(),
+                                 [](char c) { return std::isalpha(static_cast<unsigned char>(c)); })) {
+                    return "value must contain only letters";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator numeric() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!std::all_of(value.begin(), value.end(),
+                                 [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+                    return "value must contain only digits";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator starts_with(const std::string &prefix) {
+            return [prefix](const std::string &value) -> std::optional<std::string> {
+                if (value.size() < prefix.size() || value.substr(0, prefix.size()) != prefix) {
+                    return "value must start with '" + prefix + "'";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator ends_with(const std::string &suffix) {
+            return [suffix](const std::string &value) -> std::optional<std::string> {
+                if (value.size() < suffix.size() || value.substr(value.size() - suffix.size()) != suffix) {
+                    return "value must end with '" + suffix + "'";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator contains(const std::string &substr) {
+            return [substr](const std::string &value) -> std::optional<std::string> {
+                if (value.find(substr) == std::string::npos) {
+                    return "value must contain '" + substr + "'";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator not_contains(const std::string &substr) {
+            return [substr](const std::string &value) -> std::optional<std::string> {
+                if (value.find(substr) != std::string::npos) {
+                    return "value must not contain '" + substr + "'";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator port() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                auto converted = detail::Converter<int>::convert(value);
+                if (!converted) {
+                    return "invalid port number";
+                }
+                if (*converted < 1 || *converted > 65535) {
+                    return "port must be between 1 and 65535";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator non_privileged_port() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                auto converted = detail::Converter<int>::convert(value);
+                if (!converted) {
+                    return "invalid port number";
+                }
+                if (*converted < 1024 || *converted > 65535) {
+                    return "port must be between 1024 and 65535 (non-privileged)";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator regex(const std::string &pattern, const std::string &error_msg) {
+            // Compiled once, when the validator is created, and shared by its copies
+            auto re = std::make_shared<const std::regex>(pattern, std::regex::optimize);
+            return [re, pattern, error_msg](const std::string &value) -> std::optional<std::string> {
+                if (!std::regex_match(value, *re)) {
+                    if (!error_msg.empty()) {
+                        return error_msg;
+                    }
+                    return "value does not match pattern: " + pattern;
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator email() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!detail::match_email(value)) {
+                    return "invalid email address";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator url() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!detail::match_url(value)) {
+                    return "invalid URL";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator ipv4() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                switch (detail::match_ipv4(value)) {
+                case detail::Ipv4Match::BadFormat:
+                    return "invalid IPv4 address";
+                case detail::Ipv4Match::OutOfRange:
+                    return "invalid IPv4 address: octet out of range";
+                default:
+                    return std::nullopt;
+                }
+            };
+        }
+
+        ARGU_INLINE Validator ipv6() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                // Simplified IPv6 check: 2-7 colons, groups of up to 4 hex digits
+                if (!detail::match_ipv6(value)) {
+                    return "invalid IPv6 address";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator hostname() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (value.empty() || value.length() > 253) {
+                    return "invalid hostname length";
+                }
+                if (!detail::match_hostname(value)) {
+                    return "invalid hostname";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator host_port() {
+            auto host_check = hostname();
+            auto port_check = port();
+            return [host_check, port_check](const std::string &value) -> std::optional<std::string> {
+                auto colon_pos = value.rfind(':');
+                if (colon_pos == std::string::npos) {
+                    return "value must be in host:port format";
+                }
+                std::string host = value.substr(0, colon_pos);
+                std::string port_str = value.substr(colon_pos + 1);
+
+                auto hostname_err = host_check(host);
+                if (hostname_err)
+                    return hostname_err;
+
+                auto port_err = port_check(port_str);
+                if (port_err)
+                    return port_err;
+
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator semver() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!detail::match_semver(value)) {
+                    return "invalid semantic version (expected X.Y.Z format)";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator date_iso() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!detail::match_date_iso(value)) {
+                    return "invalid date (expected YYYY-MM-DD format)";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator time_iso() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!detail::match_time_iso(value)) {
+                    return "invalid time (expected HH:MM:SS format)";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator duration() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!detail::match_compact_duration(value)) {
+                    return "invalid duration (expected format like 1h30m, 30s, 1d)";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator uuid() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!detail::match_uuid(value)) {
+                    return "invalid UUID format (expected xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx)";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator uuid_v4() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!detail::match_uuid_v4(value)) {
+                    return "invalid UUID v4 format";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator hex_color() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!detail::match_hex_color(value)) {
+                    return "invalid hex color (expected #RGB or #RRGGBB)";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator json_object() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (value.empty() || value.front() != '{' || value.back() != '}') {
+                    return "value must be a JSON object (starts with '{' and ends with '}')";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator json_array() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (value.empty() || value.front() != '[' || value.back() != ']') {
+                    return "value must be a JSON array (starts with '[' and ends with ']')";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator identifier() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (value.empty())
+                    return "identifier cannot be empty";
+                if (!std::isalpha(static_cast<unsigned char>(value[0])) && value[0] != '_') {
+                    return "identifier must start with a letter or underscore";
+                }
+                for (char c : value) {
+                    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+                        return "identifier must contain only letters, digits, and underscores";
+                    }
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator kebab_case() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!detail::match_separated_lower(value, '-')) {
+                    return "value must be in kebab-case format";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator snake_case() {
+            return [](const std::string &value) -> std::optional<std::string> {
+                if (!detail::match_separated_lower(value, '_')) {
+                    return "value must be in snake_case format";
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator all_of(std::initializer_list<Validator> validators) {
+            std::vector<Validator> vals(validators);
+            return [vals](const std::string &value) -> std::optional<std::string> {
+                for (const auto &v : vals) {
+                    auto error = v(value);
+                    if (error)
+                        return error;
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator any_of(std::initializer_list<Validator> validators) {
+            std::vector<Validator> vals(validators);
+            return [vals](const std::string &value) -> std::optional<std::string> {
+                std::string errors;
+                for (const auto &v : vals) {
+                    auto error = v(value);
+                    if (!error)
+                        return std::nullopt;
+                    if (!errors.empty())
+                        errors += "; ";
+                    errors += *error;
+                }
+                return "none of the validators passed: " + errors;
+            };
+        }
+
+        ARGU_INLINE Validator not_validator(Validator validator, const std::string &error_msg) {
+            return [validator, error_msg](const std::string &value) -> std::optional<std::string> {
+                auto error = validator(value);
+                if (!error) {
+                    return error_msg.empty() ? "validation unexpectedly passed" : error_msg;
+                }
+                return std::nullopt;
+            };
+        }
+
+        ARGU_INLINE Validator lowercase_before(Validator next) {
+            return [next](const std::string &value) -> std::optional<std::string> {
+                std::string lower = value;
+                std::transform(lower.begin(), lower.end(), lower.begin(),
+                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                return next(lower);
+            };
+        }
+
+        ARGU_INLINE Validator trim_before(Validator next) {
+            return [next](const std::string &value) -> std::optional<std::string> {
+                std::string trimmed = value;
+                trimmed.erase(0, trimmed.find_first_not_of(" \t\n\r"));
+                auto pos = trimmed.find_last_not_of(" \t\n\r");
+                if (pos != std::string::npos) {
+                    trimmed.erase(pos + 1);
+                }
+                return next(trimmed);
+            };
+        }
+
+    } // namespace validators
+
+    namespace transformers {
+
+        ARGU_INLINE Transformer lowercase() {
+            return [](const std::string &value) -> std::string {
+                std::string result = value;
+                std::transform(result.begin(), result.end(), result.begin(),
+                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                return result;
+            };
+        }
+
+        ARGU_INLINE Transformer uppercase() {
+            return [](const std::string &value) -> std::string {
+                std::string result = value;
+                std::transform(result.begin(), result.end(), result.begin(),
+                               [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+                return result;
+            };
+        }
+
+        ARGU_INLINE Transformer trim() {
+            return [](const std::string &value) -> std::string {
+                std::string result = value;
+                result.erase(0, result.find_first_not_of(" \t\n\r"));
+                auto pos = result.find_last_not_of(" \t\n\r");
+                if (pos != std::string::npos) {
+                    result.erase(pos + 1);
+                }
+                return result;
+            };
+        }
+
+        ARGU_INLINE Transformer replace(const std::string &from, const std::string &to) {
+            return [from, to](const std::string &value) -> std::string {
+                std::string result = value;
+                std::size_t pos = 0;
+                while ((pos = result.find(from, pos)) != std::string::npos) {
+                    result.replace(pos, from.length(), to);
+                    pos += to.length();
+                }
+                return result;
+            };
+        }
+
+        ARGU_INLINE Transformer ensure_prefix(const std::string &prefix) {
+            return [prefix](const std::string &value) -> std::string {
+                if (value.size() >= prefix.size() && value.substr(0, prefix.size()) == prefix) {
+                    return value;
+                }
+                return prefix + value;
+            };
+        }
+
+        ARGU_INLINE Transformer ensure_suffix(const std::string &suffix) {
+            return [suffix](const std::string &value) -> std::string {
+                if (value.size() >= suffix.size() && value.substr(value.size() - suffix.size()) == suffix) {
+                    return value;
+                }
+                return value + suffix;
+            };
+        }
+
+        ARGU_INLINE Transformer expand_tilde() {
+            return [](const std::string &value) -> std::string {
+                if (!value.empty() && value[0] == '~') {
+                    const char *home = std::getenv("HOME");
+                    if (!home)
+                        home = std::getenv("USERPROFILE"); // Windows
+                    if (home) {
+                        return std::string(home) + value.substr(1);
+                    }
+                }
+                return value;
+            };
+        }
+
+        ARGU_INLINE Transformer normalize_path() {
+            return [](const std::string &value) -> std::string {
+                std::string result = value;
+                std::replace(result.begin(), result.end(), '\\', '/');
+                return result;
+            };
+        }
+
+        ARGU_INLINE Transformer limit_items(char delimiter, std::size_t max_items) {
+            return [delimiter, max_items](const std::string &value) -> std::string {
+                std::string result;
+                std::size_t count = 0;
+                std::size_t start = 0;
+                std::size_t pos = 0;
+                while ((pos = value.find(delimiter, start)) != std::string::npos && count < max_items) {
+                    if (!result.empty())
+                        result += delimiter;
+                    result += value.substr(start, pos - start);
+                    start = pos + 1;
+                    ++count;
+                }
+                if (count < max_items && start < value.size()) {
+                    if (!result.empty())
+                        result += delimiter;
+                    result += value.substr(start);
+                }
+                return result;
+            };
+        }
+
+        ARGU_INLINE Transformer map_value(const std::vector<std::pair<std::string, std::string>> &mappings) {
+            return [mappings](const std::string &value) -> std::string {
+                for (const auto &[from, to] : mappings) {
+                    if (value == from)
+                        return to;
+                }
+                return value;
+            };
+        }
+
+        ARGU_INLINE Transformer default_if_empty(const std::string &default_val) {
+            return
+                [default_val](const std::string &value) -> std::string { return value.empty() ? default_val : value; };
+        }
+
+    } // namespace transformers
+
+} // namespace argu
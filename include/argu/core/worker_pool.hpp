@@ -0,0 +1,120 @@
+#pragma once
+
+/// @file argu/core/worker_pool.hpp
+/// @brief Persistent helper threads for batched parse work
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace argu {
+    namespace detail {
+
+        /// Fallback helper threads for commands without an executor(), started on first use and kept until exit
+        ///
+        /// argu does not depend on scan, so it cannot use scan::ThreadPool itself; applications that
+        /// have a pool pass it through Command::executor() and never start these threads. The pool
+        /// starts no thread until a batch asks for helpers, then grows to the largest number asked
+        /// for (at most max_threads), so repeated parses reuse the same threads.
+        class WorkerPool {
+          public:
+            static constexpr std::size_t max_threads = 64;
+
+            /// The process-wide pool
+            static WorkerPool &shared() {
+                static WorkerPool pool;
+                return pool;
+            }
+
+            WorkerPool() = default;
+            WorkerPool(const WorkerPool &) = delete;
+            WorkerPool &operator=(const WorkerPool &) = delete;
+
+            ~WorkerPool() {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_stop = true;
+                }
+                m_wake.notify_all();
+                for (auto &worker : m_workers) {
+                    worker.join();
+                }
+            }
+
+            /// Run fn(0..n-1) on up to `threads` threads, the calling thread included, and wait for every call
+            ///
+            /// fn must not throw. The caller works through the indices itself; helpers still queued
+            /// when it runs out are withdrawn, so a pool busy with other parses never makes it wait.
+            void parallel_for(std::size_t n, std::size_t threads, const std::function<void(std::size_t)> &fn) {
+                Batch batch{fn, n};
+                std::size_t helpers = std::min({threads, n, max_threads});
+                helpers = helpers > 0 ? helpers - 1 : 0;
+                if (helpers > 0) {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        while (m_workers.size() < helpers) {
+                            m_workers.emplace_back([this] { work(); });
+                        }
+                        m_queue.insert(m_queue.end(), helpers, &batch);
+                        batch.helpers = helpers;
+                    }
+                    m_wake.notify_all();
+                }
+
+                batch.run();
+
+                if (helpers > 0) {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    batch.helpers -= std::erase(m_queue, &batch);
+                    m_done.wait(lock, [&batch] { return batch.helpers == 0; });
+                }
+            }
+
+          private:
+            struct Batch {
+                const std::function<void(std::size_t)> &fn;
+                std::size_t n;
+                std::atomic<std::size_t> next{0};
+                std::size_t helpers = 0; // Queued or running helpers, guarded by m_mutex
+
+                void run() {
+                    for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < n;) {
+                        fn(i);
+                    }
+                }
+            };
+
+            std::mutex m_mutex;
+            std::condition_variable m_wake; // A batch was queued, or the pool is stopping
+            std::condition_variable m_done; // A helper finished its batch
+            std::deque<Batch *> m_queue;    // One entry per helper a batch asked for
+            std::vector<std::thread> m_workers;
+            bool m_stop = false;
+
+            void work() {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                while (true) {
+                    m_wake.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+                    if (m_queue.empty()) {
+                        return;
+                    }
+                    Batch *batch = m_queue.front();
+                    m_queue.pop_front();
+                    lock.unlock();
+                    batch->run();
+                    lock.lock();
+                    if (--batch->helpers == 0) {
+                        m_done.notify_all();
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+} // namespace argu
@@ -3,14 +3,24 @@
 /// @file argu/parsers/duration.hpp
 /// @brief Human-friendly duration parsing (5s, 10m, 2h, 1d)
 
+#include <argu/core/config.hpp>
+#include <argu/core/types.hpp>
+
+#include <cctype>
+#include <cerrno>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <optional>
-#include <regex>
 #include <string>
 
 namespace argu {
     namespace parsers {
 
+        /// Sum of the `<number><unit>` parts of a compound duration like "2h30m"
+        /// Returns nullopt if the string contains no such part
+        std::optional<std::chrono::nanoseconds> parse_compound_duration(const std::string &str);
+
         /// Parse a human-friendly duration string
         /// Supports: ns, us, ms, s, m, h, d (and combinations like "2h30m")
         /// Returns duration in the specified unit (default: seconds)
@@ -29,78 +39,29 @@ namespace argu {
                 }
             }
             if (all_digits) {
-                try {
-                    double val = std::stod(str);
-                    return std::chrono::duration_cast<Duration>(
-                        std::chrono::duration<double, typename Duration::period>(val));
-                } catch (...) {
+                char *end = nullptr;
+                errno = 0;
+                double val = std::strtod(str.c_str(), &end);
+                if (end == str.c_str() || errno == ERANGE) {
                     return std::nullopt;
                 }
+                return std::chrono::duration_cast<Duration>(
+                    std::chrono::duration<double, typename Duration::period>(val));
             }
 
             // Parse compound duration like "2h30m45s"
-            std::regex pattern(R"((\d+(?:\.\d+)?)\s*(ns|us|µs|ms|s|m|h|d))");
-            std::smatch match;
-            std::string remaining = str;
-
-            std::chrono::nanoseconds total{0};
-            bool found_any = false;
-
-            while (std::regex_search(remaining, match, pattern)) {
-                found_any = true;
-                double value = std::stod(match[1].str());
-                std::string unit = match[2].str();
-
-                std::chrono::nanoseconds part{0};
-                if (unit == "ns") {
-                    part = std::chrono::nanoseconds(static_cast<int64_t>(value));
-                } else if (unit == "us" || unit == "µs") {
-                    part = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                        std::chrono::duration<double, std::micro>(value));
-                } else if (unit == "ms") {
-                    part = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                        std::chrono::duration<double, std::milli>(value));
-                } else if (unit == "s") {
-                    part = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(value));
-                } else if (unit == "m") {
-                    part = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                        std::chrono::duration<double, std::ratio<60>>(value));
-                } else if (unit == "h") {
-                    part = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                        std::chrono::duration<double, std::ratio<3600>>(value));
-                } else if (unit == "d") {
-                    part = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                        std::chrono::duration<double, std::ratio<86400>>(value));
-                }
-
-                total += part;
-                remaining = match.suffix().str();
-            }
-
-            if (!found_any) {
+            auto total = parse_compound_duration(str);
+            if (!total) {
                 return std::nullopt;
             }
-
-            return std::chrono::duration_cast<Duration>(total);
+            return std::chrono::duration_cast<Duration>(*total);
         }
 
         /// Parse duration to seconds (convenience function)
-        inline std::optional<int64_t> parse_duration_seconds(const std::string &str) {
-            auto result = parse_duration<std::chrono::seconds>(str);
-            if (result) {
-                return result->count();
-            }
-            return std::nullopt;
-        }
+        std::optional<int64_t> parse_duration_seconds(const std::string &str);
 
         /// Parse duration to milliseconds (convenience function)
-        inline std::optional<int64_t> parse_duration_ms(const std::string &str) {
-            auto result = parse_duration<std::chrono::milliseconds>(str);
-            if (result) {
-                return result->count();
-            }
-            return std::nullopt;
-        }
+        std::optional<int64_t> parse_duration_ms(const std::string &str);
 
         /// Format a duration as human-readable string
         template <typename Duration> std::string format_duration(Duration dur) {
@@ -162,27 +123,15 @@ namespace argu {
     namespace transformers {
 
         /// Transform duration string to seconds (as string)
-        inline Transformer duration_to_seconds() {
-            return [](const std::string &value) -> std::string {
-                auto result = parsers::parse_duration_seconds(value);
-                if (result) {
-                    return std::to_string(*result);
-                }
-                return value; // Return original if parsing fails (let validator handle it)
-            };
-        }
+        Transformer duration_to_seconds();
 
         /// Transform duration string to milliseconds (as string)
-        inline Transformer duration_to_ms() {
-            return [](const std::string &value) -> std::string {
-                auto result = parsers::parse_duration_ms(value);
-                if (result) {
-                    return std::to_string(*result);
-                }
-                return value;
-            };
-        }
+        Transformer duration_to_ms();
 
     } // namespace transformers
 
 } // namespace argu
+
+#ifdef SCAN_HEADER_ONLY
+#include <argu/parsers/duration_impl.hpp>
+#endif
@@ -0,0 +1,110 @@
+#pragma once
+
+/// @file argu/parsers/duration_impl.hpp
+/// @brief Definitions of the duration parsers and transformers
+///
+/// Included by duration.hpp in header-only builds, and compiled once into
+/// the library otherwise (see argu/core/config.hpp).
+
+#include <argu/parsers/duration.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <regex>
+#include <string>
+
+namespace argu {
+
+    namespace parsers {
+
+        ARGU_INLINE std::optional<std::chrono::nanoseconds> parse_compound_duration(const std::string &str) {
+            static const std::regex pattern(R"((\d+(?:\.\d+)?)\s*(ns|us|µs|ms|s|m|h|d))", std::regex::optimize);
+            std::smatch match;
+            std::string remaining = str;
+
+            std::chrono::nanoseconds total{0};
+            bool found_any = false;
+
+            while (std::regex_search(remaining, match, pattern)) {
+                found_any = true;
+                double value = std::strtod(match[1].str().c_str(), nullptr); // Only digits matched; never throws
+                std::string unit = match[2].str();
+
+                std::chrono::nanoseconds part{0};
+                if (unit == "ns") {
+                    part = std::chrono::nanoseconds(static_cast<int64_t>(value));
+                } else if (unit == "us" || unit == "µs") {
+                    part = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::duration<double, std::micro>(value));
+                } else if (unit == "ms") {
+                    part = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::duration<double, std::milli>(value));
+                } else if (unit == "s") {
+                    part = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(value));
+                } else if (unit == "m") {
+                    part = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::duration<double, std::ratio<60>>(value));
+                } else if (unit == "h") {
+                    part = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::duration<double, std::ratio<3600>>(value));
+                } else if (unit == "d") {
+                    part = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::duration<double, std::ratio<86400>>(value));
+                }
+
+                total += part;
+                remaining = match.suffix().str();
+            }
+
+            if (!found_any) {
+                return std::nullopt;
+            }
+
+            return total;
+        }
+
+        ARGU_INLINE std::optional<int64_t> parse_duration_seconds(const std::string &str) {
+            auto result = parse_duration<std::chrono::seconds>(str);
+            if (result) {
+                return result->count();
+            }
+            return std::nullopt;
+        }
+
+        ARGU_INLINE std::optional<int64_t> parse_duration_ms(const std::string &str) {
+            auto result = parse_duration<std::chrono::milliseconds>(str);
+            if (result) {
+                return result->count();
+            }
+            return std::nullopt;
+        }
+
+    } // namespace parsers
+
+    namespace transformers {
+
+        ARGU_INLINE Transformer duration_to_seconds() {
+            return [](const std::string &value) -> std::string {
+                auto result = parsers::parse_duration_seconds(value);
+                if (result) {
+                    return std::to_string(*result);
+                }
+                return value; // Return original if parsing fails (let validator handle it)
+            };
+        }
+
+        ARGU_INLINE Transformer duration_to_ms() {
+            return [](const std::string &value) -> std::string {
+                auto result = parsers::parse_duration_ms(value);
+                if (result) {
+                    return std::to_string(*result);
+                }
+                return value;
+            };
+        }
+
+    } // namespace transformers
+
+} // namespace argu
@@ -5,9 +5,12 @@
 
 #include <argu/core/types.hpp>
 
+#include <charconv>
+#include <climits>
 #include <cstdio>
 #include <cstdlib>
 #include <string>
+#include <system_error>
 
 // Platform-specific includes for terminal detection
 #if defined(_WIN32) || defined(_WIN64)
@@ -37,14 +40,13 @@ namespace argu {
             if (h.size() != 6)
                 return Color{255, 255, 255};
 
-            try {
-                int r = std::stoi(h.substr(0, 2), nullptr, 16);
-                int g = std::stoi(h.substr(2, 2), nullptr, 16);
-                int b = std::stoi(h.substr(4, 2), nullptr, 16);
-                return Color{r, g, b};
-            } catch (...) {
-                return Color{255, 255, 255};
+            int rgb[3] = {};
+            for (int i = 0; i < 3; ++i) {
+                const char *first = h.data() + 2 * i;
+                if (std::from_chars(first, first + 2, rgb[i], 16).ec != std::errc{})
+                    return Color{255, 255, 255};
             }
+            return Color{rgb[0], rgb[1], rgb[2]};
         }
 
         /// Predefined colors
@@ -166,14 +168,11 @@ namespace argu {
             // Check COLUMNS environment variable first
             const char *columns = std::getenv("COLUMNS");
             if (columns) {
-                try {
-                    int width = std::stoi(columns);
-                    if (width > 0) {
-                        return static_cast<std::size_t>(width);
-                    }
-                } catch (...) {
-                    // Fall through to other methods
+                long width = std::strtol(columns, nullptr, 10);
+                if (width > 0 && width <= INT_MAX) {
+                    return static_cast<std::size_t>(width);
                 }
+                // Otherwise fall through to other methods
             }
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -198,14 +197,11 @@ namespace argu {
             // Check LINES environment variable first
             const char *lines = std::getenv("LINES");
             if (lines) {
-                try {
-                    int height = std::stoi(lines);
-                    if (height > 0) {
-                        return static_cast<std::size_t>(height);
-                    }
-                } catch (...) {
-                    // Fall through to other methods
+                long height = std::strtol(lines, nullptr, 10);
+                if (height > 0 && height <= INT_MAX) {
+                    return static_cast<std::size_t>(height);
                 }
+                // Otherwise fall through to other methods
             }
 
 #if defined(_WIN32) || defined(_WIN64)
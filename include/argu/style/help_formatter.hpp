@@ -410,12 +410,6 @@ namespace argu {
         }
     };
 
-    // Implementation of Command::help
-    inline std::string Command::help() const {
-        HelpFormatter formatter(*this);
-        return formatter.format();
-    }
-
     // Implementation of Command::version_string
     inline std::string Command::version_string() const {
         std::ostringstream oss;
@@ -0,0 +1,477 @@
+#pragma once
+
+/// @file chart.hpp
+/// @brief Sparkline and Braille line chart for large time series
+
+#include <scan/style/style.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace scan {
+
+    /// Append-only series with cached min/max levels for fast downsampling
+    ///
+    /// Level k holds the min and max of each aligned block of 2^k points, built
+    /// as points arrive, so append is O(1) amortized and the min/max of any range
+    /// takes O(log n). Drawing a chart of any size therefore costs proportional to
+    /// its width, not to the number of points. NaN points are treated as gaps.
+    class Series {
+      public:
+        struct Range {
+            double min = std::numeric_limits<double>::infinity();
+            double max = -std::numeric_limits<double>::infinity();
+
+            bool empty() const { return min > max; }
+            void merge(const Range &o) {
+                min = std::min(min, o.min);
+                max = std::max(max, o.max);
+            }
+        };
+
+        /// @param max_points Keep at most this many recent points (0 = unbounded)
+        explicit Series(size_t max_points = 0) : m_max_points(max_points) {}
+
+        void push(double value) {
+            m_values.push_back(value);
+            // A right child completes its parent block one level up
+            size_t idx = m_values.size() - 1;
+            for (size_t k = 0; idx & 1; k++) {
+                Range merged = at(k, idx - 1);
+                merged.merge(at(k, idx));
+                if (m_levels.size() <= k) {
+                    m_levels.emplace_back();
+                }
+                m_levels[k].push_back(merged);
+                idx >>= 1;
+            }
+
+            // Trim in large steps so dropping old points stays amortized O(1)
+            if (m_max_points > 0 && m_values.size() >= 2 * m_max_points) {
+                std::vector<double> keep(m_values.end() - static_cast<long>(m_max_points), m_values.end());
+                m_dropped += m_values.size() - keep.size();
+                clear_levels();
+                for (double v : keep) {
+                    push(v);
+                }
+            }
+        }
+
+        template <typename It> void append(It first, It last) {
+            for (; first != last; ++first) {
+                push(static_cast<double>(*first));
+            }
+        }
+
+        /// Min and max over points [first, last) - O(log n)
+        Range range(size_t first, size_t last) const {
+            Range r;
+            last = std::min(last, m_values.size());
+            if (first >= last) {
+                return r;
+            }
+            // Bottom-up segment walk: peel off unaligned ends, then move a level up
+            size_t a = first, b = last;
+            for (size_t k = 0; a < b; k++) {
+                if (a & 1) {
+                    r.merge(at(k, a++));
+                }
+                if (b & 1) {
+                    r.merge(at(k, --b));
+                }
+                a >>= 1;
+                b >>= 1;
+            }
+            return r;
+        }
+
+        /// Min and max of the whole series
+        Range bounds() const { return range(0, m_values.size()); }
+
+        size_t size() const { return m_values.size(); }
+        bool empty() const { return m_values.empty(); }
+        double operator[](size_t i) const { return m_values[i]; }
+        const std::vector<double> &values() const { return m_values; }
+
+        /// Points dropped from the front because of max_points
+        size_t dropped() const { return m_dropped; }
+
+        void clear() {
+            m_dropped += m_values.size();
+            clear_levels();
+        }
+
+      private:
+        std::vector<double> m_values;
+        std::vector<std::vector<Range>> m_levels; // m_levels[k - 1] is level k
+        size_t m_max_points = 0;
+        size_t m_dropped = 0;
+
+        static Range point(double v) {
+            Range r;
+            if (!std::isnan(v)) {
+                r.min = r.max = v;
+            }
+            return r;
+        }
+
+        Range at(size_t level, size_t i) const { return level == 0 ? point(m_values[i]) : m_levels[level - 1][i]; }
+
+        void clear_levels() {
+            m_values.clear();
+            m_levels.clear();
+        }
+    };
+
+    /// Largest-Triangle-Three-Buckets: pick threshold points that best preserve the shape
+    /// @return Indices into values, first and last always included. O(n).
+    inline std::vector<size_t> lttb(const std::vector<double> &values, size_t threshold) {
+        size_t n = values.size();
+        std::vector<size_t> out;
+        if (threshold >= n || threshold < 3) {
+            for (size_t i = 0; i < n; i++) {
+                out.push_back(i);
+            }
+            return out;
+        }
+
+        out.reserve(threshold);
+        double bucket = static_cast<double>(n - 2) / static_cast<double>(threshold - 2);
+        size_t a = 0;
+        out.push_back(0);
+        for (size_t i = 0; i < threshold - 2; i++) {
+            // Average of the next bucket is the third triangle vertex
+            size_t next_start = static_cast<size_t>(std::floor((i + 1) * bucket)) + 1;
+            size_t next_end = std::min(static_cast<size_t>(std::floor((i + 2) * bucket)) + 1, n);
+            double avg_x = 0, avg_y = 0;
+            for (size_t j = next_start; j < next_end; j++) {
+                avg_x += static_cast<double>(j);
+                avg_y += values[j];
+            }
+            double count = static_cast<double>(std::max<size_t>(1, next_end - next_start));
+            avg_x /= count;
+            avg_y /= count;
+
+            size_t start = static_cast<size_t>(std::floor(i * bucket)) + 1;
+            size_t end = static_cast<size_t>(std::floor((i + 1) * bucket)) + 1;
+            double best = -1;
+            size_t pick = start;
+            for (size_t j = start; j < end; j++) {
+                double area = std::abs((static_cast<double>(a) - avg_x) * (values[j] - values[a]) -
+                                       (static_cast<double>(a) - static_cast<double>(j)) * (avg_y - values[a]));
+                if (area > best) {
+                    best = area;
+                    pick = j;
+                }
+            }
+            out.push_back(pick);
+            a = pick;
+        }
+        out.push_back(n - 1);
+        return out;
+    }
+
+    namespace detail {
+
+        /// UTF-8 for the Braille cell with the given dot bits (U+2800 + bits)
+        inline void append_braille(std::string &out, uint8_t bits) {
+            out += static_cast<char>(0xE2);
+            out += static_cast<char>(0xA0 | (bits >> 6));
+            out += static_cast<char>(0x80 | (bits & 0x3F));
+        }
+
+        /// Split [first, last) into columns evenly and return column c's points
+        inline std::pair<size_t, size_t> column_span(size_t first, size_t last, size_t columns, size_t c) {
+            size_t len = last - first;
+            return {first + len * c / columns, first + len * (c + 1) / columns};
+        }
+
+    } // namespace detail
+
+    struct SparklineModel {
+        Series series;
+        int width = 40;             // Cells; each shows the peak of its points
+        size_t window = 0;          // Show only the last N points (0 = all)
+        std::optional<double> min;  // Fixed scale instead of the visible range
+        std::optional<double> max;
+
+        // Styling - uses theme
+        Color color;
+        Color muted_color;
+
+        SparklineModel() {
+            auto t = theme_snapshot();
+            color = t->colors.secondary;
+            muted_color = t->colors.text_subtle;
+        }
+    };
+
+    /// One line of block glyphs; O(width log n) regardless of the number of points
+    inline std::string sparkline_view(const SparklineModel &m) {
+        static const char *blocks[] = {"▁", "▂", "▃", "▄", "▅", "▆", "▇", "█"};
+        size_t width = static_cast<size_t>(std::max(1, m.width));
+        size_t last = m.series.size();
+        size_t first = m.window > 0 && last > m.window ? last - m.window : 0;
+        size_t columns = std::min(width, last - first);
+        if (columns == 0) {
+            return Style().foreground(m.muted_color).render(std::string(width, ' '));
+        }
+
+        Series::Range bounds = m.series.range(first, last);
+        double lo = m.min.value_or(bounds.min);
+        double hi = m.max.value_or(bounds.max);
+
+        std::string line;
+        line.reserve(columns * 3);
+        for (size_t c = 0; c < columns; c++) {
+            auto [a, b] = detail::column_span(first, last, columns, c);
+            Series::Range r = m.series.range(a, b);
+            if (r.empty()) {
+                line += ' ';
+                continue;
+            }
+            double t = hi > lo ? (r.max - lo) / (hi - lo) : 0.5;
+            int level = static_cast<int>(std::lround(std::clamp(t, 0.0, 1.0) * 7));
+            line += blocks[level];
+        }
+
+        // Right-align so the newest point sits at the edge as the series grows
+        std::string pad(width - columns, ' ');
+        return pad + Style().foreground(m.color).render(line);
+    }
+
+    struct ChartModel {
+        Series series;
+        int width = 60; // Cells including the axis
+        int height = 10;
+        size_t window = 0; // Show only the last N points (0 = all)
+        std::optional<double> min;
+        std::optional<double> max;
+        std::string title;
+        bool show_axis = true;
+
+        // Styling - uses theme
+        Color line_color;
+        Color axis_color;
+        Color title_color;
+
+        ChartModel() {
+            auto t = theme_snapshot();
+            line_color = t->colors.secondary;
+            axis_color = t->colors.text_muted;
+            title_color = t->colors.primary;
+        }
+    };
+
+    inline std::string chart_format_value(double v) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.4g", v);
+        return buf;
+    }
+
+    /// Braille line chart (2x4 dots per cell) drawn from per-column min/max envelopes
+    /// Cost is O(width * log n + width * height) regardless of the number of points.
+    inline std::string chart_view(const ChartModel &m) {
+        size_t rows = static_cast<size_t>(std::max(1, m.height));
+        size_t last = m.series.size();
+        size_t first = m.window > 0 && last > m.window ? last - m.window : 0;
+
+        Series::Range bounds = m.series.range(first, last);
+        double lo = m.min.value_or(bounds.empty() ? 0.0 : bounds.min);
+        double hi = m.max.value_or(bounds.empty() ? 1.0 : bounds.max);
+        if (hi <= lo) {
+            hi = lo + 1.0;
+            lo -= 1.0;
+        }
+
+        std::string top_label, bottom_label;
+        size_t axis = 0;
+        if (m.show_axis) {
+            top_label = chart_format_value(hi);
+            bottom_label = chart_format_value(lo);
+            axis = std::max(top_label.size(), bottom_label.size()) + 2; // label + " ┤"
+        }
+        size_t cells = static_cast<size_t>(std::max(1, m.width)) > axis + 1
+                           ? static_cast<size_t>(m.width) - axis
+                           : 1;
+
+        size_t dots_x = cells * 2;
+        size_t dots_y = rows * 4;
+        size_t columns = std::min(dots_x, last - first);
+        std::vector<uint8_t> grid(cells * rows, 0);
+
+        static const uint8_t dot_bits[2][4] = {{0x01, 0x02, 0x04, 0x40}, {0x08, 0x10, 0x20, 0x80}};
+        auto to_dot = [&](double v) {
+            double t = std::clamp((v - lo) / (hi - lo), 0.0, 1.0);
+            return static_cast<size_t>(std::lround(t * static_cast<double>(dots_y - 1)));
+        };
+
+        // Newest points sit at the right edge
+        size_t x0 = dots_x - columns;
+        std::optional<std::pair<size_t, size_t>> prev;
+        for (size_t c = 0; c < columns; c++) {
+            auto [a, b] = detail::column_span(first, last, columns, c);
+            Series::Range r = m.series.range(a, b);
+            if (r.empty()) {
+                prev.reset();
+                continue;
+            }
+            size_t y_lo = to_dot(r.min);
+            size_t y_hi = to_dot(r.max);
+            std::pair<size_t, size_t> span{y_lo, y_hi};
+            // Stretch toward the previous column so steep changes stay connected
+            if (prev) {
+                y_lo = std::min(y_lo, prev->second);
+                y_hi = std::max(y_hi, prev->first);
+            }
+            prev = span;
+
+            size_t x = x0 + c;
+            for (size_t y = y_lo; y <= y_hi; y++) {
+                size_t from_top = dots_y - 1 - y;
+                grid[(from_top / 4) * cells + x / 2] |= dot_bits[x % 2][from_top % 4];
+            }
+        }
+
+        std::string view;
+        if (!m.title.empty()) {
+            view += Style().foreground(m.title_color).bold().render(m.title) + "\n";
+        }
+
+        Style line_style = Style().foreground(m.line_color);
+        Style axis_style = Style().foreground(m.axis_color);
+        std::string cells_text;
+        for (size_t row = 0; row < rows; row++) {
+            if (m.show_axis) {
+                std::string label;
+                if (row == 0) {
+                    label = top_label;
+                } else if (row == rows - 1) {
+                    label = bottom_label;
+                }
+                std::string tick = row == 0 || row == rows - 1 ? " ┤" : " │";
+                view += axis_style.render(std::string(axis - 2 - label.size(), ' ') + label + tick);
+            }
+            cells_text.clear();
+            for (size_t x = 0; x < cells; x++) {
+                detail::append_braille(cells_text, grid[row * cells + x]);
+            }
+            view += line_style.render(cells_text);
+            if (row + 1 < rows) {
+                view += "\n";
+            }
+        }
+
+        return view;
+    }
+
+    /// Builder for a one-line sparkline
+    class Sparkline {
+      public:
+        Sparkline &data(const std::vector<double> &values) {
+            m_model.series = Series();
+            m_model.series.append(values.begin(), values.end());
+            return *this;
+        }
+
+        Sparkline &push(double value) {
+            m_model.series.push(value);
+            return *this;
+        }
+
+        Sparkline &width(int w) {
+            m_model.width = w;
+            return *this;
+        }
+
+        Sparkline &window(size_t points) {
+            m_model.window = points;
+            return *this;
+        }
+
+        Sparkline &range(double min, double max) {
+            m_model.min = min;
+            m_model.max = max;
+            return *this;
+        }
+
+        Sparkline &color(int r, int g, int b) {
+            m_model.color = {r, g, b};
+            return *this;
+        }
+
+        std::string render() const { return sparkline_view(m_model); }
+
+        SparklineModel &model() { return m_model; }
+        const SparklineModel &model() const { return m_model; }
+
+      private:
+        SparklineModel m_model;
+    };
+
+    /// Builder for a multi-line Braille chart
+    class Chart {
+      public:
+        Chart &data(const std::vector<double> &values) {
+            m_model.series = Series();
+            m_model.series.append(values.begin(), values.end());
+            return *this;
+        }
+
+        Chart &push(double value) {
+            m_model.series.push(value);
+            return *this;
+        }
+
+        Chart &width(int w) {
+            m_model.width = w;
+            return *this;
+        }
+
+        Chart &height(int h) {
+            m_model.height = h;
+            return *this;
+        }
+
+        Chart &window(size_t points) {
+            m_model.window = points;
+            return *this;
+        }
+
+        Chart &range(double min, double max) {
+            m_model.min = min;
+            m_model.max = max;
+            return *this;
+        }
+
+        Chart &title(const std::string &t) {
+            m_model.title = t;
+            return *this;
+        }
+
+        Chart &axis(bool show = true) {
+            m_model.show_axis = show;
+            return *this;
+        }
+
+        Chart &color(int r, int g, int b) {
+            m_model.line_color = {r, g, b};
+            return *this;
+        }
+
+        std::string render() const { return chart_view(m_model); }
+
+        ChartModel &model() { return m_model; }
+        const ChartModel &model() const { return m_model; }
+
+      private:
+        ChartModel m_model;
+    };
+
+} // namespace scan
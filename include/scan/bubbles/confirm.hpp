@@ -33,11 +33,11 @@ namespace scan {
         bool cancelled = false;
 
         ConfirmModel() {
-            auto &t = current_theme();
-            prompt_color = t.colors.text;
-            selected_fg = t.colors.text_inverted;
-            selected_bg = t.colors.primary;
-            unselected_color = t.colors.text_muted;
+            auto t = theme_snapshot();
+            prompt_color = t->colors.text;
+            selected_fg = t->colors.text_inverted;
+            selected_bg = t->colors.primary;
+            unselected_color = t->colors.text_muted;
         }
     };
 
@@ -0,0 +1,716 @@
+#pragma once
+
+/// @file diffview.hpp
+/// @brief Unified and side-by-side diff viewer, computed in the background
+
+#include <scan/input/key.hpp>
+#include <scan/style/style.hpp>
+#include <scan/tea/cmd.hpp>
+#include <scan/tea/msg.hpp>
+#include <scan/tea/program.hpp>
+#include <scan/tea/task.hpp>
+#include <scan/terminal/terminal.hpp>
+#include <scan/util/diff.hpp>
+#include <scan/util/mapped_file.hpp>
+#include <scan/util/utf8.hpp>
+
+#include <algorithm>
+#include <any>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace scan {
+
+    /// State shared between a DiffView and the background task computing its diff
+    ///
+    /// The task publishes the line tables once both inputs are indexed, then
+    /// appends changes to `pending` as they are found. The view takes them on
+    /// each progress message; `notified` keeps at most one such message queued.
+    struct DiffJob {
+        std::shared_ptr<const MappedFile> a_file;
+        std::shared_ptr<const MappedFile> b_file;
+        std::atomic<bool> cancel{false};
+        std::atomic<bool> notified{false};
+
+        std::mutex mutex;
+        std::shared_ptr<const diff::LineIndex> a;
+        std::shared_ptr<const diff::LineIndex> b;
+        std::vector<diff::Change> pending;
+        bool done = false;
+    };
+
+    /// Progress of a DiffJob, delivered as the value of a tea::TaskMsg
+    struct DiffProgress {
+        const DiffJob *job = nullptr;
+    };
+
+    /// A run of changes shown together, with surrounding context lines
+    struct DiffHunk {
+        size_t first = 0; // Index of the first change in DiffViewModel::changes
+        size_t count = 0;
+        size_t a = 0, a_end = 0; // Lines of the left input covered, context included
+        size_t b = 0, b_end = 0;
+        size_t row = 0; // First display row
+        size_t rows = 0;
+    };
+
+    /// One display row of a hunk
+    struct DiffRow {
+        enum class Kind : uint8_t { Header, Context, Delete, Insert, Pair };
+        Kind kind = Kind::Context;
+        size_t a = diff::npos; // Line on each side, npos if none
+        size_t b = diff::npos;
+        size_t partner = diff::npos; // Line on the other side to compare for intra-line changes
+        const DiffHunk *hunk = nullptr;
+    };
+
+    struct DiffViewModel {
+        std::shared_ptr<const MappedFile> left;
+        std::shared_ptr<const MappedFile> right;
+        std::string left_name = "a";
+        std::string right_name = "b";
+        int id = 0; // Matched against TaskMsg ids
+
+        // Filled in as the background diff progresses
+        std::shared_ptr<DiffJob> job;
+        std::shared_ptr<const diff::LineIndex> a_lines;
+        std::shared_ptr<const diff::LineIndex> b_lines;
+        std::vector<diff::Change> changes;
+        std::vector<DiffHunk> hunks;
+        size_t total_rows = 0;
+        size_t added = 0;
+        size_t removed = 0;
+        bool done = false;
+
+        int context = 3;
+        bool side_by_side = false;
+        size_t offset = 0; // First display row
+        int height = 20;
+        int width = 100;
+        bool show_status = true;
+        std::string message;
+
+        // Styling - uses theme
+        Color header_color;
+        Color context_color;
+        Color delete_color;
+        Color insert_color;
+        Color number_color;
+        Color status_fg;
+        Color status_bg;
+
+        bool quit_requested = false;
+
+        DiffViewModel() {
+            auto t = theme_snapshot();
+            header_color = t->colors.secondary;
+            context_color = t->colors.text;
+            delete_color = t->colors.error;
+            insert_color = t->colors.success;
+            number_color = t->colors.text_subtle;
+            status_fg = t->colors.text;
+            status_bg = t->colors.bg_muted;
+        }
+    };
+
+    /// Diff two in-memory texts
+    inline void diffview_set_texts(DiffViewModel &m, std::string a, std::string b) {
+        m.left = std::make_shared<MappedFile>(MappedFile::from_bytes(std::move(a)));
+        m.right = std::make_shared<MappedFile>(MappedFile::from_bytes(std::move(b)));
+    }
+
+    /// Diff two files; they are memory-mapped, so only compared and displayed pages are read
+    inline void diffview_open(DiffViewModel &m, const std::string &a_path, const std::string &b_path) {
+        auto a = std::make_shared<MappedFile>(MappedFile::open(a_path));
+        auto b = std::make_shared<MappedFile>(MappedFile::open(b_path));
+        if (!a->ok()) {
+            m.message = a->error();
+        } else if (!b->ok()) {
+            m.message = b->error();
+        }
+        m.left = std::move(a);
+        m.right = std::move(b);
+        m.left_name = a_path;
+        m.right_name = b_path;
+    }
+
+    /// Size the view to the terminal, reserving a row for the status bar
+    inline void diffview_init(DiffViewModel &m) {
+        auto [cols, rows] = terminal::get_size();
+        m.width = std::max(20, cols);
+        m.height = std::max(1, std::min(m.height, rows - (m.show_status ? 1 : 0)));
+    }
+
+    /// Rows a change takes in the current layout
+    inline size_t diffview_change_rows(const DiffViewModel &m, const diff::Change &c) {
+        return m.side_by_side ? std::max(c.a_len, c.b_len) : c.a_len + c.b_len;
+    }
+
+    /// Rows a hunk takes in the current layout: a header, context, then each change
+    inline size_t diffview_hunk_rows(const DiffViewModel &m, const DiffHunk &h) {
+        size_t rows = 1;
+        size_t pos = h.a;
+        for (size_t i = h.first; i < h.first + h.count; i++) {
+            const auto &c = m.changes[i];
+            rows += c.a - pos + diffview_change_rows(m, c);
+            pos = c.a + c.a_len;
+        }
+        return rows + (h.a_end - pos);
+    }
+
+    /// Add the next change, extending the last hunk when their context would overlap
+    inline void diffview_add_change(DiffViewModel &m, const diff::Change &c) {
+        size_t na = m.a_lines ? m.a_lines->size() : 0;
+        size_t context = static_cast<size_t>(std::max(0, m.context));
+        m.changes.push_back(c);
+        m.removed += c.a_len;
+        m.added += c.b_len;
+
+        size_t after = std::min(na, c.a + c.a_len + context) - (c.a + c.a_len);
+        if (!m.hunks.empty()) {
+            auto &h = m.hunks.back();
+            const auto &prev = m.changes[h.first + h.count - 1];
+            size_t prev_end = prev.a + prev.a_len;
+            if (c.a - prev_end <= 2 * context) {
+                // The old trailing context becomes the gap before c, so only the new rows are added
+                size_t grow = (c.a - prev_end) + diffview_change_rows(m, c) + after;
+                size_t shrink = h.a_end - prev_end;
+                h.count++;
+                h.a_end = c.a + c.a_len + after;
+                h.b_end = c.b + c.b_len + after;
+                h.rows = h.rows + grow - shrink;
+                m.total_rows = m.total_rows + grow - shrink;
+                return;
+            }
+        }
+
+        DiffHunk h;
+        size_t before = std::min(context, c.a);
+        h.first = m.changes.size() - 1;
+        h.count = 1;
+        h.a = c.a - before;
+        h.b = c.b - before;
+        h.a_end = c.a + c.a_len + after;
+        h.b_end = c.b + c.b_len + after;
+        h.row = m.total_rows;
+        h.rows = diffview_hunk_rows(m, h);
+        m.total_rows += h.rows;
+        m.hunks.push_back(h);
+    }
+
+    /// Recompute row positions after a layout change
+    inline void diffview_relayout(DiffViewModel &m) {
+        m.total_rows = 0;
+        for (auto &h : m.hunks) {
+            h.row = m.total_rows;
+            h.rows = diffview_hunk_rows(m, h);
+            m.total_rows += h.rows;
+        }
+    }
+
+    /// Take everything the background task has found so far
+    inline void diffview_drain(DiffViewModel &m) {
+        if (!m.job) {
+            return;
+        }
+        std::vector<diff::Change> pending;
+        {
+            std::lock_guard<std::mutex> lock(m.job->mutex);
+            m.job->notified = false;
+            if (!m.a_lines) {
+                m.a_lines = m.job->a;
+                m.b_lines = m.job->b;
+            }
+            pending.swap(m.job->pending);
+            m.done = m.job->done;
+        }
+        for (const auto &c : pending) {
+            diffview_add_change(m, c);
+        }
+    }
+
+    /// Start diffing the inputs in the background, replacing any diff in progress
+    ///
+    /// Changes stream in while the task runs: the first hunk shows up as soon as
+    /// it is found, and input stays responsive throughout. With no Program
+    /// running the diff completes synchronously.
+    inline tea::Cmd diffview_start(DiffViewModel &m) {
+        if (m.job) {
+            m.job->cancel = true;
+        }
+        m.a_lines.reset();
+        m.b_lines.reset();
+        m.changes.clear();
+        m.hunks.clear();
+        m.total_rows = 0;
+        m.added = m.removed = 0;
+        m.offset = 0;
+        m.done = false;
+
+        auto job = std::make_shared<DiffJob>();
+        job->a_file = m.left ? m.left : std::make_shared<MappedFile>();
+        job->b_file = m.right ? m.right : std::make_shared<MappedFile>();
+        m.job = job;
+        int id = m.id;
+
+        return tea::async([job, id]() -> std::optional<tea::Msg> {
+            auto a = std::make_shared<const diff::LineIndex>(reinterpret_cast<const char *>(job->a_file->data()),
+                                                             job->a_file->size());
+            auto b = std::make_shared<const diff::LineIndex>(reinterpret_cast<const char *>(job->b_file->data()),
+                                                             job->b_file->size());
+            {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                job->a = a;
+                job->b = b;
+            }
+            job->a_file->advise_sequential(0, job->a_file->size());
+            job->b_file->advise_sequential(0, job->b_file->size());
+
+            diff::lines(
+                *a, *b,
+                [&](const diff::Change &c) {
+                    {
+                        std::lock_guard<std::mutex> lock(job->mutex);
+                        job->pending.push_back(c);
+                    }
+                    if (!job->notified.exchange(true)) {
+                        tea::post(tea::TaskMsg{id, DiffProgress{job.get()}});
+                    }
+                    return true;
+                },
+                &job->cancel);
+
+            {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                job->done = true;
+            }
+            return tea::TaskMsg{id, DiffProgress{job.get()}};
+        }, Priority::Background);
+    }
+
+    /// Index of the hunk containing a display row (hunks must be non-empty)
+    inline size_t diffview_hunk_at(const DiffViewModel &m, size_t row) {
+        auto it = std::upper_bound(m.hunks.begin(), m.hunks.end(), row,
+                                   [](size_t r, const DiffHunk &h) { return r < h.row; });
+        return it == m.hunks.begin() ? 0 : static_cast<size_t>(it - m.hunks.begin() - 1);
+    }
+
+    /// Append up to count rows of a hunk, starting at its local row `from`
+    ///
+    /// Whole runs of context and changes before `from` are skipped arithmetically,
+    /// so reaching the middle of a huge hunk costs one step per change.
+    inline void diffview_hunk_rows_at(const DiffViewModel &m, const DiffHunk &h, size_t from, size_t count,
+                                      std::vector<DiffRow> &out) {
+        constexpr size_t none = diff::npos;
+        size_t row = 0;
+        auto emit = [&](DiffRow r) {
+            if (row >= from && count > 0) {
+                r.hunk = &h;
+                out.push_back(r);
+                count--;
+            }
+            row++;
+        };
+        // Emit rows [0, len) of a run, skipping those before `from` without visiting them
+        auto run = [&](size_t len, auto make) {
+            size_t skip = from > row ? std::min(len, from - row) : 0;
+            row += skip;
+            for (size_t i = skip; i < len && count > 0; i++) {
+                emit(make(i));
+            }
+            if (count == 0) {
+                row += len; // Past the end of what we need; exact value no longer matters
+            }
+        };
+
+        emit({DiffRow::Kind::Header, h.a, h.b, none, nullptr});
+        size_t a = h.a, b = h.b;
+        for (size_t i = h.first; i < h.first + h.count && count > 0; i++) {
+            const auto &c = m.changes[i];
+            run(c.a - a, [&](size_t k) { return DiffRow{DiffRow::Kind::Context, a + k, b + k, none, nullptr}; });
+            if (m.side_by_side) {
+                run(std::max(c.a_len, c.b_len), [&](size_t k) {
+                    return DiffRow{DiffRow::Kind::Pair, k < c.a_len ? c.a + k : none, k < c.b_len ? c.b + k : none,
+                                   none, nullptr};
+                });
+            } else {
+                run(c.a_len, [&](size_t k) {
+                    return DiffRow{DiffRow::Kind::Delete, c.a + k, none, k < c.b_len ? c.b + k : none, nullptr};
+                });
+                run(c.b_len, [&](size_t k) {
+                    return DiffRow{DiffRow::Kind::Insert, none, c.b + k, k < c.a_len ? c.a + k : none, nullptr};
+                });
+            }
+            a = c.a + c.a_len;
+            b = c.b + c.b_len;
+        }
+        run(h.a_end - a, [&](size_t k) { return DiffRow{DiffRow::Kind::Context, a + k, b + k, none, nullptr}; });
+    }
+
+    /// The display rows currently on screen
+    inline std::vector<DiffRow> diffview_visible_rows(const DiffViewModel &m) {
+        std::vector<DiffRow> rows;
+        size_t want = static_cast<size_t>(std::max(1, m.height));
+        if (m.hunks.empty() || m.offset >= m.total_rows) {
+            return rows;
+        }
+        for (size_t i = diffview_hunk_at(m, m.offset); i < m.hunks.size() && rows.size() < want; i++) {
+            const auto &h = m.hunks[i];
+            size_t from = m.offset > h.row ? m.offset - h.row : 0;
+            diffview_hunk_rows_at(m, h, from, want - rows.size(), rows);
+        }
+        return rows;
+    }
+
+    namespace detail {
+        /// Append text sanitized for the terminal, stopping after `cols` columns (decremented)
+        inline void diff_clip(std::string_view text, size_t &cols, std::string &out) {
+            size_t i = 0;
+            while (i < text.size() && cols > 0) {
+                unsigned char c = static_cast<unsigned char>(text[i]);
+                if (c == '\t') {
+                    size_t n = std::min<size_t>(4, cols);
+                    out.append(n, ' ');
+                    cols -= n;
+                    i++;
+                } else if (c < 0x20 || c == 0x7f) {
+                    i++; // Drop \r and other control characters
+                } else if (c < 0x80) {
+                    out += static_cast<char>(c);
+                    cols--;
+                    i++;
+                } else {
+                    size_t len = std::min(static_cast<size_t>(utf8::char_length(c)), text.size() - i);
+                    std::string ch(text.substr(i, len));
+                    size_t w = utf8::display_width(ch);
+                    if (w > cols) {
+                        break;
+                    }
+                    out += ch;
+                    cols -= w;
+                    i += len;
+                }
+            }
+        }
+    } // namespace detail
+
+    /// Render one line of input in `cols` columns, highlighting what differs from its partner
+    inline std::string diffview_render_text(std::string_view text, std::string_view partner, bool has_partner,
+                                            size_t cols, const Style &base, const Style &highlight, bool pad) {
+        size_t begin = text.size(), end = text.size();
+        if (has_partner) {
+            auto r = diff::inline_changes(text, partner);
+            begin = r.a_begin;
+            end = r.a_end;
+        }
+        std::string out;
+        std::string part;
+        detail::diff_clip(text.substr(0, begin), cols, part);
+        out += base.render(part);
+        if (end > begin && cols > 0) {
+            part.clear();
+            detail::diff_clip(text.substr(begin, end - begin), cols, part);
+            out += highlight.render(part);
+        }
+        if (end < text.size() && cols > 0) {
+            part.clear();
+            detail::diff_clip(text.substr(end), cols, part);
+            out += base.render(part);
+        }
+        if (pad && cols > 0) {
+            out.append(cols, ' ');
+        }
+        return out;
+    }
+
+    inline std::pair<DiffViewModel, tea::Cmd> diffview_update(DiffViewModel m, const tea::Msg &msg) {
+        if (auto *task = tea::try_as<tea::TaskMsg>(msg)) {
+            auto *progress = std::any_cast<DiffProgress>(&task->value);
+            if (task->id == m.id && progress && progress->job == m.job.get()) {
+                diffview_drain(m);
+            }
+            return {std::move(m), tea::none()};
+        }
+
+        if (auto *size = tea::try_as<tea::WindowSizeMsg>(msg)) {
+            m.width = std::max(20, size->width);
+            m.height = std::max(1, size->height - (m.show_status ? 1 : 0));
+            return {std::move(m), tea::none()};
+        }
+
+        auto *key = tea::try_as<tea::KeyMsg>(msg);
+        if (!key) {
+            return {std::move(m), tea::none()};
+        }
+
+        size_t page = static_cast<size_t>(std::max(1, m.height));
+        size_t max_offset = m.total_rows > page ? m.total_rows - page : 0;
+        auto scroll_to = [&](size_t row) { m.offset = std::min(row, max_offset); };
+
+        switch (key->key) {
+        case input::Key::CtrlC:
+        case input::Key::Escape:
+            m.quit_requested = true;
+            return {std::move(m), tea::quit()};
+        case input::Key::Up:
+            scroll_to(m.offset > 0 ? m.offset - 1 : 0);
+            break;
+        case input::Key::Down:
+            scroll_to(m.offset + 1);
+            break;
+        case input::Key::PageUp:
+            scroll_to(m.offset > page ? m.offset - page : 0);
+            break;
+        case input::Key::PageDown:
+        case input::Key::Space:
+            scroll_to(m.offset + page);
+            break;
+        case input::Key::Home:
+            scroll_to(0);
+            break;
+        case input::Key::End:
+            scroll_to(max_offset);
+            break;
+        case input::Key::Rune:
+            switch (key->rune) {
+            case 'q':
+            case 'Q':
+                m.quit_requested = true;
+                return {std::move(m), tea::quit()};
+            case 'k':
+                scroll_to(m.offset > 0 ? m.offset - 1 : 0);
+                break;
+            case 'j':
+                scroll_to(m.offset + 1);
+                break;
+            case 'g':
+                scroll_to(0);
+                break;
+            case 'G':
+                scroll_to(max_offset);
+                break;
+            case 'n':
+            case ']':
+                if (!m.hunks.empty()) {
+                    size_t i = diffview_hunk_at(m, m.offset);
+                    if (m.hunks[i].row <= m.offset && i + 1 < m.hunks.size()) {
+                        i++;
+                    }
+                    scroll_to(m.hunks[i].row);
+                }
+                break;
+            case 'p':
+            case '[':
+                if (!m.hunks.empty()) {
+                    size_t i = diffview_hunk_at(m, m.offset);
+                    if (m.hunks[i].row == m.offset && i > 0) {
+                        i--;
+                    }
+                    scroll_to(m.hunks[i].row);
+                }
+                break;
+            case 's': {
+                // Keep the hunk at the top of the screen in place across the layout change
+                size_t hunk = m.hunks.empty() ? 0 : diffview_hunk_at(m, m.offset);
+                m.side_by_side = !m.side_by_side;
+                diffview_relayout(m);
+                size_t rows = m.total_rows;
+                m.offset = m.hunks.empty() ? 0 : std::min(m.hunks[hunk].row, rows > page ? rows - page : 0);
+                break;
+            }
+            default:
+                break;
+            }
+            break;
+        default:
+            break;
+        }
+        return {std::move(m), tea::none()};
+    }
+
+    inline std::string diffview_view(const DiffViewModel &m) {
+        std::string view;
+        size_t height = static_cast<size_t>(std::max(1, m.height));
+        size_t width = static_cast<size_t>(std::max(20, m.width));
+        auto rows = diffview_visible_rows(m);
+
+        size_t max_line = std::max(m.a_lines ? m.a_lines->size() : 0, m.b_lines ? m.b_lines->size() : 0);
+        size_t digits = 1;
+        for (size_t n = max_line; n >= 10; n /= 10) {
+            digits++;
+        }
+
+        Style numbers = Style().foreground(m.number_color);
+        Style context = Style().foreground(m.context_color);
+        Style del = Style().foreground(m.delete_color);
+        Style ins = Style().foreground(m.insert_color);
+        Style del_hl = Style().foreground(m.delete_color).reverse();
+        Style ins_hl = Style().foreground(m.insert_color).reverse();
+
+        auto number = [&](size_t line) {
+            std::string s = line == diff::npos ? "" : std::to_string(line + 1);
+            return numbers.render(std::string(digits - std::min(digits, s.size()), ' ') + s);
+        };
+        auto line_a = [&](size_t i) { return (*m.a_lines)[i]; };
+        auto line_b = [&](size_t i) { return (*m.b_lines)[i]; };
+
+        for (size_t r = 0; r < height; r++) {
+            if (r < rows.size()) {
+                const auto &row = rows[r];
+                switch (row.kind) {
+                case DiffRow::Kind::Header: {
+                    const auto &h = *row.hunk;
+                    char buf[96];
+                    std::snprintf(buf, sizeof(buf), "@@ -%zu,%zu +%zu,%zu @@", h.a + 1, h.a_end - h.a, h.b + 1,
+                                  h.b_end - h.b);
+                    view += Style().foreground(m.header_color).bold().render(buf);
+                    break;
+                }
+                case DiffRow::Kind::Context:
+                    if (m.side_by_side) {
+                        size_t half = (width - 3) / 2;
+                        size_t text_cols = half > digits + 1 ? half - digits - 1 : 0;
+                        view += number(row.a) + " " +
+                                diffview_render_text(line_a(row.a), {}, false, text_cols, context, context, true);
+                        view += numbers.render(" │ ") + number(row.b) + " " +
+                                diffview_render_text(line_b(row.b), {}, false, text_cols, context, context, false);
+                    } else {
+                        size_t text_cols = width > 2 * digits + 4 ? width - 2 * digits - 4 : 0;
+                        view += number(row.a) + " " + number(row.b) + "  " +
+                                diffview_render_text(line_a(row.a), {}, false, text_cols, context, context, false);
+                    }
+                    break;
+                case DiffRow::Kind::Delete:
+                case DiffRow::Kind::Insert: {
+                    bool is_del = row.kind == DiffRow::Kind::Delete;
+                    size_t text_cols = width > 2 * digits + 4 ? width - 2 * digits - 4 : 0;
+                    std::string_view text = is_del ? line_a(row.a) : line_b(row.b);
+                    std::string_view partner;
+                    bool has_partner = row.partner != diff::npos;
+                    if (has_partner) {
+                        partner = is_del ? line_b(row.partner) : line_a(row.partner);
+                    }
+                    view += number(row.a) + " " + number(row.b) + " ";
+                    view += is_del ? del.render("-") : ins.render("+");
+                    view += diffview_render_text(text, partner, has_partner, text_cols, is_del ? del : ins,
+                                                 is_del ? del_hl : ins_hl, false);
+                    break;
+                }
+                case DiffRow::Kind::Pair: {
+                    size_t half = (width - 3) / 2;
+                    size_t text_cols = half > digits + 1 ? half - digits - 1 : 0;
+                    bool both = row.a != diff::npos && row.b != diff::npos;
+                    view += number(row.a) + " ";
+                    if (row.a != diff::npos) {
+                        view += diffview_render_text(line_a(row.a), both ? line_b(row.b) : std::string_view{}, both,
+                                                     text_cols, del, del_hl, true);
+                    } else {
+                        view += std::string(text_cols, ' ');
+                    }
+                    view += numbers.render(" │ ") + number(row.b) + " ";
+                    if (row.b != diff::npos) {
+                        view += diffview_render_text(line_b(row.b), both ? line_a(row.a) : std::string_view{}, both,
+                                                     text_cols, ins, ins_hl, false);
+                    }
+                    break;
+                }
+                }
+            } else if (r == 0) {
+                std::string note = !m.message.empty()     ? m.message
+                                   : !m.done              ? "(comparing...)"
+                                   : m.hunks.empty()      ? "(no differences)"
+                                                          : "";
+                view += Style().foreground(m.number_color).italic().render(note);
+            }
+            if (r + 1 < height) {
+                view += "\n";
+            }
+        }
+
+        if (m.show_status) {
+            std::string left = " " + m.left_name + " → " + m.right_name + " ";
+            char stats[128];
+            std::snprintf(stats, sizeof(stats), " %zu hunk%s  +%zu -%zu%s ", m.hunks.size(),
+                          m.hunks.size() == 1 ? "" : "s", m.added, m.removed, m.done ? "" : "  comparing...");
+            std::string right = stats;
+            int pad = static_cast<int>(width) - static_cast<int>(visible_width(left) + visible_width(right));
+            view += "\n";
+            view += Style().foreground(m.status_fg).background(m.status_bg).bold().render(left);
+            view += Style().foreground(m.number_color).background(m.status_bg).render(
+                std::string(static_cast<size_t>(std::max(0, pad)), ' ') + right);
+        }
+
+        return view;
+    }
+
+    class DiffView {
+      public:
+        /// Compare two files
+        DiffView &files(const std::string &a, const std::string &b) {
+            diffview_open(m_model, a, b);
+            return *this;
+        }
+
+        /// Compare two in-memory texts
+        DiffView &texts(std::string a, std::string b) {
+            diffview_set_texts(m_model, std::move(a), std::move(b));
+            return *this;
+        }
+
+        /// Labels shown in the status bar
+        DiffView &names(const std::string &a, const std::string &b) {
+            m_model.left_name = a;
+            m_model.right_name = b;
+            return *this;
+        }
+
+        DiffView &context(int lines) {
+            m_model.context = std::max(0, lines);
+            return *this;
+        }
+
+        DiffView &side_by_side(bool enable = true) {
+            m_model.side_by_side = enable;
+            return *this;
+        }
+
+        DiffView &height(int h) {
+            m_model.height = h;
+            return *this;
+        }
+
+        DiffView &alt_screen(bool enable = true) {
+            m_alt_screen = enable;
+            return *this;
+        }
+
+        void run() {
+            diffview_init(m_model);
+
+            auto init = [this]() -> std::pair<DiffViewModel, tea::Cmd> {
+                auto cmd = diffview_start(m_model);
+                return {m_model, cmd};
+            };
+            auto update = [](DiffViewModel m, tea::Msg msg) { return diffview_update(std::move(m), msg); };
+            auto view = [](const DiffViewModel &m) { return diffview_view(m); };
+
+            auto final_model = tea::Program<DiffViewModel>(init, update, view).with_alt_screen(m_alt_screen).run();
+            if (final_model.job) {
+                final_model.job->cancel = true;
+            }
+        }
+
+        DiffViewModel &model() { return m_model; }
+        const DiffViewModel &model() const { return m_model; }
+
+      private:
+        DiffViewModel m_model;
+        bool m_alt_screen = false;
+    };
+
+} // namespace scan
@@ -0,0 +1,357 @@
+#pragma once
+
+/// @file execview.hpp
+/// @brief Runs an external command and streams its output into a scrollable view
+
+#include <scan/bubbles/viewport.hpp>
+#include <scan/input/key.hpp>
+#include <scan/style/style.hpp>
+#include <scan/tea/cmd.hpp>
+#include <scan/tea/exec.hpp>
+#include <scan/tea/msg.hpp>
+#include <scan/tea/program.hpp>
+#include <scan/terminal/terminal.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace scan {
+
+    struct ExecViewModel {
+        std::vector<std::string> command;
+        int id = 0;
+        tea::ExecOptions options;
+        ViewportModel viewport;
+        std::string title;
+        size_t max_lines = 10000;      // Oldest lines are dropped beyond this
+        size_t max_partial = 64 * 1024; // A line without a newline is broken after this many bytes
+        bool follow = true;       // Keep the newest output in view
+        bool show_status = true;
+        bool quit_on_exit = false;
+
+        // Incomplete trailing line of stdout / stderr
+        std::string partial[2];
+
+        // Process state
+        bool running = false;
+        bool exited = false;
+        bool cancelled = false;
+        int exit_code = 0;
+        int signal = 0;
+        std::string error;
+        size_t bytes_received = 0;
+        size_t lines_dropped = 0;
+
+        // Styling - uses theme
+        Color title_color;
+        Color status_fg;
+        Color status_bg;
+        Color success_color;
+        Color error_color;
+        Color muted_color;
+
+        ExecViewModel() {
+            auto t = theme_snapshot();
+            title_color = t->colors.primary;
+            status_fg = t->colors.text;
+            status_bg = t->colors.bg_muted;
+            success_color = t->colors.success;
+            error_color = t->colors.error;
+            muted_color = t->colors.text_muted;
+        }
+    };
+
+    /// Size the view to the terminal, reserving rows for title and status bar
+    inline void execview_init(ExecViewModel &m) {
+        auto [cols, rows] = terminal::get_size();
+        m.viewport.width = cols;
+        int reserved = 0;
+        if (!m.title.empty())
+            reserved += 1;
+        if (m.show_status)
+            reserved += 1;
+        m.viewport.height = std::max(1, std::min(m.viewport.height, rows - reserved));
+    }
+
+    /// Start the command; output arrives through execview_update
+    inline tea::Cmd execview_start(ExecViewModel &m) {
+        m.running = true;
+        m.exited = false;
+        return tea::exec(m.command, m.id, m.options);
+    }
+
+    /// Add a completed line, honouring carriage returns the way a terminal would
+    inline void execview_push_line(ExecViewModel &m, std::string_view line) {
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        auto cr = line.rfind('\r');
+        if (cr != std::string_view::npos) {
+            line.remove_prefix(cr + 1);
+        }
+        viewport_append_line(m.viewport, line);
+    }
+
+    /// Buffer the unterminated tail of a chunk, keeping it bounded
+    ///
+    /// A progress bar redraws its line with `\r` and never ends it, so only the text after the
+    /// last `\r` is kept (a trailing `\r` stays, it may be the first half of `\r\n`). Output with no
+    /// newlines at all, such as binary data, is broken into lines of max_partial bytes.
+    inline void execview_append_partial(ExecViewModel &m, std::string &partial, std::string_view tail) {
+        // Only the new bytes and a trailing \r left from before can hold the last \r
+        size_t from = partial.empty() ? 0 : partial.size() - 1;
+        partial.append(tail);
+        auto cr = std::string_view(partial).substr(from, partial.size() - 1 - from).rfind('\r');
+        if (cr != std::string_view::npos) {
+            partial.erase(0, from + cr + 1);
+        }
+
+        if (m.max_partial == 0) {
+            return;
+        }
+        size_t flushed = 0;
+        while (partial.size() - flushed >= m.max_partial) {
+            execview_push_line(m, std::string_view(partial).substr(flushed, m.max_partial));
+            flushed += m.max_partial;
+        }
+        partial.erase(0, flushed);
+    }
+
+    /// Append a chunk of raw output, splitting it into lines and enforcing max_lines
+    inline void execview_append(ExecViewModel &m, std::string_view data, bool from_stderr = false) {
+        std::string &partial = m.partial[from_stderr ? 1 : 0];
+        m.bytes_received += data.size();
+
+        size_t start = 0;
+        while (start < data.size()) {
+            size_t nl = data.find('\n', start);
+            if (nl == std::string_view::npos) {
+                execview_append_partial(m, partial, data.substr(start));
+                break;
+            }
+            if (partial.empty()) {
+                execview_push_line(m, data.substr(start, nl - start));
+            } else {
+                partial.append(data.substr(start, nl - start));
+                execview_push_line(m, partial);
+                partial.clear();
+            }
+            start = nl + 1;
+        }
+
+        // Trim in batches so dropping old lines stays amortized O(1) per line
+        size_t slack = std::max<size_t>(64, m.max_lines / 4);
+        if (m.max_lines > 0 && m.viewport.lines.size() > m.max_lines + slack) {
+            size_t excess = m.viewport.lines.size() - m.max_lines;
+            viewport_drop_front(m.viewport, excess);
+            m.lines_dropped += excess;
+        }
+
+        if (m.follow) {
+            viewport_goto_bottom(m.viewport);
+        }
+    }
+
+    inline std::pair<ExecViewModel, tea::Cmd> execview_update(ExecViewModel m, const tea::Msg &msg) {
+        if (auto *out = tea::try_as<tea::ExecOutputMsg>(msg)) {
+            if (out->id == m.id) {
+                execview_append(m, out->data, out->from_stderr);
+            }
+            return {std::move(m), tea::none()};
+        }
+
+        if (auto *done = tea::try_as<tea::ExecExitMsg>(msg)) {
+            if (done->id != m.id) {
+                return {std::move(m), tea::none()};
+            }
+            for (auto &partial : m.partial) {
+                if (!partial.empty()) {
+                    execview_push_line(m, partial);
+                    partial.clear();
+                }
+            }
+            if (m.follow) {
+                viewport_goto_bottom(m.viewport);
+            }
+            m.running = false;
+            m.exited = true;
+            m.exit_code = done->exit_code;
+            m.signal = done->signal;
+            m.error = done->error;
+            if (m.quit_on_exit) {
+                return {std::move(m), tea::quit()};
+            }
+            return {std::move(m), tea::none()};
+        }
+
+        if (auto *key = tea::try_as<tea::KeyMsg>(msg)) {
+            bool quit = key->key == input::Key::Escape || key->key == input::Key::CtrlC ||
+                        (key->key == input::Key::Rune && (key->rune == 'q' || key->rune == 'Q'));
+            if (quit) {
+                m.cancelled = m.running;
+                return {std::move(m), tea::quit()};
+            }
+
+            auto [new_viewport, cmd] = viewport_update(std::move(m.viewport), msg);
+            m.viewport = std::move(new_viewport);
+            // Scrolling away from the bottom pauses follow; returning to it resumes
+            m.follow = viewport_at_bottom(m.viewport);
+            return {std::move(m), cmd};
+        }
+
+        return {std::move(m), tea::none()};
+    }
+
+    /// Human-readable byte count for the status bar
+    inline std::string execview_format_bytes(size_t bytes) {
+        const char *units[] = {"B", "KB", "MB", "GB"};
+        double v = static_cast<double>(bytes);
+        int u = 0;
+        while (v >= 1024.0 && u < 3) {
+            v /= 1024.0;
+            u++;
+        }
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), u == 0 ? "%.0f %s" : "%.1f %s", v, units[u]);
+        return buf;
+    }
+
+    inline std::string execview_view(const ExecViewModel &m) {
+        std::string view;
+
+        if (!m.title.empty()) {
+            view += Style().foreground(m.title_color).bold().render(m.title);
+            view += "\n";
+        }
+
+        view += viewport_view(m.viewport);
+
+        if (m.show_status) {
+            view += "\n";
+
+            std::string state;
+            Color state_color = m.status_fg;
+            if (!m.error.empty()) {
+                state = "error: " + m.error;
+                state_color = m.error_color;
+            } else if (m.running) {
+                state = "running";
+            } else if (m.exited && m.signal != 0) {
+                state = "killed by signal " + std::to_string(m.signal);
+                state_color = m.error_color;
+            } else if (m.exited) {
+                state = "exit " + std::to_string(m.exit_code);
+                state_color = m.exit_code == 0 ? m.success_color : m.error_color;
+            } else {
+                state = "idle";
+            }
+
+            std::string info = std::to_string(m.lines_dropped + m.viewport.lines.size()) + " lines, " +
+                               execview_format_bytes(m.bytes_received);
+            if (!m.follow) {
+                info += ", paused";
+            }
+
+            std::string left = " " + state + " ";
+            std::string right = " " + info + " ";
+            int pad = m.viewport.width - static_cast<int>(visible_width(left) + visible_width(right));
+
+            view += Style().foreground(state_color).background(m.status_bg).bold().render(left);
+            view += Style().foreground(m.muted_color).background(m.status_bg).render(
+                std::string(static_cast<size_t>(std::max(0, pad)), ' ') + right);
+        }
+
+        return view;
+    }
+
+    class ExecView {
+      public:
+        ExecView &command(const std::vector<std::string> &argv) {
+            m_model.command = argv;
+            return *this;
+        }
+
+        ExecView &title(const std::string &t) {
+            m_model.title = t;
+            return *this;
+        }
+
+        ExecView &width(int w) {
+            m_model.viewport.width = w;
+            return *this;
+        }
+
+        ExecView &height(int h) {
+            m_model.viewport.height = h;
+            return *this;
+        }
+
+        ExecView &max_lines(size_t n) {
+            m_model.max_lines = n;
+            return *this;
+        }
+
+        ExecView &wrap(bool enable) {
+            m_model.viewport.wrap = enable;
+            return *this;
+        }
+
+        ExecView &follow(bool enable = true) {
+            m_model.follow = enable;
+            return *this;
+        }
+
+        ExecView &merge_stderr(bool enable = true) {
+            m_model.options.merge_stderr = enable;
+            return *this;
+        }
+
+        ExecView &status_bar(bool show = true) {
+            m_model.show_status = show;
+            return *this;
+        }
+
+        ExecView &quit_on_exit(bool enable = true) {
+            m_model.quit_on_exit = enable;
+            return *this;
+        }
+
+        ExecView &alt_screen(bool enable = true) {
+            m_alt_screen = enable;
+            return *this;
+        }
+
+        /// Run the command, returning its exit code (128 + signal if killed),
+        /// or nullopt if it could not be started or the view was closed while it was running
+        std::optional<int> run() {
+            execview_init(m_model);
+
+            auto init = [this]() -> std::pair<ExecViewModel, tea::Cmd> {
+                ExecViewModel m = m_model;
+                auto cmd = execview_start(m);
+                return {std::move(m), cmd};
+            };
+            auto update = [](ExecViewModel m, tea::Msg msg) { return execview_update(std::move(m), msg); };
+            auto view = [](const ExecViewModel &m) { return execview_view(m); };
+
+            auto final_model = tea::Program<ExecViewModel>(init, update, view).with_alt_screen(m_alt_screen).run();
+
+            if (final_model.cancelled || !final_model.exited || !final_model.error.empty()) {
+                return std::nullopt;
+            }
+            return final_model.signal != 0 ? 128 + final_model.signal : final_model.exit_code;
+        }
+
+        ExecViewModel &model() { return m_model; }
+        const ExecViewModel &model() const { return m_model; }
+
+      private:
+        ExecViewModel m_model;
+        bool m_alt_screen = false;
+    };
+
+} // namespace scan
@@ -54,14 +54,14 @@ namespace scan {
         bool cancelled = false;
 
         FilePickerModel() {
-            auto &t = current_theme();
-            dir_color = t.colors.secondary;
-            file_color = t.colors.text;
+            auto t = theme_snapshot();
+            dir_color = t->colors.secondary;
+            file_color = t->colors.text;
             symlink_color = {0, 255, 255};
-            cursor_color = t.colors.primary;
-            hidden_color = t.colors.text_subtle;
-            path_color = t.colors.primary;
-            muted_color = t.colors.text_muted;
+            cursor_color = t->colors.primary;
+            hidden_color = t->colors.text_subtle;
+            path_color = t->colors.primary;
+            muted_color = t->colors.text_muted;
         }
     };
 
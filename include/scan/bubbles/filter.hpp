@@ -15,6 +15,7 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace scan {
@@ -23,6 +24,7 @@ namespace scan {
     struct FilterModel {
         std::vector<std::string> items;
         std::vector<size_t> filtered;
+        std::vector<int> scores; // Match score of each filtered item, kept for merging streamed items
         std::set<size_t> selected;
         std::string query;
         size_t cursor = 0;
@@ -45,23 +47,102 @@ namespace scan {
         Color selected_color;
         Color muted_color;
 
+        // Streaming: items arrive as LogMsg batches with this id
+        int id = 0;
+        bool loading = false; // More items may still arrive
+
         // State
         bool submitted = false;
         bool cancelled = false;
 
         FilterModel() {
-            auto &t = current_theme();
-            prompt_color = t.colors.primary;
-            text_color = t.colors.text;
-            match_color = t.colors.match_highlight;
-            cursor_color = t.colors.primary;
-            selected_color = t.colors.success;
-            muted_color = t.colors.text_muted;
+            auto t = theme_snapshot();
+            prompt_color = t->colors.primary;
+            text_color = t->colors.text;
+            match_color = t->colors.match_highlight;
+            cursor_color = t->colors.primary;
+            selected_color = t->colors.success;
+            muted_color = t->colors.text_muted;
         }
     };
 
+    /// Re-run the query over all items and move the cursor to the best match
+    inline void filter_refresh(FilterModel &m) {
+        m.filtered.clear();
+        m.scores.clear();
+        if (m.query.empty()) {
+            m.filtered.reserve(m.items.size());
+            for (size_t i = 0; i < m.items.size(); i++) {
+                m.filtered.push_back(i);
+            }
+            m.scores.assign(m.items.size(), 0);
+        } else {
+            for (const auto &[idx, score] : fuzzy::filter_scored(m.items, m.query, m.case_sensitive)) {
+                m.filtered.push_back(idx);
+                m.scores.push_back(score);
+            }
+        }
+        m.cursor = 0;
+        m.offset = 0;
+    }
+
+    /// Append newline-separated items, matching only the new ones against the query
+    ///
+    /// New matches are merged into the ranked results by score, after existing
+    /// items of equal score, so the list keeps its order as input streams in.
+    inline void filter_append(FilterModel &m, std::string_view text) {
+        size_t first = m.items.size();
+        tea::for_each_line(text, [&](std::string_view line) { m.items.emplace_back(line); });
+
+        if (m.scores.size() != m.filtered.size()) {
+            // Results were set without scores; rank everything once
+            size_t cursor = m.cursor, offset = m.offset;
+            filter_refresh(m);
+            m.cursor = std::min(cursor, m.filtered.empty() ? 0 : m.filtered.size() - 1);
+            m.offset = std::min(offset, m.cursor);
+            return;
+        }
+
+        if (m.query.empty()) {
+            for (size_t i = first; i < m.items.size(); i++) {
+                m.filtered.push_back(i);
+                m.scores.push_back(0);
+            }
+            return;
+        }
+
+        auto added = fuzzy::filter_scored(m.items, m.query, m.case_sensitive, first);
+        if (added.empty()) {
+            return;
+        }
+        std::vector<size_t> filtered;
+        std::vector<int> scores;
+        filtered.reserve(m.filtered.size() + added.size());
+        scores.reserve(filtered.capacity());
+        size_t i = 0, j = 0;
+        while (i < m.filtered.size() || j < added.size()) {
+            if (j == added.size() || (i < m.filtered.size() && m.scores[i] >= added[j].second)) {
+                filtered.push_back(m.filtered[i]);
+                scores.push_back(m.scores[i++]);
+            } else {
+                filtered.push_back(added[j].first);
+                scores.push_back(added[j++].second);
+            }
+        }
+        m.filtered = std::move(filtered);
+        m.scores = std::move(scores);
+    }
+
     /// Update function for Filter
     inline std::pair<FilterModel, tea::Cmd> filter_update(FilterModel m, const tea::Msg &msg) {
+        if (auto *items = tea::try_as<tea::LogMsg>(msg)) {
+            if (items->id == m.id) {
+                filter_append(m, items->text);
+                m.loading = !items->done;
+            }
+            return {std::move(m), tea::none()};
+        }
+
         if (auto *key = tea::try_as<tea::KeyMsg>(msg)) {
             switch (key->key) {
             case input::Key::Enter:
@@ -114,26 +195,20 @@ namespace scan {
             case input::Key::CtrlH:
                 if (!m.query.empty()) {
                     m.query = utf8::erase(m.query, utf8::length(m.query) - 1, 1);
-                    m.filtered = fuzzy::filter(m.items, m.query, m.case_sensitive);
-                    m.cursor = 0;
-                    m.offset = 0;
+                    filter_refresh(m);
                 }
                 break;
 
             case input::Key::CtrlU:
                 m.query.clear();
-                m.filtered = fuzzy::filter(m.items, m.query, m.case_sensitive);
-                m.cursor = 0;
-                m.offset = 0;
+                filter_refresh(m);
                 break;
 
             case input::Key::Space:
             case input::Key::Rune: {
                 std::string ch = utf8::encode(key->rune);
                 m.query += ch;
-                m.filtered = fuzzy::filter(m.items, m.query, m.case_sensitive);
-                m.cursor = 0;
-                m.offset = 0;
+                filter_refresh(m);
             } break;
 
             default:
@@ -188,10 +263,13 @@ namespace scan {
 
         // Results count
         std::string count_str = std::to_string(m.filtered.size()) + "/" + std::to_string(m.items.size());
+        if (m.loading) {
+            count_str += " …";
+        }
         view += Style().foreground(m.muted_color).faint().render("  " + count_str) + "\n\n";
 
         if (m.filtered.empty()) {
-            view += Style().foreground(m.muted_color).italic().render("  No matches");
+            view += Style().foreground(m.muted_color).italic().render(m.loading ? "  Loading..." : "  No matches");
             return view;
         }
 
@@ -252,7 +330,7 @@ namespace scan {
       public:
         Filter &items(const std::vector<std::string> &items) {
             m_model.items = items;
-            m_model.filtered = fuzzy::filter(items, "", false);
+            filter_refresh(m_model);
             return *this;
         }
 
@@ -268,7 +346,7 @@ namespace scan {
 
         Filter &query(const std::string &text) {
             m_model.query = text;
-            m_model.filtered = fuzzy::filter(m_model.items, text, m_model.case_sensitive);
+            filter_refresh(m_model);
             return *this;
         }
 
@@ -0,0 +1,118 @@
+#pragma once
+
+/// @file form.hpp
+/// @brief Multi-field form: several components in one Program with Tab focus
+
+#include <scan/bubbles/confirm.hpp>
+#include <scan/bubbles/list.hpp>
+#include <scan/bubbles/textinput.hpp>
+#include <scan/style/style.hpp>
+#include <scan/tea/compose.hpp>
+#include <scan/tea/program.hpp>
+
+#include <optional>
+#include <string>
+
+namespace scan {
+
+    /// Form builder
+    ///
+    /// All fields live in a single Program: one raw-mode session, keys routed to
+    /// the focused field only, and only fields that changed are re-rendered.
+    /// Enter moves to the next field (submitting after the last), Tab / Shift+Tab
+    /// move freely, Escape cancels.
+    class Form {
+      public:
+        Form &title(const std::string &text) {
+            return this->text(Style().foreground(theme_snapshot()->colors.primary).bold().render(text));
+        }
+
+        /// Static text between fields
+        Form &text(const std::string &text) {
+            tea::composite_add(m_model, "", tea::Component::text(text));
+            return *this;
+        }
+
+        Form &input(const std::string &name, const TextInput &input) {
+            tea::composite_add(m_model, name, tea::Component(input.model(), textinput_update, textinput_view));
+            return *this;
+        }
+
+        /// Single-choice list; its value is the item under the cursor
+        Form &list(const std::string &name, const List &list) {
+            ListModel model = list.model();
+            model.limit = 1;
+            tea::composite_add(m_model, name, tea::Component(std::move(model), list_update, list_view));
+            return *this;
+        }
+
+        Form &confirm(const std::string &name, const Confirm &confirm) {
+            tea::composite_add(m_model, name, tea::Component(confirm.model(), confirm_update, confirm_view));
+            return *this;
+        }
+
+        /// Any other component
+        Form &add(const std::string &name, tea::Component component) {
+            tea::composite_add(m_model, name, std::move(component));
+            return *this;
+        }
+
+        /// Show a key help line below the fields
+        Form &help(bool show = true) {
+            m_help = show;
+            return *this;
+        }
+
+        /// Returns true if the form was submitted, false if cancelled
+        bool run() {
+            if (m_help) {
+                text(Style().foreground(theme_snapshot()->colors.text_subtle)
+                         .render("tab/shift+tab: move • enter: next • esc: cancel"));
+                m_help = false;
+            }
+            tea::composite_init(m_model);
+
+            auto init = [this]() -> std::pair<tea::CompositeModel, tea::Cmd> { return {m_model, tea::none()}; };
+            auto update = [](tea::CompositeModel m, tea::Msg msg) { return tea::composite_update(std::move(m), msg); };
+            auto view = [](const tea::CompositeModel &m) { return tea::composite_view(m); };
+
+            m_model = tea::Program<tea::CompositeModel>(init, update, view).run();
+            return m_model.submitted && !m_model.cancelled;
+        }
+
+        /// Value of a field: input text, chosen list item, or "yes"/"no" for a confirm
+        std::optional<std::string> value(const std::string &name) const {
+            const tea::Component *c = m_model.find(name);
+            if (!c) {
+                return std::nullopt;
+            }
+            if (auto *input = c->get<TextInputModel>()) {
+                return input->value;
+            }
+            if (auto *list = c->get<ListModel>()) {
+                if (list->cursor < list->item_count()) {
+                    return list->get_title(list->cursor);
+                }
+                return std::nullopt;
+            }
+            if (auto *confirm = c->get<ConfirmModel>()) {
+                return std::string(confirm->value ? "yes" : "no");
+            }
+            return std::nullopt;
+        }
+
+        /// Model of a field, e.g. `form.get<ConfirmModel>("agree")->value`
+        template <typename Model> const Model *get(const std::string &name) const {
+            const tea::Component *c = m_model.find(name);
+            return c ? c->get<Model>() : nullptr;
+        }
+
+        tea::CompositeModel &model() { return m_model; }
+        const tea::CompositeModel &model() const { return m_model; }
+
+      private:
+        tea::CompositeModel m_model;
+        bool m_help = true;
+    };
+
+} // namespace scan
@@ -0,0 +1,557 @@
+#pragma once
+
+/// @file hexview.hpp
+/// @brief Hex viewer for arbitrarily large files, backed by a memory mapping
+
+#include <scan/input/key.hpp>
+#include <scan/style/style.hpp>
+#include <scan/tea/cmd.hpp>
+#include <scan/tea/msg.hpp>
+#include <scan/tea/program.hpp>
+#include <scan/tea/task.hpp>
+#include <scan/terminal/terminal.hpp>
+#include <scan/util/bytes.hpp>
+#include <scan/util/mapped_file.hpp>
+
+#include <algorithm>
+#include <any>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace scan {
+
+    /// Outcome of a background pattern search, delivered as the value of a tea::TaskMsg
+    struct HexSearchResult {
+        uint64_t generation = 0;
+        size_t offset = bytes::npos;
+        bool wrapped = false;
+    };
+
+    struct HexViewModel {
+        enum class Prompt : uint8_t { None, Goto, Text, Hex };
+
+        // Shared and immutable, so copying the model never copies data
+        std::shared_ptr<const MappedFile> file;
+        int id = 0; // Matched against TaskMsg ids
+
+        size_t cursor = 0; // Selected byte
+        size_t offset = 0; // Byte at the start of the first displayed row
+        int bytes_per_row = 16;
+        int height = 20;
+        std::string title;
+        bool show_status = true;
+
+        // Goto / search prompt
+        Prompt prompt = Prompt::None;
+        std::string input;
+        std::vector<uint8_t> pattern;
+        size_t match = bytes::npos; // Offset of the highlighted match
+        bool searching = false;
+        uint64_t search_generation = 0;
+        CancelToken search_cancel = CancelToken::none();
+        std::string message;
+
+        // Styling - uses theme
+        Color offset_color;
+        Color byte_color;
+        Color zero_color;
+        Color cursor_color;
+        Color match_color;
+        Color title_color;
+        Color status_fg;
+        Color status_bg;
+        Color error_color;
+
+        // State
+        bool submitted = false;
+        bool cancelled = false;
+
+        HexViewModel() {
+            auto t = theme_snapshot();
+            offset_color = t->colors.text_muted;
+            byte_color = t->colors.text;
+            zero_color = t->colors.text_subtle;
+            cursor_color = t->colors.primary;
+            match_color = t->colors.match_highlight;
+            title_color = t->colors.primary;
+            status_fg = t->colors.text;
+            status_bg = t->colors.bg_muted;
+            error_color = t->colors.error;
+        }
+
+        size_t size() const { return file ? file->size() : 0; }
+        const uint8_t *data() const { return file ? file->data() : nullptr; }
+    };
+
+    /// Open a file for viewing; errors are reported in the status line
+    inline void hexview_open(HexViewModel &m, const std::string &path) {
+        auto file = std::make_shared<MappedFile>(MappedFile::open(path));
+        if (!file->ok()) {
+            m.message = file->error();
+        }
+        m.title = m.title.empty() ? path : m.title;
+        m.file = std::move(file);
+        m.cursor = 0;
+        m.offset = 0;
+    }
+
+    /// Size the view to the terminal, reserving rows for title and status bar
+    inline void hexview_init(HexViewModel &m) {
+        auto [cols, rows] = terminal::get_size();
+        (void)cols;
+        int reserved = 0;
+        if (!m.title.empty())
+            reserved += 1;
+        if (m.show_status)
+            reserved += 1;
+        m.height = std::max(1, std::min(m.height, rows - reserved));
+    }
+
+    inline size_t hexview_row_bytes(const HexViewModel &m) { return static_cast<size_t>(std::max(1, m.bytes_per_row)); }
+
+    /// Move the cursor, scrolling so its row stays on screen
+    inline void hexview_goto(HexViewModel &m, size_t pos) {
+        size_t size = m.size();
+        m.cursor = size == 0 ? 0 : std::min(pos, size - 1);
+        size_t row_bytes = hexview_row_bytes(m);
+        size_t rows = static_cast<size_t>(std::max(1, m.height));
+        size_t row = m.cursor / row_bytes;
+        size_t top = m.offset / row_bytes;
+        if (row < top) {
+            top = row;
+        } else if (row >= top + rows) {
+            top = row - rows + 1;
+        }
+        m.offset = top * row_bytes;
+    }
+
+    /// Parse a goto target: decimal, 0x-prefixed hex, or +n / -n relative to the cursor
+    inline std::optional<size_t> hexview_parse_offset(const std::string &text, size_t cursor) {
+        std::string s = text;
+        s.erase(std::remove(s.begin(), s.end(), ' '), s.end());
+        if (s.empty()) {
+            return std::nullopt;
+        }
+        int sign = 0;
+        if (s[0] == '+' || s[0] == '-') {
+            sign = s[0] == '+' ? 1 : -1;
+            s.erase(0, 1);
+        }
+        int base = 10;
+        if (s.size() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+            base = 16;
+            s.erase(0, 2);
+        }
+        if (s.empty()) {
+            return std::nullopt;
+        }
+        size_t value = 0;
+        for (char c : s) {
+            int d;
+            if (c >= '0' && c <= '9') {
+                d = c - '0';
+            } else if (base == 16 && c >= 'a' && c <= 'f') {
+                d = c - 'a' + 10;
+            } else if (base == 16 && c >= 'A' && c <= 'F') {
+                d = c - 'A' + 10;
+            } else {
+                return std::nullopt;
+            }
+            value = value * static_cast<size_t>(base) + static_cast<size_t>(d);
+        }
+        if (sign > 0) {
+            return cursor + value;
+        }
+        if (sign < 0) {
+            return value > cursor ? 0 : cursor - value;
+        }
+        return value;
+    }
+
+    /// Search for m.pattern after the cursor, wrapping around, in the background
+    /// A newer search cancels one still running.
+    inline tea::Cmd hexview_search(HexViewModel &m) {
+        if (m.pattern.empty() || !m.file || m.file->empty()) {
+            return tea::none();
+        }
+        m.search_cancel.cancel();
+        m.search_cancel = CancelToken();
+        m.searching = true;
+        m.message.clear();
+
+        uint64_t generation = ++m.search_generation;
+        size_t start = m.match == m.cursor ? m.cursor + 1 : m.cursor;
+        int id = m.id;
+        return tea::async([file = m.file, pattern = m.pattern, cancel = m.search_cancel, start, generation,
+                           id]() -> std::optional<tea::Msg> {
+            // Scan in chunks (overlapping by the pattern length) so cancellation is prompt
+            const size_t chunk = 64 * 1024 * 1024;
+            size_t size = file->size();
+            size_t len = pattern.size();
+            auto scan = [&](size_t from, size_t to) -> size_t {
+                for (size_t pos = from; pos < to && !cancel.cancelled(); pos += chunk) {
+                    size_t end = std::min(to, pos + chunk + len - 1);
+                    file->advise_sequential(pos, end - pos);
+                    size_t hit = bytes::find(file->data() + pos, end - pos, pattern.data(), len);
+                    if (hit != bytes::npos) {
+                        return pos + hit;
+                    }
+                }
+                return bytes::npos;
+            };
+
+            HexSearchResult result;
+            result.generation = generation;
+            result.offset = scan(std::min(start, size), size);
+            if (result.offset == bytes::npos && start > 0) {
+                result.offset = scan(0, std::min(size, start + len - 1));
+                result.wrapped = result.offset != bytes::npos;
+            }
+            if (cancel.cancelled()) {
+                return std::nullopt;
+            }
+            return tea::TaskMsg{id, result};
+        }, Priority::Background, m.search_cancel);
+    }
+
+    inline tea::Cmd hexview_submit_prompt(HexViewModel &m) {
+        auto prompt = m.prompt;
+        m.prompt = HexViewModel::Prompt::None;
+        if (prompt == HexViewModel::Prompt::Goto) {
+            auto target = hexview_parse_offset(m.input, m.cursor);
+            if (!target) {
+                m.message = "invalid offset: " + m.input;
+            } else if (*target >= m.size()) {
+                m.message = "offset past end of file";
+            } else {
+                hexview_goto(m, *target);
+            }
+            return tea::none();
+        }
+        if (prompt == HexViewModel::Prompt::Hex) {
+            if (!bytes::parse_hex(m.input, m.pattern)) {
+                m.message = "invalid hex pattern: " + m.input;
+                return tea::none();
+            }
+        } else {
+            m.pattern.assign(m.input.begin(), m.input.end());
+        }
+        m.match = bytes::npos;
+        return hexview_search(m);
+    }
+
+    inline std::pair<HexViewModel, tea::Cmd> hexview_update(HexViewModel m, const tea::Msg &msg) {
+        if (auto *task = tea::try_as<tea::TaskMsg>(msg)) {
+            if (task->id != m.id) {
+                return {std::move(m), tea::none()};
+            }
+            auto *result = std::any_cast<HexSearchResult>(&task->value);
+            if (result && result->generation == m.search_generation) {
+                m.searching = false;
+                if (result->offset == bytes::npos) {
+                    m.message = "pattern not found";
+                } else {
+                    m.match = result->offset;
+                    m.message = result->wrapped ? "search wrapped" : "";
+                    hexview_goto(m, result->offset);
+                }
+            }
+            return {std::move(m), tea::none()};
+        }
+
+        auto *key = tea::try_as<tea::KeyMsg>(msg);
+        if (!key) {
+            return {std::move(m), tea::none()};
+        }
+
+        if (m.prompt != HexViewModel::Prompt::None) {
+            switch (key->key) {
+            case input::Key::Enter:
+                return {std::move(m), hexview_submit_prompt(m)};
+            case input::Key::Escape:
+            case input::Key::CtrlC:
+                m.prompt = HexViewModel::Prompt::None;
+                break;
+            case input::Key::Backspace:
+                if (!m.input.empty()) {
+                    m.input.pop_back();
+                }
+                break;
+            case input::Key::Rune:
+            case input::Key::Space:
+                if (key->rune < 0x80) {
+                    m.input += static_cast<char>(key->rune);
+                }
+                break;
+            default:
+                break;
+            }
+            return {std::move(m), tea::none()};
+        }
+
+        size_t row_bytes = hexview_row_bytes(m);
+        size_t page = row_bytes * static_cast<size_t>(std::max(1, m.height));
+        char32_t rune = key->key == input::Key::Rune ? key->rune : 0;
+        m.message.clear();
+
+        if (key->key == input::Key::Escape || key->key == input::Key::CtrlC || rune == 'q') {
+            m.search_cancel.cancel();
+            m.cancelled = true;
+            return {std::move(m), tea::quit()};
+        } else if (key->key == input::Key::Enter) {
+            m.submitted = true;
+            return {std::move(m), tea::quit()};
+        } else if (key->key == input::Key::Up || rune == 'k') {
+            hexview_goto(m, m.cursor >= row_bytes ? m.cursor - row_bytes : m.cursor);
+        } else if (key->key == input::Key::Down || rune == 'j') {
+            if (m.cursor + row_bytes < m.size())
+                hexview_goto(m, m.cursor + row_bytes);
+        } else if (key->key == input::Key::Left || rune == 'h') {
+            hexview_goto(m, m.cursor > 0 ? m.cursor - 1 : 0);
+        } else if (key->key == input::Key::Right || rune == 'l') {
+            hexview_goto(m, m.cursor + 1);
+        } else if (key->key == input::Key::PageUp || key->key == input::Key::CtrlB) {
+            hexview_goto(m, m.cursor >= page ? m.cursor - page : m.cursor % row_bytes);
+        } else if (key->key == input::Key::PageDown || key->key == input::Key::CtrlF ||
+                   key->key == input::Key::Space) {
+            hexview_goto(m, m.cursor + page);
+        } else if (key->key == input::Key::Home || rune == 'g') {
+            hexview_goto(m, 0);
+        } else if (key->key == input::Key::End || rune == 'G') {
+            hexview_goto(m, m.size());
+        } else if (rune == ':') {
+            m.prompt = HexViewModel::Prompt::Goto;
+            m.input.clear();
+        } else if (rune == '/') {
+            m.prompt = HexViewModel::Prompt::Text;
+            m.input.clear();
+        } else if (rune == 'x') {
+            m.prompt = HexViewModel::Prompt::Hex;
+            m.input.clear();
+        } else if (rune == 'n') {
+            return {std::move(m), hexview_search(m)};
+        }
+
+        return {std::move(m), tea::none()};
+    }
+
+    /// Format one row: offset, hex bytes and ASCII, using the hex lookup table
+    inline std::string hexview_render_row(const HexViewModel &m, size_t row_start, int offset_digits) {
+        size_t row_bytes = hexview_row_bytes(m);
+        size_t end = std::min(row_start + row_bytes, m.size());
+        const uint8_t *data = m.data();
+        size_t match_end = m.match == bytes::npos ? 0 : m.match + m.pattern.size();
+
+        // Classify bytes so runs sharing a style are rendered together
+        enum Kind { Normal, Zero, Match, Cursor, Pad };
+        auto kind_of = [&](size_t pos) {
+            if (pos >= end)
+                return Pad;
+            if (pos == m.cursor)
+                return Cursor;
+            if (m.match != bytes::npos && pos >= m.match && pos < match_end)
+                return Match;
+            return data[pos] == 0 ? Zero : Normal;
+        };
+        auto style_of = [&](Kind k) {
+            switch (k) {
+            case Cursor:
+                return Style().foreground(m.cursor_color).reverse().bold();
+            case Match:
+                return Style().foreground(m.match_color).bold();
+            case Zero:
+                return Style().foreground(m.zero_color);
+            default:
+                return Style().foreground(m.byte_color);
+            }
+        };
+
+        std::string line;
+        char digits[16];
+        for (int d = offset_digits - 1, shift = 0; d >= 0; d--, shift += 4) {
+            digits[d] = "0123456789abcdef"[(row_start >> shift) & 15];
+        }
+        line += Style().foreground(m.offset_color).render(std::string(digits, static_cast<size_t>(offset_digits)));
+        line += "  ";
+
+        // Hex column: bytes of the same kind share one styled run, separators included
+        std::string run;
+        Kind run_kind = Pad;
+        auto flush = [&]() {
+            if (!run.empty()) {
+                line += run_kind == Pad ? run : style_of(run_kind).render(run);
+                run.clear();
+            }
+        };
+        for (size_t i = 0; i < row_bytes; i++) {
+            size_t pos = row_start + i;
+            Kind k = kind_of(pos);
+            if (k != run_kind) {
+                flush();
+                run_kind = k;
+            }
+            char hex[2] = {' ', ' '};
+            if (pos < end) {
+                bytes::hex_byte(hex, data[pos]);
+            }
+            run.append(hex, 2);
+            if (i + 1 < row_bytes) {
+                const char *sep = (i % 8 == 7) ? "  " : " ";
+                if (kind_of(pos + 1) == k) {
+                    run += sep;
+                } else {
+                    flush();
+                    line += sep;
+                }
+            }
+        }
+        flush();
+        line += "  ";
+
+        // ASCII column
+        for (size_t pos = row_start; pos < end; pos++) {
+            Kind k = kind_of(pos);
+            if (k != run_kind) {
+                flush();
+                run_kind = k;
+            }
+            uint8_t b = data[pos];
+            run += (b >= 0x20 && b < 0x7f) ? static_cast<char>(b) : '.';
+        }
+        flush();
+        return line;
+    }
+
+    inline std::string hexview_view(const HexViewModel &m) {
+        std::string view;
+        if (!m.title.empty()) {
+            view += Style().foreground(m.title_color).bold().render(m.title) + "\n";
+        }
+
+        size_t size = m.size();
+        size_t row_bytes = hexview_row_bytes(m);
+        int offset_digits = size > 0xFFFFFFFFull ? 16 : 8;
+        size_t rows = static_cast<size_t>(std::max(1, m.height));
+
+        // Only the rows on screen are formatted; the mapping pages in just those bytes
+        for (size_t r = 0; r < rows; r++) {
+            size_t row_start = m.offset + r * row_bytes;
+            if (row_start < size) {
+                view += hexview_render_row(m, row_start, offset_digits);
+            } else if (size == 0 && r == 0) {
+                view += Style().foreground(m.offset_color).italic().render("(empty)");
+            }
+            if (r + 1 < rows) {
+                view += "\n";
+            }
+        }
+
+        if (m.show_status) {
+            view += "\n";
+            std::string left;
+            Color left_color = m.status_fg;
+            switch (m.prompt) {
+            case HexViewModel::Prompt::Goto:
+                left = " goto: " + m.input + "_ ";
+                break;
+            case HexViewModel::Prompt::Text:
+                left = " search: " + m.input + "_ ";
+                break;
+            case HexViewModel::Prompt::Hex:
+                left = " hex: " + m.input + "_ ";
+                break;
+            default:
+                if (m.searching) {
+                    left = " searching... ";
+                } else if (!m.message.empty()) {
+                    left = " " + m.message + " ";
+                    left_color = m.error_color;
+                }
+                break;
+            }
+
+            char pos[64];
+            std::snprintf(pos, sizeof(pos), " 0x%llx / 0x%llx ", static_cast<unsigned long long>(m.cursor),
+                          static_cast<unsigned long long>(size));
+            std::string right = pos;
+            int width = offset_digits + 2 + static_cast<int>(row_bytes) * 4 + static_cast<int>(row_bytes / 8) + 1;
+            int pad = width - static_cast<int>(visible_width(left) + visible_width(right));
+            view += Style().foreground(left_color).background(m.status_bg).bold().render(left);
+            view += Style().foreground(m.offset_color).background(m.status_bg).render(
+                std::string(static_cast<size_t>(std::max(0, pad)), ' ') + right);
+        }
+
+        return view;
+    }
+
+    class HexView {
+      public:
+        /// Map a file for viewing
+        HexView &file(const std::string &path) {
+            hexview_open(m_model, path);
+            return *this;
+        }
+
+        /// View in-memory bytes
+        HexView &data(std::string bytes) {
+            m_model.file = std::make_shared<MappedFile>(MappedFile::from_bytes(std::move(bytes)));
+            return *this;
+        }
+
+        HexView &title(const std::string &t) {
+            m_model.title = t;
+            return *this;
+        }
+
+        HexView &height(int h) {
+            m_model.height = h;
+            return *this;
+        }
+
+        HexView &bytes_per_row(int n) {
+            m_model.bytes_per_row = std::max(1, n);
+            return *this;
+        }
+
+        /// Start with the cursor at this byte
+        HexView &offset(size_t pos) {
+            m_start = pos;
+            return *this;
+        }
+
+        HexView &alt_screen(bool enable = true) {
+            m_alt_screen = enable;
+            return *this;
+        }
+
+        /// Returns the offset under the cursor when Enter is pressed, nullopt on quit
+        std::optional<size_t> run() {
+            hexview_init(m_model);
+            hexview_goto(m_model, m_start);
+
+            auto init = [this]() -> std::pair<HexViewModel, tea::Cmd> { return {m_model, tea::none()}; };
+            auto update = [](HexViewModel m, tea::Msg msg) { return hexview_update(std::move(m), msg); };
+            auto view = [](const HexViewModel &m) { return hexview_view(m); };
+
+            auto final_model = tea::Program<HexViewModel>(init, update, view).with_alt_screen(m_alt_screen).run();
+            final_model.search_cancel.cancel();
+            if (!final_model.submitted || final_model.size() == 0) {
+                return std::nullopt;
+            }
+            return final_model.cursor;
+        }
+
+        HexViewModel &model() { return m_model; }
+        const HexViewModel &model() const { return m_model; }
+
+      private:
+        HexViewModel m_model;
+        size_t m_start = 0;
+        bool m_alt_screen = false;
+    };
+
+} // namespace scan
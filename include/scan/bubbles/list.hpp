@@ -13,6 +13,7 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace scan {
@@ -56,17 +57,20 @@ namespace scan {
         Color muted_color;
         Color desc_color;
 
+        // Streaming: items arrive as LogMsg batches with this id
+        int id = 0;
+
         // State
         bool submitted = false;
         bool cancelled = false;
 
         ListModel() {
-            auto &t = current_theme();
-            cursor_color = t.colors.primary;
-            selected_color = t.colors.success;
-            normal_color = t.colors.text;
-            muted_color = t.colors.text_muted;
-            desc_color = t.colors.text_subtle;
+            auto t = theme_snapshot();
+            cursor_color = t->colors.primary;
+            selected_color = t->colors.success;
+            normal_color = t->colors.text;
+            muted_color = t->colors.text_muted;
+            desc_color = t->colors.text_subtle;
         }
 
         size_t item_count() const { return use_rich_items ? rich_items.size() : items.size(); }
@@ -95,6 +99,19 @@ namespace scan {
 
     /// Update function for List
     inline std::pair<ListModel, tea::Cmd> list_update(ListModel m, const tea::Msg &msg) {
+        if (auto *items = tea::try_as<tea::LogMsg>(msg)) {
+            if (items->id == m.id) {
+                tea::for_each_line(items->text, [&](std::string_view line) {
+                    if (m.use_rich_items) {
+                        m.rich_items.emplace_back(std::string(line));
+                    } else {
+                        m.items.emplace_back(line);
+                    }
+                });
+            }
+            return {std::move(m), tea::none()};
+        }
+
         size_t count = m.item_count();
         if (count == 0) {
             return {std::move(m), tea::none()};
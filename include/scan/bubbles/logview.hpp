@@ -0,0 +1,974 @@
+#pragma once
+
+/// @file logview.hpp
+/// @brief High-throughput log tail with level and substring filtering
+
+#include <scan/input/key.hpp>
+#include <scan/style/style.hpp>
+#include <scan/tea/cmd.hpp>
+#include <scan/tea/exec.hpp>
+#include <scan/tea/msg.hpp>
+#include <scan/tea/program.hpp>
+#include <scan/terminal/terminal.hpp>
+#include <scan/util/utf8.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace scan {
+
+    /// Severity of a log line, detected from its text
+    enum class LogLevel : uint8_t { None, Trace, Debug, Info, Warn, Error, Fatal };
+
+    inline const char *log_level_name(LogLevel level) {
+        switch (level) {
+        case LogLevel::Trace:
+            return "TRACE";
+        case LogLevel::Debug:
+            return "DEBUG";
+        case LogLevel::Info:
+            return "INFO";
+        case LogLevel::Warn:
+            return "WARN";
+        case LogLevel::Error:
+            return "ERROR";
+        case LogLevel::Fatal:
+            return "FATAL";
+        default:
+            return "ALL";
+        }
+    }
+
+    /// Find the first level word (INFO, warn, [ERR], ...) near the start of a line
+    inline LogLevel log_level_detect(std::string_view line) {
+        struct Word {
+            std::string_view text;
+            LogLevel level;
+        };
+        static constexpr Word words[] = {
+            {"TRACE", LogLevel::Trace},  {"TRC", LogLevel::Trace},     {"DEBUG", LogLevel::Debug},
+            {"DBG", LogLevel::Debug},    {"INFO", LogLevel::Info},     {"INF", LogLevel::Info},
+            {"WARN", LogLevel::Warn},    {"WARNING", LogLevel::Warn},  {"WRN", LogLevel::Warn},
+            {"ERROR", LogLevel::Error},  {"ERR", LogLevel::Error},     {"FATAL", LogLevel::Fatal},
+            {"CRIT", LogLevel::Fatal},   {"CRITICAL", LogLevel::Fatal}, {"PANIC", LogLevel::Fatal},
+        };
+
+        // Levels appear in the prefix; scanning further would match message text
+        size_t end = std::min<size_t>(line.size(), 64);
+        size_t i = 0;
+        while (i < end) {
+            if (!std::isalpha(static_cast<unsigned char>(line[i]))) {
+                i++;
+                continue;
+            }
+            size_t start = i;
+            while (i < line.size() && std::isalpha(static_cast<unsigned char>(line[i]))) {
+                i++;
+            }
+            size_t len = i - start;
+            if (len < 3 || len > 8) {
+                continue;
+            }
+            char upper[8];
+            for (size_t k = 0; k < len; k++) {
+                upper[k] = static_cast<char>(std::toupper(static_cast<unsigned char>(line[start + k])));
+            }
+            std::string_view word(upper, len);
+            for (const auto &w : words) {
+                if (w.text == word) {
+                    return w.level;
+                }
+            }
+        }
+        return LogLevel::None;
+    }
+
+    /// Substring search, optionally ASCII case-insensitive
+    inline bool log_contains(std::string_view haystack, std::string_view needle, bool ignore_case) {
+        if (needle.empty()) {
+            return true;
+        }
+        if (!ignore_case) {
+            return haystack.find(needle) != std::string_view::npos;
+        }
+        auto eq = [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        };
+        return std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(), eq) != haystack.end();
+    }
+
+    /// Fixed-capacity ring of log lines stored back to back in one byte arena
+    ///
+    /// Each line costs its bytes plus a small metadata record; no per-line
+    /// allocation happens after the arena is created on the first push. When
+    /// either the line or the byte capacity is reached the oldest lines are
+    /// evicted. Lines are addressed by a sequence number that keeps growing, so
+    /// indexes held elsewhere stay valid until their line is evicted.
+    class LogBuffer {
+      public:
+        struct Line {
+            uint32_t offset = 0;
+            uint32_t length = 0;
+            LogLevel level = LogLevel::None;
+            int64_t timestamp_ms = 0; // Arrival time, milliseconds since the epoch
+        };
+
+        explicit LogBuffer(size_t max_lines = 100000, size_t max_bytes = 16 * 1024 * 1024)
+            : m_max_lines(std::max<size_t>(1, max_lines)),
+              m_max_bytes(std::clamp<size_t>(max_bytes, 1, UINT32_MAX)) {}
+
+        /// Append a line (without its newline), evicting old lines as needed
+        /// @return Sequence number of the new line
+        uint64_t push(std::string_view text, LogLevel level, int64_t timestamp_ms) {
+            if (m_arena.empty()) {
+                m_arena.resize(m_max_bytes);
+                m_lines.resize(m_max_lines);
+            }
+            if (text.size() > m_max_bytes) {
+                text = text.substr(0, m_max_bytes);
+            }
+            auto len = static_cast<uint32_t>(text.size());
+
+            if (size() == m_max_lines) {
+                m_first++;
+            }
+
+            // Not enough room before the end of the arena: the lines still
+            // stored past the write position are the oldest, drop them and wrap
+            uint32_t start = m_tail;
+            if (static_cast<size_t>(start) + len > m_max_bytes) {
+                while (!empty() && line(m_first).offset >= m_tail) {
+                    m_first++;
+                }
+                start = 0;
+            }
+            while (!empty()) {
+                const Line &old = line(m_first);
+                bool starts_inside = old.offset >= start && old.offset < start + len;
+                bool spans_start = old.offset < start && old.offset + old.length > start;
+                if (!starts_inside && !spans_start) {
+                    break;
+                }
+                m_first++;
+            }
+
+            std::copy(text.begin(), text.end(), m_arena.begin() + start);
+            m_lines[m_end % m_max_lines] = Line{start, len, level, timestamp_ms};
+            m_tail = start + len;
+            return m_end++;
+        }
+
+        /// Drop every line (sequence numbers keep counting)
+        void clear() {
+            m_first = m_end;
+            m_tail = 0;
+        }
+
+        const Line &line(uint64_t seq) const { return m_lines[seq % m_max_lines]; }
+
+        std::string_view text(uint64_t seq) const {
+            const Line &l = line(seq);
+            return std::string_view(m_arena.data() + l.offset, l.length);
+        }
+
+        uint64_t first() const { return m_first; } // Oldest stored sequence number
+        uint64_t end() const { return m_end; }     // One past the newest
+        size_t size() const { return static_cast<size_t>(m_end - m_first); }
+        bool empty() const { return m_first == m_end; }
+        bool contains(uint64_t seq) const { return seq >= m_first && seq < m_end; }
+        size_t max_lines() const { return m_max_lines; }
+        size_t max_bytes() const { return m_max_bytes; }
+
+      private:
+        size_t m_max_lines;
+        size_t m_max_bytes;
+        std::vector<char> m_arena;
+        std::vector<Line> m_lines;
+        uint64_t m_first = 0;
+        uint64_t m_end = 0;
+        uint32_t m_tail = 0;
+    };
+
+    struct LogViewModel {
+        LogBuffer buffer;
+        int id = 0; // Matched against LogMsg / ExecOutputMsg ids
+
+        // Optional command whose output is tailed
+        std::vector<std::string> command;
+        tea::ExecOptions options;
+
+        // Filter
+        LogLevel min_level = LogLevel::None;
+        std::string query;
+        bool ignore_case = true;
+        bool editing_query = false;
+
+        // Sequence numbers of lines passing the filter, oldest first, live from visible_head
+        std::vector<uint64_t> visible;
+        size_t visible_head = 0;
+
+        // Display
+        std::string title;
+        int width = 80;
+        int height = 20;
+        size_t offset = 0;  // First displayed row, index into the live visible lines
+        bool follow = true; // Keep the newest line in view
+        bool show_timestamps = false;
+        bool show_status = true;
+
+        // Stream state
+        std::string partial;        // Incomplete trailing line from a raw byte stream
+        size_t max_partial = 64 * 1024;       // A line without a newline is broken after this many bytes
+        LogLevel last_level = LogLevel::None; // Unleveled lines (stack traces) inherit this
+        bool done = false;
+        std::string error;
+        uint64_t bytes_received = 0;
+
+        // Styling - uses theme
+        Color text_color;
+        Color muted_color;
+        Color warn_color;
+        Color error_color;
+        Color title_color;
+        Color match_color;
+        Color status_fg;
+        Color status_bg;
+
+        LogViewModel() {
+            auto t = theme_snapshot();
+            text_color = t->colors.text;
+            muted_color = t->colors.text_muted;
+            warn_color = t->colors.warning;
+            error_color = t->colors.error;
+            title_color = t->colors.primary;
+            match_color = t->colors.match_highlight;
+            status_fg = t->colors.text;
+            status_bg = t->colors.bg_muted;
+        }
+    };
+
+    /// Number of lines currently passing the filter
+    inline size_t logview_visible_count(const LogViewModel &m) { return m.visible.size() - m.visible_head; }
+
+    inline bool logview_matches(const LogViewModel &m, uint64_t seq) {
+        const auto &line = m.buffer.line(seq);
+        if (m.min_level != LogLevel::None && line.level < m.min_level) {
+            return false;
+        }
+        return log_contains(m.buffer.text(seq), m.query, m.ignore_case);
+    }
+
+    inline size_t logview_max_offset(const LogViewModel &m) {
+        size_t count = logview_visible_count(m);
+        size_t rows = static_cast<size_t>(std::max(1, m.height));
+        return count > rows ? count - rows : 0;
+    }
+
+    inline void logview_goto_bottom(LogViewModel &m) { m.offset = logview_max_offset(m); }
+
+    inline void logview_scroll(LogViewModel &m, long delta) {
+        long target = static_cast<long>(m.offset) + delta;
+        m.offset = std::min(static_cast<size_t>(std::max(0L, target)), logview_max_offset(m));
+        m.follow = m.offset == logview_max_offset(m);
+    }
+
+    /// Forget visible entries whose lines were evicted from the buffer
+    inline void logview_drop_evicted(LogViewModel &m) {
+        size_t dropped = 0;
+        while (m.visible_head < m.visible.size() && !m.buffer.contains(m.visible[m.visible_head])) {
+            m.visible_head++;
+            dropped++;
+        }
+        m.offset -= std::min(m.offset, dropped);
+
+        // Compact once the dead prefix dominates, keeping removal amortized O(1)
+        if (m.visible_head > 0 && m.visible_head >= m.visible.size() / 2) {
+            m.visible.erase(m.visible.begin(), m.visible.begin() + static_cast<long>(m.visible_head));
+            m.visible_head = 0;
+        }
+    }
+
+    /// Rebuild the visible index from scratch
+    inline void logview_refilter(LogViewModel &m) {
+        m.visible.clear();
+        m.visible_head = 0;
+        for (uint64_t seq = m.buffer.first(); seq < m.buffer.end(); seq++) {
+            if (logview_matches(m, seq)) {
+                m.visible.push_back(seq);
+            }
+        }
+        if (m.follow) {
+            logview_goto_bottom(m);
+        } else {
+            m.offset = std::min(m.offset, logview_max_offset(m));
+        }
+    }
+
+    /// Re-test only the lines already visible (filter became stricter)
+    inline void logview_narrow(LogViewModel &m) {
+        size_t out = 0;
+        for (size_t i = m.visible_head; i < m.visible.size(); i++) {
+            if (logview_matches(m, m.visible[i])) {
+                m.visible[out++] = m.visible[i];
+            }
+        }
+        m.visible.resize(out);
+        m.visible_head = 0;
+        if (m.follow) {
+            logview_goto_bottom(m);
+        } else {
+            m.offset = std::min(m.offset, logview_max_offset(m));
+        }
+    }
+
+    inline std::string logview_fold(std::string_view s, bool ignore_case) {
+        std::string out(s);
+        if (ignore_case) {
+            for (auto &c : out) {
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+        }
+        return out;
+    }
+
+    /// Change the substring filter; extending the query only re-tests visible lines
+    inline void logview_set_query(LogViewModel &m, const std::string &query) {
+        bool narrower = logview_fold(query, m.ignore_case).find(logview_fold(m.query, m.ignore_case)) !=
+                        std::string::npos;
+        m.query = query;
+        if (narrower) {
+            logview_narrow(m);
+        } else {
+            logview_refilter(m);
+        }
+    }
+
+    /// Change the minimum level; raising it only re-tests visible lines
+    inline void logview_set_min_level(LogViewModel &m, LogLevel level) {
+        bool narrower = level >= m.min_level;
+        m.min_level = level;
+        if (narrower) {
+            logview_narrow(m);
+        } else {
+            logview_refilter(m);
+        }
+    }
+
+    inline int64_t logview_now_ms() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /// Store one complete line and update the visible index incrementally
+    inline void logview_push(LogViewModel &m, std::string_view line, int64_t timestamp_ms) {
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        // A line redrawn with \r (a progress bar) shows only its last version
+        auto cr = line.rfind('\r');
+        if (cr != std::string_view::npos) {
+            line.remove_prefix(cr + 1);
+        }
+        LogLevel level = log_level_detect(line);
+        if (level == LogLevel::None) {
+            level = m.last_level;
+        } else {
+            m.last_level = level;
+        }
+
+        uint64_t seq = m.buffer.push(line, level, timestamp_ms);
+        if (logview_matches(m, seq)) {
+            m.visible.push_back(seq);
+        }
+    }
+
+    /// Finish a batch of pushes: drop evicted lines from the index and keep the tail in view
+    inline void logview_settle(LogViewModel &m) {
+        logview_drop_evicted(m);
+        if (m.follow) {
+            logview_goto_bottom(m);
+        }
+    }
+
+    /// Add newline-separated complete lines (a trailing newline is optional)
+    inline void logview_add_lines(LogViewModel &m, std::string_view text) {
+        int64_t now = logview_now_ms();
+        m.bytes_received += text.size();
+        size_t start = 0;
+        while (start < text.size()) {
+            size_t nl = text.find('\n', start);
+            if (nl == std::string_view::npos) {
+                nl = text.size();
+            }
+            logview_push(m, text.substr(start, nl - start), now);
+            start = nl + 1;
+        }
+        logview_settle(m);
+    }
+
+    /// Hold back the unterminated tail of a chunk, keeping it bounded
+    ///
+    /// As in ExecView, only the text after the last `\r` is kept (a trailing `\r` stays, it may be
+    /// the first half of `\r\n`), and a stream with no newlines is broken into max_partial-byte lines.
+    inline void logview_append_partial(LogViewModel &m, std::string_view tail, int64_t now) {
+        // Only the new bytes and a trailing \r left from before can hold the last \r
+        size_t from = m.partial.empty() ? 0 : m.partial.size() - 1;
+        m.partial.append(tail);
+        auto cr = std::string_view(m.partial).substr(from, m.partial.size() - 1 - from).rfind('\r');
+        if (cr != std::string_view::npos) {
+            m.partial.erase(0, from + cr + 1);
+        }
+
+        if (m.max_partial == 0) {
+            return;
+        }
+        size_t flushed = 0;
+        while (m.partial.size() - flushed >= m.max_partial) {
+            logview_push(m, std::string_view(m.partial).substr(flushed, m.max_partial), now);
+            flushed += m.max_partial;
+        }
+        m.partial.erase(0, flushed);
+    }
+
+    /// Add a chunk of a raw byte stream, holding back an incomplete last line
+    inline void logview_append(LogViewModel &m, std::string_view data) {
+        int64_t now = logview_now_ms();
+        m.bytes_received += data.size();
+        size_t start = 0;
+        while (start < data.size()) {
+            size_t nl = data.find('\n', start);
+            if (nl == std::string_view::npos) {
+                logview_append_partial(m, data.substr(start), now);
+                break;
+            }
+            if (m.partial.empty()) {
+                logview_push(m, data.substr(start, nl - start), now);
+            } else {
+                m.partial.append(data.substr(start, nl - start));
+                logview_push(m, m.partial, now);
+                m.partial.clear();
+            }
+            start = nl + 1;
+        }
+        logview_settle(m);
+    }
+
+    /// Flush a held-back partial line once its stream ends
+    inline void logview_finish(LogViewModel &m) {
+        if (!m.partial.empty()) {
+            logview_push(m, m.partial, logview_now_ms());
+            m.partial.clear();
+            logview_settle(m);
+        }
+        m.done = true;
+    }
+
+    /// Size the view to the terminal, reserving rows for title and status bar
+    inline void logview_init(LogViewModel &m) {
+        auto [cols, rows] = terminal::get_size();
+        m.width = cols;
+        int reserved = 0;
+        if (!m.title.empty())
+            reserved += 1;
+        if (m.show_status)
+            reserved += 1;
+        m.height = std::max(1, std::min(m.height, rows - reserved));
+    }
+
+    inline std::pair<LogViewModel, tea::Cmd> logview_update(LogViewModel m, const tea::Msg &msg) {
+        if (auto *log = tea::try_as<tea::LogMsg>(msg)) {
+            if (log->id == m.id) {
+                logview_add_lines(m, log->text);
+                if (log->done) {
+                    logview_finish(m);
+                }
+            }
+            return {std::move(m), tea::none()};
+        }
+
+        if (auto *out = tea::try_as<tea::ExecOutputMsg>(msg)) {
+            if (out->id == m.id) {
+                logview_append(m, out->data);
+            }
+            return {std::move(m), tea::none()};
+        }
+
+        if (auto *exit = tea::try_as<tea::ExecExitMsg>(msg)) {
+            if (exit->id == m.id) {
+                logview_finish(m);
+                m.error = exit->error;
+            }
+            return {std::move(m), tea::none()};
+        }
+
+        auto *key = tea::try_as<tea::KeyMsg>(msg);
+        if (!key) {
+            return {std::move(m), tea::none()};
+        }
+
+        if (m.editing_query) {
+            switch (key->key) {
+            case input::Key::Enter:
+                m.editing_query = false;
+                break;
+            case input::Key::Escape:
+                m.editing_query = false;
+                logview_set_query(m, "");
+                break;
+            case input::Key::Backspace:
+                if (!m.query.empty()) {
+                    size_t n = utf8::length(m.query);
+                    logview_set_query(m, utf8::substring(m.query, 0, n - 1));
+                }
+                break;
+            case input::Key::Rune:
+            case input::Key::Space:
+                logview_set_query(m, m.query + utf8::encode(key->rune));
+                break;
+            default:
+                break;
+            }
+            return {std::move(m), tea::none()};
+        }
+
+        long page = std::max(1, m.height);
+        switch (key->key) {
+        case input::Key::Escape:
+        case input::Key::CtrlC:
+            return {std::move(m), tea::quit()};
+        case input::Key::Up:
+            logview_scroll(m, -1);
+            break;
+        case input::Key::Down:
+            logview_scroll(m, 1);
+            break;
+        case input::Key::PageUp:
+        case input::Key::CtrlB:
+            logview_scroll(m, -page);
+            break;
+        case input::Key::PageDown:
+        case input::Key::CtrlF:
+        case input::Key::Space:
+            logview_scroll(m, page);
+            break;
+        case input::Key::Home:
+            m.offset = 0;
+            m.follow = logview_max_offset(m) == 0;
+            break;
+        case input::Key::End:
+            m.follow = true;
+            logview_goto_bottom(m);
+            break;
+        case input::Key::Rune:
+            switch (key->rune) {
+            case 'q':
+                return {std::move(m), tea::quit()};
+            case 'j':
+                logview_scroll(m, 1);
+                break;
+            case 'k':
+                logview_scroll(m, -1);
+                break;
+            case 'g':
+                m.offset = 0;
+                m.follow = logview_max_offset(m) == 0;
+                break;
+            case 'G':
+                m.follow = true;
+                logview_goto_bottom(m);
+                break;
+            case '/':
+                m.editing_query = true;
+                break;
+            case 't':
+                m.show_timestamps = !m.show_timestamps;
+                break;
+            case 'i':
+                m.ignore_case = !m.ignore_case;
+                logview_refilter(m);
+                break;
+            case '1':
+                logview_set_min_level(m, LogLevel::None);
+                break;
+            case '2':
+                logview_set_min_level(m, LogLevel::Debug);
+                break;
+            case '3':
+                logview_set_min_level(m, LogLevel::Info);
+                break;
+            case '4':
+                logview_set_min_level(m, LogLevel::Warn);
+                break;
+            case '5':
+                logview_set_min_level(m, LogLevel::Error);
+                break;
+            default:
+                break;
+            }
+            break;
+        default:
+            break;
+        }
+        return {std::move(m), tea::none()};
+    }
+
+    /// Local wall-clock time as HH:MM:SS.mmm
+    inline std::string logview_format_time(int64_t timestamp_ms) {
+        std::time_t secs = static_cast<std::time_t>(timestamp_ms / 1000);
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &secs);
+#else
+        localtime_r(&secs, &tm);
+#endif
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%02d:%02d:%02d.%03d", tm.tm_hour, tm.tm_min, tm.tm_sec,
+                      static_cast<int>(timestamp_ms % 1000));
+        return buf;
+    }
+
+    /// Render one stored line: cut to width first so styling cost doesn't depend on line length
+    inline std::string logview_render_line(const LogViewModel &m, uint64_t seq) {
+        const auto &meta = m.buffer.line(seq);
+        std::string view;
+        size_t room = static_cast<size_t>(std::max(1, m.width));
+
+        if (m.show_timestamps && room > 13) {
+            view += Style().foreground(m.muted_color).render(logview_format_time(meta.timestamp_ms)) + " ";
+            room -= 13;
+        }
+
+        // Work on at most room codepoints, with control characters blanked
+        std::string_view src = m.buffer.text(seq);
+        std::string text;
+        size_t cols = 0;
+        for (size_t i = 0; i < src.size() && cols < room; i++) {
+            unsigned char c = static_cast<unsigned char>(src[i]);
+            if (c < 0x20 || c == 0x7f) {
+                text += ' ';
+            } else {
+                text += src[i];
+            }
+            if (!utf8::is_continuation(c)) {
+                cols++;
+            }
+            // Keep the rest of a multi-byte sequence together
+            while (i + 1 < src.size() && utf8::is_continuation(static_cast<unsigned char>(src[i + 1]))) {
+                text += src[++i];
+            }
+        }
+
+        Color color = m.text_color;
+        if (meta.level >= LogLevel::Error) {
+            color = m.error_color;
+        } else if (meta.level == LogLevel::Warn) {
+            color = m.warn_color;
+        } else if (meta.level == LogLevel::Debug || meta.level == LogLevel::Trace) {
+            color = m.muted_color;
+        }
+        Style base = Style().foreground(color);
+
+        size_t hit = std::string::npos;
+        if (!m.query.empty()) {
+            auto it = m.ignore_case ? std::search(text.begin(), text.end(), m.query.begin(), m.query.end(),
+                                                  [](char a, char b) {
+                                                      return std::tolower(static_cast<unsigned char>(a)) ==
+                                                             std::tolower(static_cast<unsigned char>(b));
+                                                  })
+                                    : std::search(text.begin(), text.end(), m.query.begin(), m.query.end());
+            if (it != text.end()) {
+                hit = static_cast<size_t>(it - text.begin());
+            }
+        }
+
+        if (hit == std::string::npos) {
+            view += base.render(text);
+        } else {
+            size_t end = hit + m.query.size();
+            if (hit > 0)
+                view += base.render(text.substr(0, hit));
+            view += Style().foreground(m.match_color).bold().render(text.substr(hit, end - hit));
+            if (end < text.size())
+                view += base.render(text.substr(end));
+        }
+        return view;
+    }
+
+    inline std::string logview_view(const LogViewModel &m) {
+        std::string view;
+
+        if (!m.title.empty()) {
+            view += Style().foreground(m.title_color).bold().render(m.title);
+            view += "\n";
+        }
+
+        // Only the rows on screen are touched, however many lines are stored
+        size_t rows = static_cast<size_t>(std::max(1, m.height));
+        size_t count = logview_visible_count(m);
+        for (size_t r = 0; r < rows; r++) {
+            size_t idx = m.offset + r;
+            if (idx < count) {
+                view += logview_render_line(m, m.visible[m.visible_head + idx]);
+            }
+            if (r + 1 < rows) {
+                view += "\n";
+            }
+        }
+
+        if (m.show_status) {
+            view += "\n";
+
+            std::string left;
+            if (m.editing_query) {
+                left = " /" + m.query + "_ ";
+            } else {
+                left = " " + std::string(log_level_name(m.min_level));
+                if (!m.query.empty()) {
+                    left += " /" + m.query;
+                }
+                left += " ";
+            }
+
+            std::string right = std::to_string(count) + "/" + std::to_string(m.buffer.size()) + " lines";
+            if (!m.error.empty()) {
+                right += ", error: " + m.error;
+            } else if (m.done) {
+                right += ", ended";
+            }
+            if (!m.follow) {
+                right += ", paused";
+            }
+            right = " " + right + " ";
+
+            int pad = m.width - static_cast<int>(visible_width(left) + visible_width(right));
+            view += Style().foreground(m.status_fg).background(m.status_bg).bold().render(left);
+            view += Style().foreground(m.muted_color).background(m.status_bg).render(
+                std::string(static_cast<size_t>(std::max(0, pad)), ' ') + right);
+        }
+
+        return view;
+    }
+
+    /// Emits lines into a running LogView; returns false once the view has closed
+    using LogEmit = std::function<bool(std::string_view)>;
+
+    /// Runs on its own thread and feeds lines through emit until it returns or emit fails
+    using LogProducer = std::function<void(const LogEmit &)>;
+
+    /// Producer that tails a file descriptor (e.g. a pipe) until EOF
+    /// Complete lines are forwarded in large batches; the fd is not closed. A line still without a
+    /// newline after max_partial bytes is forwarded in max_partial-byte pieces (0 never breaks it).
+    inline LogProducer log_read_fd(int fd, size_t max_partial = 64 * 1024) {
+        return [fd, max_partial](const LogEmit &emit) {
+#ifndef _WIN32
+            std::string pending;
+            char buf[65536];
+            while (true) {
+                pollfd pfd{fd, POLLIN, 0};
+                int n = ::poll(&pfd, 1, 100);
+                if (n == 0) {
+                    // Idle: make sure the view is still there before waiting again
+                    if (!emit({})) {
+                        return;
+                    }
+                    continue;
+                }
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                ssize_t r = n > 0 ? ::read(fd, buf, sizeof(buf)) : -1;
+                if (r < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (r <= 0) {
+                    break;
+                }
+                pending.append(buf, static_cast<size_t>(r));
+                size_t last = pending.rfind('\n');
+                if (last != std::string::npos) {
+                    if (!emit(std::string_view(pending).substr(0, last + 1))) {
+                        return;
+                    }
+                    pending.erase(0, last + 1);
+                }
+                if (max_partial > 0 && pending.size() >= max_partial) {
+                    size_t flushed = 0;
+                    for (; pending.size() - flushed >= max_partial; flushed += max_partial) {
+                        if (!emit(std::string_view(pending).substr(flushed, max_partial))) {
+                            return;
+                        }
+                    }
+                    pending.erase(0, flushed);
+                }
+            }
+            if (!pending.empty()) {
+                emit(pending);
+            }
+#else
+            (void)fd;
+            (void)emit;
+#endif
+        };
+    }
+
+    /// Run program while producer feeds it lines from its own thread, as LogMsg{id} batches
+    ///
+    /// emit fails once the program has exited; a producer that returns first ends the stream
+    /// with LogMsg{id, "", true}. The producer thread is joined before this returns. With no
+    /// producer this is program.run().
+    template <typename Model> Model run_with_producer(tea::Program<Model> &program, LogProducer producer, int id) {
+        if (!producer) {
+            return program.run();
+        }
+        std::atomic<bool> closed{false};
+        std::thread worker([&program, &closed, &producer, id]() {
+            LogEmit emit = [&](std::string_view text) {
+                if (closed) {
+                    return false;
+                }
+                if (!text.empty()) {
+                    program.send(tea::LogMsg{id, std::string(text), false});
+                }
+                return true;
+            };
+            producer(emit);
+            if (!closed) {
+                program.send(tea::LogMsg{id, std::string(), true});
+            }
+        });
+
+        Model result = program.run();
+        closed = true;
+        worker.join();
+        return result;
+    }
+
+    class LogView {
+      public:
+        /// Lines kept before the oldest are dropped
+        LogView &capacity(size_t lines) {
+            m_model.buffer = LogBuffer(lines, m_model.buffer.max_bytes());
+            return *this;
+        }
+
+        /// Bytes of line text kept before the oldest lines are dropped
+        LogView &capacity_bytes(size_t bytes) {
+            m_model.buffer = LogBuffer(m_model.buffer.max_lines(), bytes);
+            return *this;
+        }
+
+        /// Bytes after which a line that has no newline yet is broken (0 never breaks it)
+        /// Applies to command output; pass the same limit to log_read_fd() for a producer.
+        LogView &max_partial(size_t bytes) {
+            m_model.max_partial = bytes;
+            return *this;
+        }
+
+        /// Tail a command's combined stdout and stderr
+        LogView &command(const std::vector<std::string> &argv) {
+            m_model.command = argv;
+            m_model.options.merge_stderr = true;
+            return *this;
+        }
+
+        LogView &title(const std::string &t) {
+            m_model.title = t;
+            return *this;
+        }
+
+        LogView &width(int w) {
+            m_model.width = w;
+            return *this;
+        }
+
+        LogView &height(int h) {
+            m_model.height = h;
+            return *this;
+        }
+
+        LogView &timestamps(bool show = true) {
+            m_model.show_timestamps = show;
+            return *this;
+        }
+
+        LogView &min_level(LogLevel level) {
+            m_model.min_level = level;
+            return *this;
+        }
+
+        LogView &filter(const std::string &query) {
+            m_model.query = query;
+            return *this;
+        }
+
+        LogView &ignore_case(bool enable = true) {
+            m_model.ignore_case = enable;
+            return *this;
+        }
+
+        LogView &status_bar(bool show = true) {
+            m_model.show_status = show;
+            return *this;
+        }
+
+        /// Maximum redraws per second; lines arriving in between are batched
+        LogView &fps(int n) {
+            m_fps = std::max(1, n);
+            return *this;
+        }
+
+        LogView &alt_screen(bool enable = true) {
+            m_alt_screen = enable;
+            return *this;
+        }
+
+        /// Show the view until the user quits, fed by the command and/or producer
+        /// The producer runs on a separate thread; it is joined before run() returns.
+        void run(LogProducer producer = nullptr) {
+            logview_init(m_model);
+
+            auto init = [this]() -> std::pair<LogViewModel, tea::Cmd> {
+                LogViewModel m = m_model;
+                if (m.command.empty()) {
+                    return {std::move(m), tea::none()};
+                }
+                auto cmd = tea::exec(m.command, m.id, m.options);
+                return {std::move(m), cmd};
+            };
+            auto update = [](LogViewModel m, tea::Msg msg) { return logview_update(std::move(m), msg); };
+            auto view = [](const LogViewModel &m) { return logview_view(m); };
+
+            tea::Program<LogViewModel> program(init, update, view);
+            program.with_alt_screen(m_alt_screen).with_fps(m_fps);
+
+            int id = m_model.id;
+            m_model = run_with_producer(program, std::move(producer), id);
+        }
+
+        LogViewModel &model() { return m_model; }
+        const LogViewModel &model() const { return m_model; }
+
+      private:
+        LogViewModel m_model;
+        int m_fps = 30;
+        bool m_alt_screen = false;
+    };
+
+} // namespace scan
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 namespace scan {
 
@@ -24,6 +25,7 @@ namespace scan {
         bool show_line_numbers = false;
         bool show_status_bar = true;
         bool quit_requested = false;
+        int id = 0; // Matched against LogMsg ids when content streams in
 
         // Styling - uses theme
         Color title_color;
@@ -32,11 +34,11 @@ namespace scan {
         Color line_number_color;
 
         PagerModel() {
-            auto &t = current_theme();
-            title_color = t.colors.primary;
-            status_bg = t.colors.bg_muted;
-            status_fg = t.colors.text;
-            line_number_color = t.colors.text_muted;
+            auto t = theme_snapshot();
+            title_color = t->colors.primary;
+            status_bg = t->colors.bg_muted;
+            status_fg = t->colors.text;
+            line_number_color = t->colors.text_muted;
         }
     };
 
@@ -52,6 +54,14 @@ namespace scan {
     }
 
     inline std::pair<PagerModel, tea::Cmd> pager_update(PagerModel m, const tea::Msg &msg) {
+        if (auto *text = tea::try_as<tea::LogMsg>(msg)) {
+            if (text->id == m.id) {
+                tea::for_each_line(text->text,
+                                   [&](std::string_view line) { viewport_append_line(m.viewport, line); });
+            }
+            return {std::move(m), tea::none()};
+        }
+
         if (auto *key = tea::try_as<tea::KeyMsg>(msg)) {
             switch (key->key) {
             case input::Key::Escape:
@@ -110,12 +120,12 @@ namespace scan {
 
                 view += Style().foreground(m.line_number_color).faint().render(line_num + " | ");
 
-                std::string line = m.viewport.lines[i];
+                std::string_view line = m.viewport.lines[i];
                 if (!m.viewport.wrap && m.viewport.x_offset > 0) {
                     if (static_cast<int>(line.length()) > m.viewport.x_offset) {
                         line = line.substr(m.viewport.x_offset);
                     } else {
-                        line = "";
+                        line = {};
                     }
                 }
 
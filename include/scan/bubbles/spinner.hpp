@@ -6,8 +6,8 @@
 #include <echo/widget.hpp>
 #include <scan/style/style.hpp>
 #include <scan/terminal/terminal.hpp>
+#include <scan/util/thread_pool.hpp>
 
-#include <atomic>
 #include <chrono>
 #include <future>
 #include <string>
@@ -28,11 +28,11 @@ namespace scan {
         std::vector<std::string> gradient;
 
         SpinnerModel() {
-            auto &t = current_theme();
+            auto t = theme_snapshot();
             // Convert theme color to hex
             char buf[8];
-            std::snprintf(buf, sizeof(buf), "#%02X%02X%02X", t.colors.primary.r, t.colors.primary.g,
-                          t.colors.primary.b);
+            std::snprintf(buf, sizeof(buf), "#%02X%02X%02X", t->colors.primary.r, t->colors.primary.g,
+                          t->colors.primary.b);
             color = buf;
         }
     };
@@ -71,17 +71,18 @@ namespace scan {
             return *this;
         }
 
+        /// Run task on the shared pool (default_pool()) while the spinner animates; returns its result
+        ///
+        /// Called from a job already running on the shared pool, the task runs inline instead: blocking that
+        /// worker on another job of the same pool could starve it (the pool may have only two workers).
         template <typename F> auto run(F &&task) -> decltype(task()) {
-            using ResultType = decltype(task());
+            if (default_pool().in_worker()) {
+                return task();
+            }
 
             terminal::hide_cursor();
 
-            std::atomic<bool> done{false};
-            std::future<ResultType> future = std::async(std::launch::async, [&]() {
-                auto result = task();
-                done = true;
-                return result;
-            });
+            auto future = default_pool().submit([&task]() { return task(); });
 
             echo::spinner spin(m_model.style);
             spin.set_message(m_model.title);
@@ -92,10 +93,10 @@ namespace scan {
                 spin.set_color(m_model.color);
             }
 
-            while (!done) {
+            // Waiting on the future (not a flag) also ends the animation if the task throws
+            do {
                 spin.tick();
-                std::this_thread::sleep_for(std::chrono::milliseconds(spin.get_interval_ms()));
-            }
+            } while (future.wait_for(std::chrono::milliseconds(spin.get_interval_ms())) != std::future_status::ready);
 
             spin.stop();
             terminal::show_cursor();
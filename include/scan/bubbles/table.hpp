@@ -43,14 +43,14 @@ namespace scan {
         bool cancelled = false;
 
         TableModel() {
-            auto &t = current_theme();
-            header_fg = t.colors.text;
-            header_bg = t.colors.bg_muted;
-            selected_fg = t.colors.text_inverted;
-            selected_bg = t.colors.primary;
-            row_fg = t.colors.text;
-            border_color = t.colors.border;
-            muted_color = t.colors.text_muted;
+            auto t = theme_snapshot();
+            header_fg = t->colors.text;
+            header_bg = t->colors.bg_muted;
+            selected_fg = t->colors.text_inverted;
+            selected_bg = t->colors.primary;
+            row_fg = t->colors.text;
+            border_color = t->colors.border;
+            muted_color = t->colors.text_muted;
         }
     };
 
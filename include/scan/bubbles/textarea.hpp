@@ -41,11 +41,11 @@ namespace scan {
         bool cancelled = false;
 
         TextAreaModel() {
-            auto &t = current_theme();
-            text_color = t.colors.text;
-            line_number_color = t.colors.text_muted;
-            placeholder_color = t.colors.text_subtle;
-            muted_color = t.colors.text_muted;
+            auto t = theme_snapshot();
+            text_color = t->colors.text;
+            line_number_color = t->colors.text_muted;
+            placeholder_color = t->colors.text_subtle;
+            muted_color = t->colors.text_muted;
         }
     };
 
@@ -39,11 +39,11 @@ namespace scan {
         bool cancelled = false;
 
         TextInputModel() {
-            auto &t = current_theme();
-            prompt_color = t.colors.primary;
-            text_color = t.colors.text;
-            placeholder_color = t.colors.text_subtle;
-            cursor_color = t.colors.primary;
+            auto t = theme_snapshot();
+            prompt_color = t->colors.primary;
+            text_color = t->colors.text;
+            placeholder_color = t->colors.text_subtle;
+            cursor_color = t->colors.primary;
         }
     };
 
@@ -0,0 +1,590 @@
+#pragma once
+
+/// @file tree.hpp
+/// @brief Tree component with lazily loaded children for very large hierarchies
+
+#include <scan/input/key.hpp>
+#include <scan/style/style.hpp>
+#include <scan/tea/cmd.hpp>
+#include <scan/tea/msg.hpp>
+#include <scan/tea/program.hpp>
+#include <scan/tea/task.hpp>
+
+#include <algorithm>
+#include <any>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace scan {
+
+    /// A node as supplied by the caller
+    struct TreeItem {
+        std::string label;         // Text shown in the tree
+        std::string key;           // Opaque handle for the loader (path, object id, ...)
+        bool has_children = false; // Node can be expanded; children are loaded on first expand
+
+        TreeItem() = default;
+        TreeItem(const std::string &l, bool children = false) : label(l), has_children(children) {}
+        TreeItem(const std::string &l, const std::string &k, bool children) : label(l), key(k), has_children(children) {}
+    };
+
+    /// Produces the children of an item; may run on a background thread when async loading is enabled
+    using TreeLoader = std::function<std::vector<TreeItem>(const TreeItem &parent)>;
+
+    /// Children loaded in the background, delivered as the value of a tea::TaskMsg
+    struct TreeLoadResult {
+        uint32_t node = 0;
+        std::vector<TreeItem> children;
+        std::string error;
+    };
+
+    struct TreeModel {
+        enum class LoadState : uint8_t { Unloaded, Loading, Loaded, Failed };
+
+        struct Node {
+            TreeItem item;
+            uint32_t parent = 0;
+            uint32_t index = 0; // Position among the parent's children
+            uint32_t depth = 0;
+            bool expanded = false;
+            LoadState state = LoadState::Unloaded;
+            std::string error;
+            std::vector<uint32_t> children;
+
+            // Visible rows in this subtree, the node itself included
+            uint32_t rows = 1;
+            // Fenwick tree over the children's row counts (1-based)
+            std::vector<uint32_t> child_rows;
+        };
+
+        // Node 0 is a hidden root whose children are the top-level items
+        std::vector<Node> nodes;
+
+        TreeLoader loader;
+        bool async = false;
+        int id = 0; // Matched against TaskMsg ids
+
+        size_t cursor = 0; // Row index
+        size_t offset = 0;
+        int height = 15;
+        int width = 0; // Labels are truncated to this width when > 0
+
+        // Styling - uses theme
+        Color cursor_color;
+        Color branch_color;
+        Color leaf_color;
+        Color guide_color;
+        Color muted_color;
+        Color error_color;
+
+        // State
+        bool submitted = false;
+        bool cancelled = false;
+
+        TreeModel() {
+            nodes.emplace_back();
+            nodes[0].rows = 0;
+            nodes[0].expanded = true;
+            nodes[0].state = LoadState::Loaded;
+
+            auto t = theme_snapshot();
+            cursor_color = t->colors.primary;
+            branch_color = t->colors.secondary;
+            leaf_color = t->colors.text;
+            guide_color = t->colors.text_subtle;
+            muted_color = t->colors.text_muted;
+            error_color = t->colors.error;
+        }
+    };
+
+    namespace detail {
+
+        inline void fenwick_add(std::vector<uint32_t> &tree, size_t index, int64_t delta) {
+            for (size_t i = index + 1; i < tree.size(); i += i & (~i + 1)) {
+                tree[i] = static_cast<uint32_t>(static_cast<int64_t>(tree[i]) + delta);
+            }
+        }
+
+        /// Sum of the first count entries
+        inline uint64_t fenwick_prefix(const std::vector<uint32_t> &tree, size_t count) {
+            uint64_t sum = 0;
+            for (size_t i = count; i > 0; i -= i & (~i + 1)) {
+                sum += tree[i];
+            }
+            return sum;
+        }
+
+        /// Entry containing position pos (entries are all >= 1); pos becomes the offset inside it
+        inline size_t fenwick_find(const std::vector<uint32_t> &tree, uint64_t &pos) {
+            size_t n = tree.size() - 1;
+            size_t idx = 0;
+            size_t step = 1;
+            while (step * 2 <= n) {
+                step *= 2;
+            }
+            for (; step > 0; step /= 2) {
+                if (idx + step <= n && tree[idx + step] <= pos) {
+                    idx += step;
+                    pos -= tree[idx];
+                }
+            }
+            return idx;
+        }
+
+    } // namespace detail
+
+    /// Total number of rows currently shown (expanded subtrees included)
+    inline size_t tree_row_count(const TreeModel &m) { return m.nodes[0].rows; }
+
+    /// Apply a change in visible rows of node x to x and all of its ancestors - O(depth log n)
+    inline void tree_propagate(TreeModel &m, uint32_t x, int64_t delta) {
+        if (delta == 0) {
+            return;
+        }
+        m.nodes[x].rows = static_cast<uint32_t>(m.nodes[x].rows + delta);
+        while (x != 0) {
+            auto &node = m.nodes[x];
+            auto &parent = m.nodes[node.parent];
+            detail::fenwick_add(parent.child_rows, node.index, delta);
+            if (!parent.expanded) {
+                return; // Hidden subtree: ancestors don't see this node's rows
+            }
+            x = node.parent;
+            m.nodes[x].rows = static_cast<uint32_t>(m.nodes[x].rows + delta);
+        }
+    }
+
+    /// Attach loaded children to a node - O(children)
+    inline void tree_set_children(TreeModel &m, uint32_t parent, const std::vector<TreeItem> &items) {
+        uint32_t depth = parent == 0 ? 0 : m.nodes[parent].depth + 1;
+        auto first = static_cast<uint32_t>(m.nodes.size());
+        m.nodes.reserve(m.nodes.size() + items.size());
+        for (size_t i = 0; i < items.size(); i++) {
+            TreeModel::Node node;
+            node.item = items[i];
+            node.parent = parent;
+            node.index = static_cast<uint32_t>(i);
+            node.depth = depth;
+            node.state = items[i].has_children ? TreeModel::LoadState::Unloaded : TreeModel::LoadState::Loaded;
+            m.nodes.push_back(std::move(node));
+        }
+
+        auto &p = m.nodes[parent];
+        p.state = TreeModel::LoadState::Loaded;
+        p.error.clear();
+        p.children.resize(items.size());
+        // Linear Fenwick construction: every new child contributes one row
+        p.child_rows.assign(items.size() + 1, 0);
+        for (size_t i = 1; i <= items.size(); i++) {
+            p.children[i - 1] = first + static_cast<uint32_t>(i - 1);
+            p.child_rows[i] += 1;
+            size_t j = i + (i & (~i + 1));
+            if (j <= items.size()) {
+                p.child_rows[j] += p.child_rows[i];
+            }
+        }
+
+        if (p.expanded) {
+            tree_propagate(m, parent, static_cast<int64_t>(items.size()));
+        }
+    }
+
+    /// Replace the top-level items
+    inline void tree_set_roots(TreeModel &m, const std::vector<TreeItem> &items) {
+        m.nodes.resize(1);
+        m.nodes[0].rows = 0;
+        m.nodes[0].children.clear();
+        m.cursor = 0;
+        m.offset = 0;
+        tree_set_children(m, 0, items);
+    }
+
+    /// Row index of a node - O(depth log n); the node must be visible
+    inline size_t tree_row_of(const TreeModel &m, uint32_t x) {
+        size_t row = 0;
+        while (x != 0) {
+            const auto &node = m.nodes[x];
+            row += detail::fenwick_prefix(m.nodes[node.parent].child_rows, node.index);
+            x = node.parent;
+            if (x != 0) {
+                row += 1; // The parent's own row
+            }
+        }
+        return row;
+    }
+
+    /// Node shown at a row - O(depth log n)
+    inline uint32_t tree_node_at(const TreeModel &m, size_t row) {
+        uint32_t x = 0;
+        uint64_t pos = row;
+        while (true) {
+            if (x != 0) {
+                if (pos == 0) {
+                    return x;
+                }
+                pos -= 1;
+            }
+            const auto &node = m.nodes[x];
+            if (!node.expanded || node.children.empty()) {
+                return x;
+            }
+            x = node.children[detail::fenwick_find(node.child_rows, pos)];
+        }
+    }
+
+    /// True if every ancestor of a node is expanded
+    inline bool tree_is_visible(const TreeModel &m, uint32_t x) {
+        for (x = m.nodes[x].parent; x != 0; x = m.nodes[x].parent) {
+            if (!m.nodes[x].expanded) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Node on the row after x, or 0 at the end - amortized O(1) when walking rows in order
+    inline uint32_t tree_next_row(const TreeModel &m, uint32_t x) {
+        const auto &node = m.nodes[x];
+        if (node.expanded && !node.children.empty()) {
+            return node.children[0];
+        }
+        while (x != 0) {
+            const auto &n = m.nodes[x];
+            const auto &parent = m.nodes[n.parent];
+            if (n.index + 1 < parent.children.size()) {
+                return parent.children[n.index + 1];
+            }
+            x = n.parent;
+        }
+        return 0;
+    }
+
+    /// Labels from the top level down to a node
+    inline std::vector<std::string> tree_path(const TreeModel &m, uint32_t x) {
+        std::vector<std::string> path;
+        for (; x != 0; x = m.nodes[x].parent) {
+            path.push_back(m.nodes[x].item.label);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    inline void tree_clamp_offset(TreeModel &m) {
+        size_t visible = m.height > 0 ? static_cast<size_t>(m.height) : tree_row_count(m);
+        if (m.cursor < m.offset) {
+            m.offset = m.cursor;
+        } else if (visible > 0 && m.cursor >= m.offset + visible) {
+            m.offset = m.cursor - visible + 1;
+        }
+        size_t count = tree_row_count(m);
+        if (count <= visible) {
+            m.offset = 0;
+        } else {
+            m.offset = std::min(m.offset, count - visible);
+        }
+    }
+
+    /// Move the cursor to a row, scrolling as needed
+    inline void tree_move_to(TreeModel &m, size_t row) {
+        size_t count = tree_row_count(m);
+        m.cursor = count == 0 ? 0 : std::min(row, count - 1);
+        tree_clamp_offset(m);
+    }
+
+    /// Add children that finished loading, keeping the cursor on the same node
+    inline void tree_apply_load(TreeModel &m, const TreeLoadResult &result) {
+        if (result.node >= m.nodes.size() || m.nodes[result.node].state != TreeModel::LoadState::Loading) {
+            return;
+        }
+        if (!result.error.empty()) {
+            m.nodes[result.node].state = TreeModel::LoadState::Failed;
+            m.nodes[result.node].error = result.error;
+            return;
+        }
+        // Rows appear below the loaded node; if that is above the cursor, follow the cursor's node
+        bool shifts_cursor = m.nodes[result.node].expanded && tree_is_visible(m, result.node) &&
+                             tree_row_of(m, result.node) < m.cursor;
+        tree_set_children(m, result.node, result.children);
+        if (shifts_cursor) {
+            m.cursor += result.children.size();
+        }
+        tree_clamp_offset(m);
+    }
+
+    /// Run the loader for a node, synchronously or in the background
+    inline tea::Cmd tree_load(TreeModel &m, uint32_t x) {
+        auto &node = m.nodes[x];
+        if (!m.loader) {
+            tree_set_children(m, x, {});
+            return tea::none();
+        }
+        node.state = TreeModel::LoadState::Loading;
+
+        auto run = [loader = m.loader, item = node.item, x]() {
+            TreeLoadResult result;
+            result.node = x;
+            try {
+                result.children = loader(item);
+            } catch (const std::exception &e) {
+                result.error = e.what();
+            }
+            return result;
+        };
+
+        if (!m.async) {
+            tree_apply_load(m, run());
+            return tea::none();
+        }
+        int id = m.id;
+        return tea::async([run, id]() -> std::optional<tea::Msg> { return tea::TaskMsg{id, run()}; });
+    }
+
+    /// Expand a node, loading its children on first use
+    /// Re-expanding keeps previously expanded descendants and costs O(depth log n).
+    inline tea::Cmd tree_expand(TreeModel &m, uint32_t x) {
+        auto &node = m.nodes[x];
+        if (x == 0 || node.expanded || !node.item.has_children) {
+            return tea::none();
+        }
+        node.expanded = true;
+        tree_propagate(m, x, static_cast<int64_t>(detail::fenwick_prefix(node.child_rows, node.children.size())));
+        tea::Cmd cmd = tea::none();
+        if (node.state == TreeModel::LoadState::Unloaded || node.state == TreeModel::LoadState::Failed) {
+            cmd = tree_load(m, x);
+        }
+        tree_clamp_offset(m);
+        return cmd;
+    }
+
+    /// Collapse a node - O(depth log n), descendants keep their expansion state
+    inline void tree_collapse(TreeModel &m, uint32_t x) {
+        auto &node = m.nodes[x];
+        if (x == 0 || !node.expanded) {
+            return;
+        }
+        int64_t hidden = static_cast<int64_t>(node.rows) - 1;
+        node.expanded = false;
+        tree_propagate(m, x, -hidden);
+        tree_clamp_offset(m);
+    }
+
+    inline std::pair<TreeModel, tea::Cmd> tree_update(TreeModel m, const tea::Msg &msg) {
+        if (auto *task = tea::try_as<tea::TaskMsg>(msg)) {
+            if (task->id == m.id) {
+                if (auto *result = std::any_cast<TreeLoadResult>(&task->value)) {
+                    tree_apply_load(m, *result);
+                }
+            }
+            return {std::move(m), tea::none()};
+        }
+
+        auto *key = tea::try_as<tea::KeyMsg>(msg);
+        if (!key) {
+            return {std::move(m), tea::none()};
+        }
+
+        size_t count = tree_row_count(m);
+        if (key->key == input::Key::Escape || key->key == input::Key::CtrlC ||
+            (key->key == input::Key::Rune && key->rune == 'q')) {
+            m.cancelled = true;
+            return {std::move(m), tea::quit()};
+        }
+        if (count == 0) {
+            return {std::move(m), tea::none()};
+        }
+
+        size_t page = m.height > 0 ? static_cast<size_t>(m.height) : 10;
+        uint32_t current = tree_node_at(m, m.cursor);
+        char32_t rune = key->key == input::Key::Rune ? key->rune : 0;
+
+        if (key->key == input::Key::Up || key->key == input::Key::CtrlP || rune == 'k') {
+            tree_move_to(m, m.cursor > 0 ? m.cursor - 1 : 0);
+        } else if (key->key == input::Key::Down || key->key == input::Key::CtrlN || rune == 'j') {
+            tree_move_to(m, m.cursor + 1);
+        } else if (key->key == input::Key::PageUp) {
+            tree_move_to(m, m.cursor >= page ? m.cursor - page : 0);
+        } else if (key->key == input::Key::PageDown) {
+            tree_move_to(m, m.cursor + page);
+        } else if (key->key == input::Key::Home || rune == 'g') {
+            tree_move_to(m, 0);
+        } else if (key->key == input::Key::End || rune == 'G') {
+            tree_move_to(m, count - 1);
+        } else if (key->key == input::Key::Right || rune == 'l') {
+            auto &node = m.nodes[current];
+            if (node.expanded && !node.children.empty()) {
+                tree_move_to(m, m.cursor + 1);
+            } else {
+                return {std::move(m), tree_expand(m, current)};
+            }
+        } else if (key->key == input::Key::Left || rune == 'h') {
+            auto &node = m.nodes[current];
+            if (node.expanded) {
+                tree_collapse(m, current);
+            } else if (node.parent != 0) {
+                tree_move_to(m, tree_row_of(m, node.parent));
+            }
+        } else if (key->key == input::Key::Space || key->key == input::Key::Tab) {
+            if (m.nodes[current].expanded) {
+                tree_collapse(m, current);
+            } else {
+                return {std::move(m), tree_expand(m, current)};
+            }
+        } else if (key->key == input::Key::Enter) {
+            m.submitted = true;
+            return {std::move(m), tea::quit()};
+        }
+
+        return {std::move(m), tea::none()};
+    }
+
+    inline std::string tree_view(const TreeModel &m) {
+        size_t count = tree_row_count(m);
+        if (count == 0) {
+            return Style().foreground(m.muted_color).italic().render("(empty)");
+        }
+
+        std::string view;
+        size_t visible = m.height > 0 ? static_cast<size_t>(m.height) : count;
+        size_t start = m.offset;
+        size_t end = std::min(start + visible, count);
+
+        // One O(depth log n) lookup, then walk forward row by row
+        uint32_t x = tree_node_at(m, start);
+        std::vector<bool> last; // Per ancestor level: was it its parent's last child
+        for (size_t row = start; row < end && x != 0; row++, x = tree_next_row(m, x)) {
+            const auto &node = m.nodes[x];
+            bool is_cursor = row == m.cursor;
+
+            // Guides: one column pair per ancestor below the top level
+            last.assign(node.depth, false);
+            for (uint32_t a = x, d = node.depth; d > 0; d--) {
+                const auto &n = m.nodes[a];
+                last[d - 1] = n.index + 1 == m.nodes[n.parent].children.size();
+                a = n.parent;
+            }
+            std::string guide;
+            for (uint32_t d = 1; d < node.depth; d++) {
+                guide += last[d - 1] ? "   " : "│  ";
+            }
+            if (node.depth > 0) {
+                guide += last[node.depth - 1] ? "└─ " : "├─ ";
+            }
+
+            std::string line = is_cursor ? Style().foreground(m.cursor_color).bold().render("> ") : "  ";
+            if (!guide.empty()) {
+                line += Style().foreground(m.guide_color).render(guide);
+            }
+
+            std::string marker = node.item.has_children ? (node.expanded ? "▾ " : "▸ ") : "  ";
+            std::string label = node.item.label;
+            if (m.width > 0) {
+                size_t used = 2 + node.depth * 3 + 2;
+                size_t room = static_cast<size_t>(m.width) > used ? static_cast<size_t>(m.width) - used : 1;
+                label = truncate(label, room);
+            }
+
+            Style label_style;
+            if (is_cursor) {
+                label_style.foreground(m.cursor_color).bold();
+            } else if (node.item.has_children) {
+                label_style.foreground(m.branch_color);
+            } else {
+                label_style.foreground(m.leaf_color);
+            }
+            line += Style().foreground(m.branch_color).render(marker) + label_style.render(label);
+
+            if (node.expanded && node.state == TreeModel::LoadState::Loading) {
+                line += Style().foreground(m.muted_color).italic().render("  loading...");
+            } else if (node.state == TreeModel::LoadState::Failed) {
+                line += Style().foreground(m.error_color).render("  " + node.error);
+            } else if (node.expanded && node.children.empty()) {
+                line += Style().foreground(m.muted_color).italic().render("  (empty)");
+            }
+
+            view += line;
+            if (row + 1 < end) {
+                view += "\n";
+            }
+        }
+
+        if (end < count || start > 0) {
+            view += "\n";
+            view += Style().foreground(m.muted_color).faint().render("  " + std::to_string(m.cursor + 1) + "/" +
+                                                                     std::to_string(count));
+        }
+
+        return view;
+    }
+
+    /// Builder class for Tree component
+    class Tree {
+      public:
+        /// Top-level items
+        Tree &items(const std::vector<TreeItem> &roots) {
+            m_roots = roots;
+            return *this;
+        }
+
+        /// Called with an item the first time it is expanded
+        Tree &loader(TreeLoader fn) {
+            m_model.loader = std::move(fn);
+            return *this;
+        }
+
+        /// Run the loader on a background thread so the UI stays responsive
+        Tree &async(bool enable = true) {
+            m_model.async = enable;
+            return *this;
+        }
+
+        Tree &height(int h) {
+            m_model.height = h;
+            return *this;
+        }
+
+        Tree &width(int w) {
+            m_model.width = w;
+            return *this;
+        }
+
+        Tree &cursor_color(int r, int g, int b) {
+            m_model.cursor_color = {r, g, b};
+            return *this;
+        }
+
+        /// Returns the chosen item, or nullopt if cancelled
+        std::optional<TreeItem> run() {
+            tree_set_roots(m_model, m_roots);
+
+            auto init = [this]() -> std::pair<TreeModel, tea::Cmd> { return {m_model, tea::none()}; };
+            auto update = [](TreeModel m, tea::Msg msg) { return tree_update(std::move(m), msg); };
+            auto view = [](const TreeModel &m) { return tree_view(m); };
+
+            auto final_model = tea::Program<TreeModel>(init, update, view).run();
+            m_path.clear();
+
+            if (final_model.cancelled || !final_model.submitted || tree_row_count(final_model) == 0) {
+                return std::nullopt;
+            }
+            uint32_t x = tree_node_at(final_model, final_model.cursor);
+            m_path = tree_path(final_model, x);
+            return final_model.nodes[x].item;
+        }
+
+        /// Labels from the top level down to the item chosen in the last run()
+        const std::vector<std::string> &path() const { return m_path; }
+
+        TreeModel &model() { return m_model; }
+        const TreeModel &model() const { return m_model; }
+
+      private:
+        TreeModel m_model;
+        std::vector<TreeItem> m_roots;
+        std::vector<std::string> m_path;
+    };
+
+} // namespace scan
@@ -9,14 +9,165 @@
 #include <scan/tea/msg.hpp>
 
 #include <algorithm>
-#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace scan {
 
+    /// Viewport content: shared, immutable text chunks plus a line-offset index
+    ///
+    /// Setting content keeps the string as one chunk and scans it once for
+    /// newlines; lines are handed out as string_views into it, never copied.
+    /// Copies of the model share the chunks and the index, so copying costs a
+    /// reference count. Appended lines go into a tail chunk with reserved
+    /// capacity, which never moves bytes already written. A copy that is
+    /// modified while shared first clones the index (not the text) for
+    /// itself. Dropping lines from the front only moves a start index;
+    /// memory is reclaimed in batches.
+    class ViewportLines {
+      public:
+        class iterator {
+          public:
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+
+            iterator(const ViewportLines *lines, size_t i) : m_lines(lines), m_i(i) {}
+            std::string_view operator*() const { return (*m_lines)[m_i]; }
+            iterator &operator++() {
+                m_i++;
+                return *this;
+            }
+            bool operator==(const iterator &o) const { return m_i == o.m_i; }
+            bool operator!=(const iterator &o) const { return m_i != o.m_i; }
+
+          private:
+            const ViewportLines *m_lines;
+            size_t m_i;
+        };
+
+        size_t size() const { return m_data ? m_data->starts.size() - 1 - m_first : 0; }
+        bool empty() const { return size() == 0; }
+
+        std::string_view operator[](size_t i) const {
+            const Data &d = *m_data;
+            size_t j = m_first + i;
+            uint64_t start = d.starts[j] & offset_mask;
+            uint64_t end = (d.starts[j + 1] & offset_mask) - ((d.starts[j] & newline_bit) ? 1 : 0);
+            size_t c = d.chunks.size() == 1
+                           ? 0
+                           : static_cast<size_t>(std::upper_bound(d.bases.begin(), d.bases.end(), start) - d.bases.begin()) - 1;
+            return std::string_view(d.chunks[c]->data() + (start - d.bases[c]), static_cast<size_t>(end - start));
+        }
+
+        std::string_view front() const { return (*this)[0]; }
+        std::string_view back() const { return (*this)[size() - 1]; }
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, size()); }
+
+        void clear() {
+            m_data.reset();
+            m_first = 0;
+        }
+
+        /// Replace the content with `text`, split at newlines and, if `wrap_width` > 0, every `wrap_width` bytes
+        void assign(std::shared_ptr<const std::string> text, size_t wrap_width = 0) {
+            auto d = std::make_shared<Data>();
+            d->starts.clear();
+            const char *p = text->data();
+            size_t n = text->size();
+            size_t pos = 0;
+            while (pos < n) {
+                const void *nl = std::memchr(p + pos, '\n', n - pos);
+                size_t end = nl ? static_cast<size_t>(static_cast<const char *>(nl) - p) : n;
+                if (wrap_width > 0) {
+                    for (; end - pos > wrap_width; pos += wrap_width) {
+                        d->starts.push_back(pos);
+                    }
+                }
+                d->starts.push_back(nl ? (pos | newline_bit) : pos);
+                pos = nl ? end + 1 : end;
+            }
+            d->starts.push_back(n);
+            d->bases.push_back(0);
+            d->chunks.push_back(std::move(text));
+            m_data = std::move(d);
+            m_first = 0;
+        }
+
+        /// Append one line (without its newline)
+        void push_back(std::string_view line) {
+            Data &d = writable();
+            uint64_t start = d.starts.back();
+            // Append in place only while no other copy's data references the tail chunk (held here by tail and
+            // chunks.back()); a copy may be rendering it on another thread
+            if (!d.tail || d.tail.use_count() > 2 || d.tail->capacity() - d.tail->size() < line.size()) {
+                auto chunk = std::make_shared<std::string>();
+                chunk->reserve(std::max(tail_chunk_size, line.size()));
+                d.tail = chunk;
+                d.bases.push_back(start);
+                d.chunks.push_back(std::move(chunk));
+            }
+            d.tail->append(line);
+            d.starts.push_back(start + line.size());
+        }
+
+        /// Forget the first n lines
+        void drop_front(size_t n) {
+            m_first += std::min(n, size());
+            if (m_first >= 4096 && m_first > size() && m_data.use_count() == 1) {
+                compact();
+            }
+        }
+
+      private:
+        static constexpr uint64_t newline_bit = uint64_t{1} << 63; // A newline follows the line
+        static constexpr uint64_t offset_mask = ~newline_bit;
+        static constexpr size_t tail_chunk_size = 64 * 1024;
+
+        struct Data {
+            std::vector<std::shared_ptr<const std::string>> chunks;
+            std::vector<uint64_t> bases;  // Offset of each chunk's first byte in the concatenated text
+            std::vector<uint64_t> starts; // Offset of each line's first byte, then the end of the text
+            std::shared_ptr<std::string> tail; // Last chunk, if lines can still be appended to it in place
+
+            Data() { starts.push_back(0); }
+        };
+
+        /// The data, cloned first if other copies share it
+        Data &writable() {
+            if (!m_data) {
+                m_data = std::make_shared<Data>();
+            } else if (m_data.use_count() > 1) {
+                auto d = std::make_shared<Data>(*m_data);
+                d->tail.reset(); // The shared tail keeps growing for its other owners only
+                m_data = std::move(d);
+            }
+            return *m_data;
+        }
+
+        /// Release the dropped lines' index entries and any chunk they alone used
+        void compact() {
+            Data &d = *m_data;
+            auto first = static_cast<std::ptrdiff_t>(m_first);
+            d.starts.erase(d.starts.begin(), d.starts.begin() + first);
+            m_first = 0;
+            uint64_t start = d.starts.front() & offset_mask;
+            size_t keep = static_cast<size_t>(std::upper_bound(d.bases.begin(), d.bases.end(), start) - d.bases.begin()) - 1;
+            auto drop = static_cast<std::ptrdiff_t>(keep);
+            d.chunks.erase(d.chunks.begin(), d.chunks.begin() + drop);
+            d.bases.erase(d.bases.begin(), d.bases.begin() + drop);
+        }
+
+        std::shared_ptr<Data> m_data;
+        size_t m_first = 0; // Lines dropped from the front
+    };
+
     struct ViewportModel {
-        std::vector<std::string> lines;
+        ViewportLines lines;
         int width = 80;
         int height = 20;
         int y_offset = 0;
@@ -28,33 +179,46 @@ namespace scan {
         Color scroll_indicator_color;
 
         ViewportModel() {
-            auto &t = current_theme();
-            text_color = t.colors.text;
-            scroll_indicator_color = t.colors.text_muted;
+            auto t = theme_snapshot();
+            text_color = t->colors.text;
+            scroll_indicator_color = t->colors.text_muted;
         }
     };
 
-    inline void viewport_set_content(ViewportModel &m, const std::string &content) {
-        m.lines.clear();
-        std::istringstream iss(content);
-        std::string line;
-        while (std::getline(iss, line)) {
-            if (m.wrap && static_cast<int>(line.length()) > m.width) {
-                size_t pos = 0;
-                while (pos < line.length()) {
-                    size_t end = std::min(pos + static_cast<size_t>(m.width), line.length());
-                    m.lines.push_back(line.substr(pos, end - pos));
-                    pos = end;
-                }
-            } else {
-                m.lines.push_back(line);
+    /// Append one line of content, wrapping it at the viewport width if enabled
+    inline void viewport_append_line(ViewportModel &m, std::string_view line) {
+        if (m.wrap && m.width > 0 && static_cast<int>(line.length()) > m.width) {
+            size_t pos = 0;
+            while (pos < line.length()) {
+                size_t end = std::min(pos + static_cast<size_t>(m.width), line.length());
+                m.lines.push_back(line.substr(pos, end - pos));
+                pos = end;
             }
+        } else {
+            m.lines.push_back(line);
         }
+    }
+
+    /// Remove the first n lines, keeping the view anchored on the same content
+    inline void viewport_drop_front(ViewportModel &m, size_t n) {
+        n = std::min(n, m.lines.size());
+        m.lines.drop_front(n);
+        m.y_offset = std::max(0, m.y_offset - static_cast<int>(n));
+    }
+
+    /// Show a shared buffer without copying it; several viewports may show the same one
+    inline void viewport_set_content(ViewportModel &m, std::shared_ptr<const std::string> content) {
+        m.lines.assign(std::move(content), m.wrap && m.width > 0 ? static_cast<size_t>(m.width) : 0);
         if (m.lines.empty()) {
             m.lines.push_back("");
         }
     }
 
+    /// Take the content (moved in, or copied once) and index its lines in a single pass
+    inline void viewport_set_content(ViewportModel &m, std::string content) {
+        viewport_set_content(m, std::make_shared<const std::string>(std::move(content)));
+    }
+
     inline void viewport_scroll_down(ViewportModel &m, int n = 1) {
         int max_offset = std::max(0, static_cast<int>(m.lines.size()) - m.height);
         m.y_offset = std::min(m.y_offset + n, max_offset);
@@ -179,13 +343,13 @@ namespace scan {
                 view += "\n";
             }
 
-            std::string line = m.lines[i];
+            std::string_view line = m.lines[i];
 
             if (!m.wrap && m.x_offset > 0) {
                 if (static_cast<int>(line.length()) > m.x_offset) {
                     line = line.substr(m.x_offset);
                 } else {
-                    line = "";
+                    line = {};
                 }
             }
 
@@ -193,7 +357,7 @@ namespace scan {
                 line = line.substr(0, m.width);
             }
 
-            view += Style().foreground(m.text_color).render(line);
+            view += Style().foreground(m.text_color).render(std::string(line));
         }
 
         return view;
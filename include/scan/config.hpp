@@ -0,0 +1,19 @@
+#pragma once
+
+/// @file scan/config.hpp
+/// @brief Header-only or compiled-library build switch
+///
+/// Scan is header-only by default. When SCAN_COMPILED_LIB is defined (the CMake
+/// option SCAN_HEADER_ONLY=OFF does this), headers that have an `_impl.hpp`
+/// counterpart keep only declarations, and the definitions are compiled once
+/// into the library from src/scan/scan.cpp.
+
+#if !defined(SCAN_COMPILED_LIB) && !defined(SCAN_HEADER_ONLY)
+#define SCAN_HEADER_ONLY
+#endif
+
+#ifdef SCAN_HEADER_ONLY
+#define SCAN_INLINE inline
+#else
+#define SCAN_INLINE
+#endif
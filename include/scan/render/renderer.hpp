@@ -27,47 +27,78 @@ namespace scan::render {
 
     /// Renderer for TUI output
     /// Handles efficient updates by tracking previously rendered content
+    ///
+    /// Only lines that differ from the previous frame are rewritten, so a
+    /// keystroke in one field of a 30-line form redraws one line, not 30.
     class Renderer {
       public:
-        /// Render new content, clearing previous output first
+        /// Render new content over the previous output
         void render(const std::string &content) {
-            // Clear previous output
-            if (m_lines_rendered > 0) {
-                // Move to start of current line, then clear upward
-                terminal::cursor_to_column(1);
-                for (int i = 0; i < m_lines_rendered; i++) {
-                    if (i > 0) {
-                        terminal::cursor_up(1);
-                    }
-                    terminal::clear_line();
-                }
-                // Ensure cursor is at column 1 after clearing
-                terminal::cursor_to_column(1);
+            if (!m_lines.empty() && content == m_last_content) {
+                return;
             }
 
-            // Split content into lines
             auto lines = split_lines(content);
+            if (lines.empty()) {
+                lines.emplace_back();
+            }
 
-            // Write new content
-            for (size_t i = 0; i < lines.size(); i++) {
-                if (i > 0) {
-                    std::fputc('\n', stdout);
+            if (m_lines.empty()) {
+                // First frame (or after repaint): write everything
+                for (size_t i = 0; i < lines.size(); i++) {
+                    if (i > 0) {
+                        std::fputc('\n', stdout);
+                    }
+                    std::fputs("\r", stdout); // Carriage return to ensure column 1
+                    terminal::write(lines[i]);
+                }
+            } else {
+                // The cursor sits on the last line of the previous frame
+                size_t old_n = m_lines.size();
+                size_t new_n = lines.size();
+                size_t row = old_n - 1;
+                auto move_to = [&](size_t target) {
+                    if (target < row) {
+                        terminal::cursor_up(static_cast<int>(row - target));
+                    } else if (target > row) {
+                        terminal::cursor_down(static_cast<int>(target - row));
+                    }
+                    row = target;
+                };
+
+                for (size_t i = 0; i < std::max(old_n, new_n); i++) {
+                    bool changed = i >= old_n || i >= new_n || lines[i] != m_lines[i];
+                    if (!changed) {
+                        continue;
+                    }
+                    if (i < old_n) {
+                        move_to(i);
+                    } else {
+                        if (row < old_n - 1) {
+                            move_to(old_n - 1);
+                        }
+                        for (; row < i; row++) {
+                            std::fputc('\n', stdout); // New lines scroll the terminal if needed
+                        }
+                    }
+                    std::fputs("\r", stdout);
+                    terminal::clear_line();
+                    if (i < new_n) {
+                        terminal::write(lines[i]);
+                    }
                 }
-                std::fputs("\r", stdout); // Carriage return to ensure column 1
-                terminal::write(lines[i]);
+                move_to(new_n - 1);
             }
             std::fflush(stdout);
 
-            // Track lines rendered
-            m_lines_rendered = static_cast<int>(lines.size());
-            if (m_lines_rendered > 0 && lines.back().empty()) {
-                m_lines_rendered--; // Don't count trailing empty line
-            }
+            m_lines = std::move(lines);
+            m_lines_rendered = static_cast<int>(m_lines.size());
             m_last_content = content;
         }
 
-        /// Force a full repaint (clears screen)
+        /// Force a full repaint: the next render writes every line below the cursor
         void repaint() {
+            m_lines.clear();
             m_lines_rendered = 0;
             m_last_content.clear();
         }
@@ -83,6 +114,7 @@ namespace scan::render {
                     terminal::clear_line();
                 }
             }
+            m_lines.clear();
             m_lines_rendered = 0;
             m_last_content.clear();
             std::fflush(stdout);
@@ -95,6 +127,7 @@ namespace scan::render {
         const std::string &last_content() const { return m_last_content; }
 
       private:
+        std::vector<std::string> m_lines;
         int m_lines_rendered = 0;
         std::string m_last_content;
     };
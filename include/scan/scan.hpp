@@ -17,8 +17,11 @@
 #include <echo/echo.hpp>
 
 #include <scan/tea/cmd.hpp>
+#include <scan/tea/compose.hpp>
+#include <scan/tea/exec.hpp>
 #include <scan/tea/msg.hpp>
 #include <scan/tea/program.hpp>
+#include <scan/tea/task.hpp>
 
 #include <scan/terminal/alt_screen.hpp>
 #include <scan/terminal/raw_mode.hpp>
@@ -29,20 +32,31 @@
 
 #include <scan/render/renderer.hpp>
 
+#include <scan/bubbles/chart.hpp>
 #include <scan/bubbles/confirm.hpp>
+#include <scan/bubbles/diffview.hpp>
+#include <scan/bubbles/execview.hpp>
 #include <scan/bubbles/filepicker.hpp>
 #include <scan/bubbles/filter.hpp>
+#include <scan/bubbles/form.hpp>
+#include <scan/bubbles/hexview.hpp>
 #include <scan/bubbles/list.hpp>
+#include <scan/bubbles/logview.hpp>
 #include <scan/bubbles/pager.hpp>
 #include <scan/bubbles/spinner.hpp>
 #include <scan/bubbles/table.hpp>
 #include <scan/bubbles/textarea.hpp>
 #include <scan/bubbles/textinput.hpp>
+#include <scan/bubbles/tree.hpp>
 #include <scan/bubbles/viewport.hpp>
 
 #include <scan/style/style.hpp>
 
+#include <scan/util/bytes.hpp>
+#include <scan/util/diff.hpp>
 #include <scan/util/fuzzy.hpp>
+#include <scan/util/mapped_file.hpp>
+#include <scan/util/thread_pool.hpp>
 #include <scan/util/utf8.hpp>
 
 namespace scan {
@@ -3,6 +3,10 @@
 /// @file theme.hpp
 /// @brief Unified theme system for consistent styling across all components
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace scan {
@@ -126,13 +130,74 @@ namespace scan {
         return t;
     }
 
-    /// Global theme instance (can be changed at runtime)
-    inline Theme &current_theme() {
-        static Theme theme = default_theme();
-        return theme;
+    namespace detail {
+        inline std::mutex &theme_mutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        /// The published theme; guarded by theme_mutex()
+        inline std::shared_ptr<const Theme> &theme_slot() {
+            static std::shared_ptr<const Theme> slot = std::make_shared<const Theme>(default_theme());
+            return slot;
+        }
+
+        /// Bumped after each publish, so readers only lock when the theme has changed
+        inline std::atomic<uint64_t> &theme_generation() {
+            static std::atomic<uint64_t> generation{1};
+            return generation;
+        }
+
+        inline void publish_theme(std::shared_ptr<const Theme> theme) {
+            theme_slot() = std::move(theme);
+            theme_generation().fetch_add(1, std::memory_order_release);
+        }
+    } // namespace detail
+
+    /// The current theme as a refcounted snapshot
+    ///
+    /// The snapshot stays valid however the theme changes afterwards; a theme is
+    /// freed once the last snapshot of it is dropped. Each thread caches the theme it
+    /// last saw, so while the theme is unchanged this is one atomic load and a
+    /// refcount increment, with no lock.
+    inline std::shared_ptr<const Theme> theme_snapshot() {
+        thread_local std::shared_ptr<const Theme> held;
+        thread_local uint64_t seen = 0;
+        uint64_t generation = detail::theme_generation().load(std::memory_order_acquire);
+        if (generation != seen) {
+            std::lock_guard<std::mutex> lock(detail::theme_mutex());
+            held = detail::theme_slot();
+            seen = generation;
+        }
+        return held;
     }
 
+    /// A copy of the current theme (can be changed at runtime with set_theme)
+    ///
+    /// Returned by value so it can never dangle when another thread switches the
+    /// theme; `const auto &t = current_theme();` keeps the copy alive. Use
+    /// theme_snapshot() to read several fields without copying the theme.
+    inline Theme current_theme() { return *theme_snapshot(); }
+
     /// Set the current theme
-    inline void set_theme(const Theme &t) { current_theme() = t; }
+    ///
+    /// Readers on other threads pick it up on their next theme_snapshot() or
+    /// current_theme() call; the previous theme is freed once no snapshot holds it.
+    inline void set_theme(const Theme &t) {
+        auto theme = std::make_shared<const Theme>(t);
+        std::lock_guard<std::mutex> lock(detail::theme_mutex());
+        detail::publish_theme(std::move(theme));
+    }
+
+    /// Change the current theme in place: edit receives a copy, which is then published
+    ///
+    /// current_theme() returns a copy; this is the replacement for editing the theme
+    /// through the mutable reference it used to return.
+    template <typename Edit> void modify_theme(Edit &&edit) {
+        std::lock_guard<std::mutex> lock(detail::theme_mutex());
+        Theme theme = *detail::theme_slot();
+        edit(theme);
+        detail::publish_theme(std::make_shared<const Theme>(std::move(theme)));
+    }
 
 } // namespace scan
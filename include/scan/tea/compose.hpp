@@ -0,0 +1,353 @@
+#pragma once
+
+/// @file compose.hpp
+/// @brief Host several component models in one Program, with focus management
+
+#include <scan/input/key.hpp>
+#include <scan/style/style.hpp>
+#include <scan/tea/cmd.hpp>
+#include <scan/tea/msg.hpp>
+#include <scan/tea/task.hpp>
+#include <scan/util/thread_pool.hpp>
+
+#include <any>
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace scan::tea {
+
+    /// A component model together with its update and view functions
+    ///
+    /// The model is stored by value behind a type-erased interface, so a
+    /// TextInputModel, a ListModel and a ConfirmModel can sit side by side in
+    /// one Composite. The rendered view is cached and only recomputed after the
+    /// component has received a message or changed focus.
+    class Component {
+      public:
+        Component() = default;
+
+        /// Wrap a model with functions shaped like `textinput_update` and `textinput_view`
+        template <typename Model, typename Update, typename View>
+        Component(Model model, Update update, View view, bool focusable = true)
+            : m_model(std::move(model)), m_focusable(focusable) {
+            m_update = [update](std::any &any, const Msg &msg) -> Cmd {
+                auto &m = std::any_cast<Model &>(any);
+                auto [next, cmd] = update(std::move(m), msg);
+                m = std::move(next);
+                return cmd;
+            };
+            m_view = [view](const std::any &any) -> std::string { return view(std::any_cast<const Model &>(any)); };
+            m_focus = [](std::any &any, bool focused) {
+                if constexpr (requires(Model &m) { m.focused = true; }) {
+                    std::any_cast<Model &>(any).focused = focused;
+                } else {
+                    (void)any;
+                    (void)focused;
+                }
+            };
+        }
+
+        /// Static text that never takes focus (headings, labels, help lines)
+        static Component text(std::string s) {
+            Component c(
+                std::move(s), [](std::string m, const Msg &) { return std::pair<std::string, Cmd>{std::move(m), none()}; },
+                [](const std::string &m) { return m; }, false);
+            c.m_update = nullptr; // Never changes, so messages need not invalidate it
+            return c;
+        }
+
+        /// Deliver a message; the next view() re-renders
+        Cmd update(const Msg &msg) {
+            if (!m_update) {
+                return none();
+            }
+            m_dirty = true;
+            return m_update(m_model, msg);
+        }
+
+        /// Rendered view, recomputed only if the component changed since the last call
+        const std::string &view() const {
+            if (m_dirty && m_view) {
+                m_cache = m_view(m_model);
+                m_renders++;
+            }
+            m_dirty = false;
+            return m_cache;
+        }
+
+        /// Set the model's `focused` flag, if it has one
+        void set_focused(bool focused) {
+            if (m_focus) {
+                m_focus(m_model, focused);
+            }
+            m_dirty = true;
+        }
+
+        /// Force the next view() to re-render
+        void invalidate() { m_dirty = true; }
+
+        bool focusable() const { return m_focusable; }
+        bool dirty() const { return m_dirty; }
+
+        /// How many times the view has been rendered
+        size_t render_count() const { return m_renders; }
+
+        /// The wrapped model, or null if it is not a Model
+        template <typename Model> Model *get() { return std::any_cast<Model>(&m_model); }
+        template <typename Model> const Model *get() const { return std::any_cast<Model>(&m_model); }
+
+      private:
+        std::any m_model;
+        std::function<Cmd(std::any &, const Msg &)> m_update;
+        std::function<std::string(const std::any &)> m_view;
+        std::function<void(std::any &, bool)> m_focus;
+        bool m_focusable = true;
+        mutable std::string m_cache;
+        mutable bool m_dirty = true;
+        mutable size_t m_renders = 0;
+    };
+
+    /// A message produced by a component's command, on its way back to that component
+    struct ComponentMsg {
+        size_t index = 0;
+        Msg msg;
+    };
+
+    /// Several components shown one below the other (or side by side), with one of them focused
+    struct CompositeModel {
+        std::vector<Component> components;
+        std::vector<std::string> names;
+        size_t focus = 0;
+        int id = 0; // Matched against TaskMsg ids
+        std::string separator = "\n";
+        bool wrap_focus = true; // Tab on the last component moves to the first
+
+        // Layout
+        bool horizontal = false; // Side by side, top-aligned, instead of stacked
+        size_t gap = 1;          // Blank columns between side-by-side components
+        bool parallel = false;   // Render changed components concurrently on default_pool()
+
+        // State
+        bool submitted = false;
+        bool cancelled = false;
+
+        /// Component by name, or null
+        Component *find(const std::string &name) {
+            for (size_t i = 0; i < names.size(); i++) {
+                if (names[i] == name) {
+                    return &components[i];
+                }
+            }
+            return nullptr;
+        }
+
+        const Component *find(const std::string &name) const {
+            return const_cast<CompositeModel *>(this)->find(name);
+        }
+    };
+
+    inline void composite_add(CompositeModel &m, std::string name, Component component) {
+        m.names.push_back(std::move(name));
+        m.components.push_back(std::move(component));
+    }
+
+    /// Move focus to a component, blurring the previous one; false if it can't take focus
+    inline bool composite_focus(CompositeModel &m, size_t index) {
+        if (index >= m.components.size() || !m.components[index].focusable()) {
+            return false;
+        }
+        if (m.focus < m.components.size() && m.focus != index) {
+            m.components[m.focus].set_focused(false);
+            m.components[m.focus].update(BlurMsg{});
+        }
+        m.focus = index;
+        m.components[index].set_focused(true);
+        m.components[index].update(FocusMsg{});
+        return true;
+    }
+
+    /// Focus the next (step 1) or previous (step -1) focusable component; false if there is none
+    inline bool composite_focus_step(CompositeModel &m, int step, bool wrap) {
+        size_t n = m.components.size();
+        size_t i = m.focus;
+        for (size_t tries = 0; tries < n; tries++) {
+            if (step > 0) {
+                if (i + 1 >= n && !wrap) {
+                    return false;
+                }
+                i = (i + 1) % n;
+            } else {
+                if (i == 0 && !wrap) {
+                    return false;
+                }
+                i = (i + n - 1) % n;
+            }
+            if (m.components[i].focusable()) {
+                return composite_focus(m, i);
+            }
+        }
+        return false;
+    }
+
+    /// Blur every component and focus the first focusable one
+    inline void composite_init(CompositeModel &m) {
+        for (auto &c : m.components) {
+            c.set_focused(false);
+        }
+        m.focus = m.components.size();
+        for (size_t i = 0; i < m.components.size(); i++) {
+            if (composite_focus(m, i)) {
+                break;
+            }
+        }
+    }
+
+    namespace detail {
+        /// Deliver a message to one component and run its command right away
+        ///
+        /// The command runs now rather than in the Program so a component's
+        /// tea::quit() can be told apart: it means "done", which moves focus on
+        /// instead of ending the whole program. Any other resulting message is
+        /// returned, addressed back to the same component.
+        inline std::optional<Msg> composite_deliver(CompositeModel &m, size_t index, const Msg &msg, bool &quit) {
+            Cmd cmd = m.components[index].update(msg);
+            if (!cmd) {
+                return std::nullopt;
+            }
+            auto result = cmd();
+            if (!result) {
+                return std::nullopt;
+            }
+            if (is<QuitMsg>(*result)) {
+                quit = true;
+                return std::nullopt;
+            }
+            return TaskMsg{m.id, ComponentMsg{index, std::move(*result)}};
+        }
+
+        /// The focused component finished: focus the next one, or submit after the last
+        inline Cmd composite_done(CompositeModel &m) {
+            size_t previous = m.focus;
+            if (composite_focus_step(m, 1, false) && m.focus != previous) {
+                return none();
+            }
+            m.submitted = true;
+            return quit();
+        }
+    } // namespace detail
+
+    /// Route a message: keys go to the focused component only, everything else to all of them
+    ///
+    /// Tab / Shift+Tab move focus, Escape and Ctrl+C cancel. A component that
+    /// quits (e.g. a TextInput on Enter) hands focus to the next one, and the
+    /// last one submits the composite.
+    inline std::pair<CompositeModel, Cmd> composite_update(CompositeModel m, const Msg &msg) {
+        if (auto *task = try_as<TaskMsg>(msg)) {
+            if (task->id == m.id) {
+                if (auto *routed = std::any_cast<ComponentMsg>(&task->value)) {
+                    if (routed->index < m.components.size()) {
+                        bool quit = false;
+                        auto next = detail::composite_deliver(m, routed->index, routed->msg, quit);
+                        if (quit && routed->index == m.focus) {
+                            Cmd cmd = detail::composite_done(m);
+                            return {std::move(m), cmd};
+                        }
+                        return {std::move(m), next ? send(std::move(*next)) : none()};
+                    }
+                    return {std::move(m), none()};
+                }
+            }
+        }
+
+        if (auto *key = try_as<KeyMsg>(msg)) {
+            switch (key->key) {
+            case input::Key::Escape:
+            case input::Key::CtrlC:
+                m.cancelled = true;
+                return {std::move(m), quit()};
+            case input::Key::Tab:
+                composite_focus_step(m, 1, m.wrap_focus);
+                return {std::move(m), none()};
+            case input::Key::ShiftTab:
+                composite_focus_step(m, -1, m.wrap_focus);
+                return {std::move(m), none()};
+            default:
+                break;
+            }
+            if (m.focus >= m.components.size()) {
+                return {std::move(m), none()};
+            }
+            bool quit = false;
+            auto next = detail::composite_deliver(m, m.focus, msg, quit);
+            if (quit) {
+                Cmd cmd = detail::composite_done(m);
+                return {std::move(m), cmd};
+            }
+            return {std::move(m), next ? send(std::move(*next)) : none()};
+        }
+
+        // Broadcast (window size, ticks, task results, process output...)
+        std::optional<Msg> first;
+        for (size_t i = 0; i < m.components.size(); i++) {
+            bool quit = false;
+            auto next = detail::composite_deliver(m, i, msg, quit);
+            if (next) {
+                if (!first) {
+                    first = std::move(next);
+                } else {
+                    post(std::move(*next));
+                }
+            }
+        }
+        return {std::move(m), first ? send(std::move(*first)) : none()};
+    }
+
+    /// Re-render every changed component, several at once on the pool
+    ///
+    /// Components own their view caches, so independent panes can render on
+    /// different threads; the frame then costs the slowest pane rather than
+    /// the sum of all of them. Theme and style reads are safe concurrently.
+    inline void composite_render_parallel(const CompositeModel &m, ThreadPool &pool = default_pool()) {
+        std::vector<const Component *> dirty;
+        for (const auto &c : m.components) {
+            if (c.dirty()) {
+                dirty.push_back(&c);
+            }
+        }
+        if (dirty.size() > 1) {
+            pool.parallel_for(dirty.size(), [&](size_t i) { dirty[i]->view(); });
+        }
+    }
+
+    /// Join the components' views; unchanged components reuse their cached view
+    inline std::string composite_view(const CompositeModel &m) {
+        if (m.parallel) {
+            composite_render_parallel(m);
+        }
+
+        if (m.horizontal) {
+            std::vector<std::string> blocks;
+            blocks.reserve(m.components.size() * 2);
+            for (size_t i = 0; i < m.components.size(); i++) {
+                if (i > 0 && m.gap > 0) {
+                    blocks.push_back(std::string(m.gap, ' '));
+                }
+                blocks.push_back(m.components[i].view());
+            }
+            return join_horizontal(Position::Top, blocks);
+        }
+
+        std::string view;
+        for (size_t i = 0; i < m.components.size(); i++) {
+            if (i > 0) {
+                view += m.separator;
+            }
+            view += m.components[i].view();
+        }
+        return view;
+    }
+
+} // namespace scan::tea
@@ -0,0 +1,406 @@
+#pragma once
+
+/// @file exec.hpp
+/// @brief Process runtime service - runs external commands and streams their output as messages
+
+#include <scan/tea/cmd.hpp>
+#include <scan/tea/msg.hpp>
+#include <scan/tea/task.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifndef SCAN_MODULE_INTERFACE // The module relies on <unistd.h> declaring it (glibc)
+extern char **environ;
+#endif
+#endif
+
+namespace scan::tea {
+
+    /// Options for a process started through the exec service
+    struct ExecOptions {
+        bool merge_stderr = false;            // Send stderr down the stdout pipe (keeps interleaving)
+        size_t max_pending = 4 * 1024 * 1024; // Per-stream bytes buffered before reading pauses
+        size_t read_chunk = 256 * 1024;       // Max bytes read per stream per poll
+    };
+
+    /// Runs child processes and batches their output for the event loop
+    ///
+    /// Pipes are non-blocking and only read when poll() reports data, so a noisy
+    /// child never stalls the UI. Output is collected per stream until the next
+    /// batch is taken; once a stream holds max_pending bytes its pipe is no longer
+    /// polled and the child blocks on write, so memory stays bounded however much
+    /// the process prints.
+    ///
+    /// The service has no lock: use it only from the thread running the event loop (Programs
+    /// nested in an update run on that same thread). Each Program takes only the messages of the
+    /// processes it started, so nested Programs never see each other's output.
+    class ExecService {
+      public:
+        ExecService() = default;
+        ExecService(const ExecService &) = delete;
+        ExecService &operator=(const ExecService &) = delete;
+        ~ExecService() { kill_all(); }
+
+        /// Identifies who started a process, so take_messages() and kill_owned() touch only that owner's processes
+        using Owner = const void *;
+
+        /// Spawn argv[0] (looked up in PATH) with stdin redirected from /dev/null
+        /// @return true if the process started; on failure an ExecExitMsg carrying the error is queued
+        bool spawn(int id, const std::vector<std::string> &argv, const ExecOptions &opts = {}, Owner owner = nullptr) {
+            Process proc;
+            proc.id = id;
+            proc.opts = opts;
+            proc.owner = owner;
+
+            if (argv.empty()) {
+                proc.error = "empty command";
+                proc.finished = true;
+                m_procs.push_back(std::move(proc));
+                return false;
+            }
+
+#ifdef _WIN32
+            proc.error = "process spawning is not supported on this platform";
+            proc.finished = true;
+            m_procs.push_back(std::move(proc));
+            return false;
+#else
+            int out_pipe[2] = {-1, -1};
+            int err_pipe[2] = {-1, -1};
+            if (!make_pipe(out_pipe) || (!opts.merge_stderr && !make_pipe(err_pipe))) {
+                proc.error = std::strerror(errno);
+                close_fds(out_pipe);
+                close_fds(err_pipe);
+                proc.finished = true;
+                m_procs.push_back(std::move(proc));
+                return false;
+            }
+
+            // Pipe ends are close-on-exec; dup2 clears the flag on the child's 1 and 2
+            posix_spawn_file_actions_t actions;
+            posix_spawn_file_actions_init(&actions);
+            posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+            posix_spawn_file_actions_adddup2(&actions, out_pipe[1], STDOUT_FILENO);
+            posix_spawn_file_actions_adddup2(&actions, opts.merge_stderr ? out_pipe[1] : err_pipe[1], STDERR_FILENO);
+
+            std::vector<char *> args;
+            args.reserve(argv.size() + 1);
+            for (const auto &a : argv) {
+                args.push_back(const_cast<char *>(a.c_str()));
+            }
+            args.push_back(nullptr);
+
+            pid_t pid = 0;
+            int rc = posix_spawnp(&pid, args[0], &actions, nullptr, args.data(), environ);
+            posix_spawn_file_actions_destroy(&actions);
+
+            if (out_pipe[1] >= 0)
+                ::close(out_pipe[1]);
+            if (err_pipe[1] >= 0)
+                ::close(err_pipe[1]);
+
+            if (rc != 0) {
+                proc.error = argv[0] + ": " + std::strerror(rc);
+                if (out_pipe[0] >= 0)
+                    ::close(out_pipe[0]);
+                if (err_pipe[0] >= 0)
+                    ::close(err_pipe[0]);
+                proc.finished = true;
+                m_procs.push_back(std::move(proc));
+                return false;
+            }
+
+            proc.pid = pid;
+            proc.fds[0] = out_pipe[0];
+            proc.fds[1] = err_pipe[0];
+            m_procs.push_back(std::move(proc));
+            return true;
+#endif
+        }
+
+        /// Send a signal to a running process
+        bool kill(int id, int sig = SIGTERM) {
+#ifndef _WIN32
+            for (auto &p : m_procs) {
+                if (p.id == id && p.pid > 0 && !p.finished) {
+                    return ::kill(p.pid, sig) == 0;
+                }
+            }
+#endif
+            return false;
+        }
+
+        /// Terminate and reap every process, dropping undelivered output
+        void kill_all() { kill_where([](const Process &) { return true; }); }
+
+        /// Terminate and reap the processes started by owner, dropping their undelivered output
+        void kill_owned(Owner owner) {
+            kill_where([owner](const Process &p) { return p.owner == owner; });
+        }
+
+        /// True while any process is running or has messages left to deliver
+        bool active() const { return !m_procs.empty(); }
+
+        /// Wait up to timeout_ms for output, reading whatever is available
+        /// @param watch Additional descriptors to wait on (e.g. stdin)
+        /// @return Bitmask with bit i set if watch[i] became readable
+        unsigned poll(int timeout_ms, std::initializer_list<int> watch = {}) {
+#ifdef _WIN32
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::max(0, timeout_ms)));
+            return 0;
+#else
+            std::vector<pollfd> pfds;
+            std::vector<std::pair<size_t, int>> owners; // (process index, stream)
+            for (int fd : watch) {
+                pfds.push_back({fd, POLLIN, 0});
+            }
+
+            bool awaiting_exit = false;
+            for (size_t i = 0; i < m_procs.size(); i++) {
+                auto &p = m_procs[i];
+                for (int s = 0; s < 2; s++) {
+                    if (p.fds[s] >= 0 && p.pending[s].size() < p.opts.max_pending) {
+                        pfds.push_back({p.fds[s], POLLIN, 0});
+                        owners.emplace_back(i, s);
+                    }
+                }
+                if (!p.finished && p.fds[0] < 0 && p.fds[1] < 0) {
+                    awaiting_exit = true;
+                }
+            }
+
+            // Pipes closed but the child hasn't been reaped yet: check back soon
+            if (awaiting_exit) {
+                timeout_ms = std::min(timeout_ms, 10);
+            }
+
+            int n = ::poll(pfds.data(), static_cast<nfds_t>(pfds.size()), timeout_ms);
+            unsigned ready = 0;
+            if (n > 0) {
+                size_t base = watch.size();
+                for (size_t k = 0; k < base; k++) {
+                    if (pfds[k].revents & (POLLIN | POLLHUP | POLLERR)) {
+                        ready |= 1u << k;
+                    }
+                }
+                for (size_t k = 0; k < owners.size(); k++) {
+                    if (pfds[base + k].revents & (POLLIN | POLLHUP | POLLERR)) {
+                        read_stream(m_procs[owners[k].first], owners[k].second);
+                    }
+                }
+            }
+
+            for (auto &p : m_procs) {
+                if (!p.finished && p.fds[0] < 0 && p.fds[1] < 0) {
+                    reap(p);
+                }
+            }
+            return ready;
+#endif
+        }
+
+        /// Minimum time between batches handed to the update function
+        void set_frame_interval(std::chrono::milliseconds interval) { m_frame_interval = interval; }
+
+        /// True if there is something to deliver and a frame interval has passed since the last batch
+        bool flush_due() const {
+            return flush_due_where([](const Process &) { return true; });
+        }
+
+        /// flush_due() for the processes started by owner
+        bool flush_due(Owner owner) const {
+            return flush_due_where([owner](const Process &p) { return p.owner == owner; });
+        }
+
+        /// Take all buffered output as one message per stream, followed by exit messages
+        std::vector<Msg> take_messages() {
+            return take_where([](const Process &) { return true; });
+        }
+
+        /// take_messages() for the processes started by owner; other processes keep their output and exit
+        std::vector<Msg> take_messages(Owner owner) {
+            return take_where([owner](const Process &p) { return p.owner == owner; });
+        }
+
+      private:
+        struct Process {
+            int id = 0;
+            Owner owner = nullptr;
+            int pid = -1;
+            int fds[2] = {-1, -1}; // stdout, stderr read ends
+            std::string pending[2];
+            ExecOptions opts;
+            bool finished = false;
+            int exit_code = -1;
+            int signal = 0;
+            std::string error;
+        };
+
+        std::vector<Process> m_procs;
+        std::chrono::milliseconds m_frame_interval{16};
+        std::chrono::steady_clock::time_point m_last_flush{};
+
+        template <typename Match> bool flush_due_where(Match match) const {
+            if (std::chrono::steady_clock::now() - m_last_flush < m_frame_interval) {
+                return false;
+            }
+            for (const auto &p : m_procs) {
+                if (match(p) && (p.finished || !p.pending[0].empty() || !p.pending[1].empty())) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <typename Match> std::vector<Msg> take_where(Match match) {
+            std::vector<Msg> msgs;
+            for (auto &p : m_procs) {
+                if (!match(p)) {
+                    continue;
+                }
+                for (int s = 0; s < 2; s++) {
+                    if (!p.pending[s].empty()) {
+                        msgs.push_back(ExecOutputMsg{p.id, std::move(p.pending[s]), s == 1});
+                        p.pending[s] = std::string();
+                    }
+                }
+                if (p.finished) {
+                    msgs.push_back(ExecExitMsg{p.id, p.exit_code, p.signal, p.error});
+                }
+            }
+            m_procs.erase(std::remove_if(m_procs.begin(), m_procs.end(),
+                                         [&match](const Process &p) { return p.finished && match(p); }),
+                          m_procs.end());
+            m_last_flush = std::chrono::steady_clock::now();
+            return msgs;
+        }
+
+        template <typename Match> void kill_where(Match match) {
+#ifndef _WIN32
+            for (auto &p : m_procs) {
+                if (!match(p)) {
+                    continue;
+                }
+                close_fds(p.fds);
+                if (p.pid > 0 && !p.finished) {
+                    ::kill(p.pid, SIGTERM);
+                }
+            }
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+            for (auto &p : m_procs) {
+                while (match(p) && p.pid > 0 && !p.finished && !reap(p)) {
+                    if (std::chrono::steady_clock::now() >= deadline) {
+                        ::kill(p.pid, SIGKILL);
+                        int status = 0;
+                        ::waitpid(p.pid, &status, 0);
+                        p.finished = true;
+                        break;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                }
+            }
+#endif
+            m_procs.erase(std::remove_if(m_procs.begin(), m_procs.end(), match), m_procs.end());
+        }
+
+#ifndef _WIN32
+        static bool make_pipe(int fds[2]) {
+            if (::pipe(fds) != 0) {
+                return false;
+            }
+            ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+            ::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+            ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+            return true;
+        }
+
+        static void close_fds(int fds[2]) {
+            for (int s = 0; s < 2; s++) {
+                if (fds[s] >= 0) {
+                    ::close(fds[s]);
+                    fds[s] = -1;
+                }
+            }
+        }
+
+        static void read_stream(Process &p, int s) {
+            char buf[16384];
+            size_t room = p.opts.max_pending - std::min(p.opts.max_pending, p.pending[s].size());
+            size_t budget = std::min(p.opts.read_chunk, room);
+            while (budget > 0) {
+                ssize_t r = ::read(p.fds[s], buf, std::min(sizeof(buf), budget));
+                if (r > 0) {
+                    p.pending[s].append(buf, static_cast<size_t>(r));
+                    budget -= static_cast<size_t>(r);
+                } else if (r < 0 && errno == EINTR) {
+                    continue;
+                } else {
+                    if (r == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                        ::close(p.fds[s]);
+                        p.fds[s] = -1;
+                    }
+                    break;
+                }
+            }
+        }
+
+        static bool reap(Process &p) {
+            int status = 0;
+            pid_t r = ::waitpid(p.pid, &status, WNOHANG);
+            if (r == 0) {
+                return false;
+            }
+            if (r == p.pid) {
+                if (WIFEXITED(status)) {
+                    p.exit_code = WEXITSTATUS(status);
+                } else if (WIFSIGNALED(status)) {
+                    p.signal = WTERMSIG(status);
+                }
+            }
+            p.finished = true;
+            return true;
+        }
+#endif
+    };
+
+    /// Process-wide exec service polled by tea::Program
+    inline ExecService &exec_service() {
+        static ExecService service;
+        return service;
+    }
+
+    /// Start a process; its output arrives as ExecOutputMsg and its exit as ExecExitMsg, both tagged with id
+    ///
+    /// The process belongs to the running Program (keyed by its mailbox) and is killed when that Program exits.
+    inline Cmd exec(std::vector<std::string> argv, int id = 0, ExecOptions opts = {}) {
+        return [argv = std::move(argv), id, opts]() -> std::optional<Msg> {
+            exec_service().spawn(id, argv, opts, current_mailbox().get());
+            return std::nullopt;
+        };
+    }
+
+    /// Send a signal to a process started with tea::exec
+    inline Cmd exec_kill(int id) {
+        return [id]() -> std::optional<Msg> {
+            exec_service().kill(id);
+            return std::nullopt;
+        };
+    }
+
+} // namespace scan::tea
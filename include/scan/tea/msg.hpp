@@ -4,7 +4,9 @@
 /// @brief Message types for the Tea runtime (Bubble Tea style)
 
 #include <scan/input/key.hpp>
+#include <any>
 #include <string>
+#include <string_view>
 #include <variant>
 
 namespace scan::tea {
@@ -42,8 +44,38 @@ namespace scan::tea {
         std::string data;
     };
 
+    /// Batched output from a process started with tea::exec
+    struct ExecOutputMsg {
+        int id = 0;               // Process ID given to tea::exec
+        std::string data;         // Raw bytes read since the last batch
+        bool from_stderr = false; // Data came from stderr instead of stdout
+    };
+
+    /// Process started with tea::exec has finished
+    struct ExecExitMsg {
+        int id = 0;        // Process ID given to tea::exec
+        int exit_code = 0; // Exit status (-1 if killed or never started)
+        int signal = 0;    // Terminating signal, 0 if exited normally
+        std::string error; // Spawn error message, empty on success
+    };
+
+    /// One or more newline-separated lines (log output, streamed list items), usually sent with
+    /// Program::send from a producer thread
+    struct LogMsg {
+        int id = 0;        // Source ID, matched against the receiving view
+        std::string text;  // Complete lines; a trailing newline is optional
+        bool done = false; // Source finished, no more lines follow
+    };
+
+    /// Result of background work (see tea::async), carrying any payload type
+    struct TaskMsg {
+        int id = 0;      // Task or component ID
+        std::any value;  // Payload, read back with std::any_cast
+    };
+
     /// Union of all possible message types
-    using Msg = std::variant<KeyMsg, WindowSizeMsg, TickMsg, FocusMsg, BlurMsg, QuitMsg, CustomMsg>;
+    using Msg = std::variant<KeyMsg, WindowSizeMsg, TickMsg, FocusMsg, BlurMsg, QuitMsg, CustomMsg, ExecOutputMsg,
+                             ExecExitMsg, LogMsg, TaskMsg>;
 
     /// Helper to check message type
     template <typename T> inline bool is(const Msg &msg) { return std::holds_alternative<T>(msg); }
@@ -54,4 +86,17 @@ namespace scan::tea {
     /// Helper to try get message as specific type
     template <typename T> inline const T *try_as(const Msg &msg) { return std::get_if<T>(&msg); }
 
+    /// Call fn for each line of newline-separated text such as LogMsg::text (a trailing newline is optional)
+    template <typename F> inline void for_each_line(std::string_view text, F &&fn) {
+        size_t start = 0;
+        while (start < text.size()) {
+            size_t nl = text.find('\n', start);
+            if (nl == std::string_view::npos) {
+                nl = text.size();
+            }
+            fn(text.substr(start, nl - start));
+            start = nl + 1;
+        }
+    }
+
 } // namespace scan::tea
@@ -6,26 +6,36 @@
 #include <scan/input/reader.hpp>
 #include <scan/render/renderer.hpp>
 #include <scan/tea/cmd.hpp>
+#include <scan/tea/exec.hpp>
 #include <scan/tea/msg.hpp>
+#include <scan/tea/task.hpp>
 #include <scan/terminal/alt_screen.hpp>
 #include <scan/terminal/raw_mode.hpp>
 #include <scan/terminal/terminal.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <functional>
-#include <mutex>
+#include <memory>
 #include <optional>
 #include <queue>
 #include <thread>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace scan::tea {
 
     /// Program options
     struct ProgramOptions {
-        bool alt_screen = false;    // Use alternate screen buffer
-        bool mouse = false;         // Enable mouse tracking
-        bool hide_cursor = true;    // Hide cursor during execution
-        int input_timeout_ms = 100; // Timeout for input polling
+        bool alt_screen = false;        // Use alternate screen buffer
+        bool mouse = false;             // Enable mouse tracking
+        bool hide_cursor = true;        // Hide cursor during execution
+        int input_timeout_ms = 100;     // Timeout for input polling
+        int fps = 60;                   // Max frames rendered per second
+        size_t mailbox_capacity = 1024; // Messages queued by send() before it blocks (0 = unbounded)
     };
 
     /// The Tea Program - runs the MVU loop
@@ -39,11 +49,17 @@ namespace scan::tea {
 
         /// Construct a program with init, update, and view functions
         Program(InitFn init, UpdateFn update, ViewFn view)
-            : m_init(std::move(init)), m_update(std::move(update)), m_view(std::move(view)) {}
+            : m_init(std::move(init)), m_update(std::move(update)), m_view(std::move(view)) {
+            m_mailbox->set_capacity(m_options.mailbox_capacity);
+        }
+
+        Program(const Program &) = delete;
+        Program &operator=(const Program &) = delete;
 
         /// Set program options
         Program &with_options(const ProgramOptions &opts) {
             m_options = opts;
+            m_mailbox->set_capacity(opts.mailbox_capacity);
             return *this;
         }
 
@@ -65,6 +81,19 @@ namespace scan::tea {
             return *this;
         }
 
+        /// Limit how often the view is rendered (and process output batches applied)
+        Program &with_fps(int fps) {
+            m_options.fps = std::max(1, fps);
+            return *this;
+        }
+
+        /// Limit how many messages send() queues before it blocks the sending thread (0 = unbounded)
+        Program &with_mailbox_capacity(size_t capacity) {
+            m_options.mailbox_capacity = capacity;
+            m_mailbox->set_capacity(capacity);
+            return *this;
+        }
+
         /// Run the program, returns final model
         Model run() {
             // Initialize terminal
@@ -86,6 +115,10 @@ namespace scan::tea {
                 mouse_tracking.emplace();
             }
 
+            // Results of tea::async commands are posted to this program while it runs
+            MailboxScope mailbox_scope(m_mailbox);
+            LoopScope loop_scope(*this);
+
             // Initialize model
             auto [model, init_cmd] = m_init();
 
@@ -110,10 +143,35 @@ namespace scan::tea {
             renderer.render(m_view(model));
 
             // Event loop
+            auto &exec = exec_service();
+            auto frame = std::chrono::milliseconds(std::max(1, 1000 / std::max(1, m_options.fps)));
+            exec.set_frame_interval(frame);
+            auto next_frame = std::chrono::steady_clock::now();
+            bool dirty = false;
+
             m_running = true;
             while (m_running) {
-                // Read input
-                auto key_event = input::read_key(m_options.input_timeout_ms);
+                // Sleep until input, process output, a sent message or the next due frame
+                int timeout = m_options.input_timeout_ms;
+                if (exec.active()) {
+                    timeout = std::min(timeout, static_cast<int>(frame.count()));
+                }
+                if (dirty) {
+                    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(next_frame -
+                                                                                      std::chrono::steady_clock::now());
+                    timeout = std::clamp(static_cast<int>(wait.count()), 0, timeout);
+                }
+
+                std::optional<input::KeyEvent> key_event;
+#ifdef _WIN32
+                key_event = input::read_key(timeout);
+#else
+                unsigned ready = exec.poll(timeout, {STDIN_FILENO, m_mailbox->fd()});
+                if (ready & 1u) {
+                    key_event = input::read_key(0);
+                }
+#endif
+
                 if (key_event) {
                     // Convert to message
                     KeyMsg key_msg;
@@ -127,44 +185,120 @@ namespace scan::tea {
                         break;
                     }
 
-                    // Update model
-                    auto [new_model, cmd] = m_update(std::move(model), key_msg);
-                    model = std::move(new_model);
+                    if (!dispatch(model, key_msg)) {
+                        m_running = false;
+                        break;
+                    }
+                    dirty = true;
+                }
 
-                    // Process command
-                    if (cmd) {
-                        auto msg = cmd();
-                        if (msg) {
-                            if (is<QuitMsg>(*msg)) {
-                                m_running = false;
-                                break;
-                            }
-                            // Process the message
-                            auto [updated_model, new_cmd] = m_update(std::move(model), *msg);
-                            model = std::move(updated_model);
+                // Messages sent from other threads and finished background tasks
+                std::queue<Msg> inbox = m_mailbox->take();
+                while (m_running && !inbox.empty()) {
+                    Msg msg = std::move(inbox.front());
+                    inbox.pop();
+                    if (is<QuitMsg>(msg) || !dispatch(model, std::move(msg))) {
+                        m_running = false;
+                    }
+                    dirty = true;
+                }
+
+                // Apply batched process output at most once per frame
+                if (m_running && exec.flush_due(m_mailbox.get())) {
+                    for (auto &msg : exec.take_messages(m_mailbox.get())) {
+                        if (!dispatch(model, std::move(msg))) {
+                            m_running = false;
+                            break;
                         }
                     }
+                    dirty = true;
+                }
 
-                    // Render
+                // Render at most once per frame, however many messages arrived
+                auto now = std::chrono::steady_clock::now();
+                if (m_running && dirty && now >= next_frame) {
                     renderer.render(m_view(model));
+                    dirty = false;
+                    next_frame = now + frame;
                 }
             }
 
+            // Processes started by this program belong to its session; don't leave them blocked on a full pipe
+            exec.kill_owned(m_mailbox.get());
+
             // Final cleanup - clear rendered content
             renderer.clear();
 
             return model;
         }
 
-        /// Request the program to quit
-        void quit() { m_running = false; }
+        /// Request the program to quit (safe to call from any thread)
+        void quit() {
+            m_running = false;
+            m_mailbox->wake();
+        }
+
+        /// Queue a message for the update function (safe to call from any thread)
+        ///
+        /// Messages are applied in order on the event loop; the view is re-rendered at most once per frame.
+        /// While mailbox_capacity messages are queued the sending thread waits for the loop to take them, so
+        /// a fast producer is slowed to the loop's pace. Once the program has exited, send() drops the message.
+        /// Called from the event loop thread itself it never waits.
+        void send(Msg msg) {
+            if (std::this_thread::get_id() == m_loop_thread.load()) {
+                m_mailbox->post(std::move(msg));
+            } else {
+                m_mailbox->post_wait(std::move(msg));
+            }
+        }
+
+        /// Queue a message unless mailbox_capacity messages are already waiting
+        /// @return false if the message was dropped (mailbox full, or the program has exited)
+        bool try_send(Msg msg) { return m_mailbox->try_post(std::move(msg)); }
 
       private:
+        /// Marks the calling thread as the event loop; on exit, releases senders blocked on a full mailbox
+        struct LoopScope {
+            explicit LoopScope(Program &program) : program(program) {
+                program.m_mailbox->open();
+                program.m_loop_thread = std::this_thread::get_id();
+            }
+            ~LoopScope() {
+                program.m_mailbox->close();
+                program.m_loop_thread = std::thread::id();
+            }
+            LoopScope(const LoopScope &) = delete;
+            LoopScope &operator=(const LoopScope &) = delete;
+
+            Program &program;
+        };
+
+        /// Run update for a message and process the returned command
+        /// @return false if the program should quit
+        bool dispatch(Model &model, Msg msg) {
+            auto [new_model, cmd] = m_update(std::move(model), std::move(msg));
+            model = std::move(new_model);
+
+            if (cmd) {
+                auto cmd_msg = cmd();
+                if (cmd_msg) {
+                    if (is<QuitMsg>(*cmd_msg)) {
+                        return false;
+                    }
+                    auto [updated_model, new_cmd] = m_update(std::move(model), std::move(*cmd_msg));
+                    model = std::move(updated_model);
+                }
+            }
+            return true;
+        }
+
         InitFn m_init;
         UpdateFn m_update;
         ViewFn m_view;
         ProgramOptions m_options;
         std::atomic<bool> m_running{false};
+        std::atomic<std::thread::id> m_loop_thread{};
+        std::shared_ptr<Mailbox> m_mailbox = std::make_shared<Mailbox>();
     };
 
     /// Convenience function to create and run a simple program
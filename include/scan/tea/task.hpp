@@ -0,0 +1,253 @@
+#pragma once
+
+/// @file task.hpp
+/// @brief Background tasks - run work off the event loop and deliver the result as a message
+
+#include <scan/tea/cmd.hpp>
+#include <scan/tea/msg.hpp>
+#include <scan/util/thread_pool.hpp>
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace scan::tea {
+
+    /// Thread-safe message queue that wakes the event loop when something arrives
+    ///
+    /// Only the transition from empty to non-empty writes to the wake pipe, so a
+    /// producer posting thousands of messages per frame costs one syscall.
+    ///
+    /// With a capacity set, post_wait() blocks a producer while that many messages
+    /// are queued, so a producer faster than the event loop can't grow the queue
+    /// without limit. post() never blocks; it is for the bounded traffic of
+    /// background tasks.
+    class Mailbox {
+      public:
+        Mailbox() {
+#ifndef _WIN32
+            if (::pipe(m_wake) == 0) {
+                for (int fd : m_wake) {
+                    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+                    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+                }
+            } else {
+                m_wake[0] = m_wake[1] = -1;
+            }
+#endif
+        }
+
+        Mailbox(const Mailbox &) = delete;
+        Mailbox &operator=(const Mailbox &) = delete;
+
+        ~Mailbox() {
+#ifndef _WIN32
+            for (int fd : m_wake) {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+#endif
+        }
+
+        /// Queue a message (safe from any thread)
+        void post(Msg msg) {
+            bool was_empty;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                was_empty = m_queue.empty();
+                m_queue.push(std::move(msg));
+            }
+            if (was_empty) {
+                wake();
+            }
+        }
+
+        /// Queue a message, waiting while the mailbox is full
+        /// @return false if the mailbox was closed instead; the message is dropped
+        bool post_wait(Msg msg) {
+            bool was_empty;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_space.wait(lock, [this] { return m_closed || !full(); });
+                if (m_closed) {
+                    return false;
+                }
+                was_empty = m_queue.empty();
+                m_queue.push(std::move(msg));
+            }
+            if (was_empty) {
+                wake();
+            }
+            return true;
+        }
+
+        /// Queue a message unless the mailbox is full or closed
+        bool try_post(Msg msg) {
+            bool was_empty;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_closed || full()) {
+                    return false;
+                }
+                was_empty = m_queue.empty();
+                m_queue.push(std::move(msg));
+            }
+            if (was_empty) {
+                wake();
+            }
+            return true;
+        }
+
+        /// Most messages queued before post_wait() blocks (0 = unbounded)
+        void set_capacity(size_t capacity) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_capacity = capacity;
+            }
+            m_space.notify_all();
+        }
+
+        /// Release producers blocked in post_wait() and refuse new ones until reopened
+        void close() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_closed = true;
+            }
+            m_space.notify_all();
+        }
+
+        /// Accept post_wait() and try_post() again after close()
+        void open() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = false;
+        }
+
+        /// Take every queued message and reset the wake signal
+        std::queue<Msg> take() {
+#ifndef _WIN32
+            char buf[64];
+            while (m_wake[0] >= 0 && ::read(m_wake[0], buf, sizeof(buf)) > 0) {
+            }
+#endif
+            std::queue<Msg> out;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                std::swap(out, m_queue);
+            }
+            m_space.notify_all();
+            return out;
+        }
+
+        /// Wake a loop waiting on fd() without queueing anything
+        void wake() {
+#ifndef _WIN32
+            if (m_wake[1] >= 0) {
+                char c = 1;
+                [[maybe_unused]] auto n = ::write(m_wake[1], &c, 1);
+            }
+#endif
+        }
+
+        /// Descriptor that becomes readable after post() or wake(), -1 if unavailable
+        int fd() const { return m_wake[0]; }
+
+      private:
+        std::mutex m_mutex;
+        std::condition_variable m_space; // Signalled when take() empties the queue
+        std::queue<Msg> m_queue;
+        size_t m_capacity = 0;
+        bool m_closed = false;
+        int m_wake[2] = {-1, -1};
+
+        bool full() const { return m_capacity > 0 && m_queue.size() >= m_capacity; }
+    };
+
+    namespace detail {
+        inline std::mutex &mailbox_mutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        inline std::weak_ptr<Mailbox> &mailbox_slot() {
+            static std::weak_ptr<Mailbox> slot;
+            return slot;
+        }
+    } // namespace detail
+
+    /// Mailbox of the running Program, or null if none is running
+    inline std::shared_ptr<Mailbox> current_mailbox() {
+        std::lock_guard<std::mutex> lock(detail::mailbox_mutex());
+        return detail::mailbox_slot().lock();
+    }
+
+    /// Makes a mailbox current for its lifetime, restoring the previous one afterwards
+    class MailboxScope {
+      public:
+        explicit MailboxScope(std::shared_ptr<Mailbox> mailbox) {
+            std::lock_guard<std::mutex> lock(detail::mailbox_mutex());
+            m_previous = detail::mailbox_slot();
+            detail::mailbox_slot() = mailbox;
+        }
+
+        MailboxScope(const MailboxScope &) = delete;
+        MailboxScope &operator=(const MailboxScope &) = delete;
+
+        ~MailboxScope() {
+            std::lock_guard<std::mutex> lock(detail::mailbox_mutex());
+            detail::mailbox_slot() = m_previous;
+        }
+
+      private:
+        std::weak_ptr<Mailbox> m_previous;
+    };
+
+    /// Deliver a message to the running Program from any thread; false if none is running
+    ///
+    /// Lets a long background task report progress before its final message.
+    inline bool post(Msg msg) {
+        if (auto mailbox = current_mailbox()) {
+            mailbox->post(std::move(msg));
+            return true;
+        }
+        return false;
+    }
+
+    /// Run fn on the shared pool (default_pool()); its message is delivered to the running Program when done
+    ///
+    /// With no Program running (e.g. in tests) fn runs synchronously and its
+    /// message is returned directly. If the Program exits first the message is
+    /// dropped. Use Priority::Background for long work whose result can wait,
+    /// and pass a CancelToken to drop the job if it is no longer wanted (fn can
+    /// also poll the token while it runs).
+    inline Cmd async(std::function<std::optional<Msg>()> fn, Priority priority = Priority::Interactive,
+                     CancelToken token = CancelToken::none()) {
+        return [fn = std::move(fn), priority, token]() -> std::optional<Msg> {
+            std::weak_ptr<Mailbox> target = current_mailbox();
+            if (target.expired()) {
+                return token.cancelled() ? std::nullopt : fn();
+            }
+            default_pool().execute(
+                [fn, target]() {
+                    auto msg = fn();
+                    if (!msg) {
+                        return;
+                    }
+                    if (auto mailbox = target.lock()) {
+                        mailbox->post(std::move(*msg));
+                    }
+                },
+                priority, token);
+            return std::nullopt;
+        };
+    }
+
+} // namespace scan::tea
@@ -0,0 +1,154 @@
+#pragma once
+
+/// @file bytes.hpp
+/// @brief Byte-pattern search and hex encoding helpers
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if !defined(SCAN_SIMD_DISABLED) && (defined(__AVX2__) || defined(__SSE2__))
+#include <immintrin.h>
+#define SCAN_BYTES_SIMD 1
+#endif
+
+namespace scan::bytes {
+
+    inline constexpr size_t npos = static_cast<size_t>(-1);
+
+    /// Lookup table of two-character lowercase hex digits for every byte value
+    struct HexTable {
+        char pairs[512];
+
+        constexpr HexTable() : pairs() {
+            const char digits[] = "0123456789abcdef";
+            for (int i = 0; i < 256; i++) {
+                pairs[i * 2] = digits[i >> 4];
+                pairs[i * 2 + 1] = digits[i & 15];
+            }
+        }
+    };
+
+    inline constexpr HexTable hex_table{};
+
+    /// Write the two hex digits of b to out
+    inline void hex_byte(char *out, uint8_t b) {
+        out[0] = hex_table.pairs[b * 2];
+        out[1] = hex_table.pairs[b * 2 + 1];
+    }
+
+    /// Parse "de ad be ef", "deadbeef" or "0xdead" into bytes; false on odd digits or junk
+    inline bool parse_hex(const std::string &text, std::vector<uint8_t> &out) {
+        out.clear();
+        int high = -1;
+        for (size_t i = 0; i < text.size(); i++) {
+            char c = text[i];
+            if (c == ' ' || c == ',' || c == ':') {
+                continue;
+            }
+            if (c == '0' && i + 1 < text.size() && (text[i + 1] == 'x' || text[i + 1] == 'X') && high < 0) {
+                i++;
+                continue;
+            }
+            int v;
+            if (c >= '0' && c <= '9') {
+                v = c - '0';
+            } else if (c >= 'a' && c <= 'f') {
+                v = c - 'a' + 10;
+            } else if (c >= 'A' && c <= 'F') {
+                v = c - 'A' + 10;
+            } else {
+                return false;
+            }
+            if (high < 0) {
+                high = v;
+            } else {
+                out.push_back(static_cast<uint8_t>(high << 4 | v));
+                high = -1;
+            }
+        }
+        return high < 0 && !out.empty();
+    }
+
+    /// Reference implementation: memchr for the first byte, then compare
+    inline size_t find_scalar(const uint8_t *data, size_t size, const uint8_t *pattern, size_t len) {
+        if (len == 0) {
+            return 0;
+        }
+        if (len > size) {
+            return npos;
+        }
+        size_t last = size - len;
+        size_t i = 0;
+        while (i <= last) {
+            const void *hit = std::memchr(data + i, pattern[0], last - i + 1);
+            if (!hit) {
+                return npos;
+            }
+            i = static_cast<size_t>(static_cast<const uint8_t *>(hit) - data);
+            if (std::memcmp(data + i + 1, pattern + 1, len - 1) == 0) {
+                return i;
+            }
+            i++;
+        }
+        return npos;
+    }
+
+    /// First occurrence of pattern in data, or npos
+    ///
+    /// With SIMD enabled, candidate positions are found by comparing a whole
+    /// vector of bytes against the pattern's first and last byte at once; only
+    /// positions matching both are verified with memcmp.
+    inline size_t find(const uint8_t *data, size_t size, const uint8_t *pattern, size_t len) {
+        if (len <= 1 || len > size) {
+            return find_scalar(data, size, pattern, len);
+        }
+        size_t i = 0;
+        size_t last = size - len; // Last valid start
+
+#if defined(SCAN_BYTES_SIMD) && defined(__AVX2__)
+        const __m256i first_v = _mm256_set1_epi8(static_cast<char>(pattern[0]));
+        const __m256i last_v = _mm256_set1_epi8(static_cast<char>(pattern[len - 1]));
+        for (; i + 32 <= last + 1; i += 32) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + len - 1));
+            auto mask = static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first_v), _mm256_cmpeq_epi8(b, last_v))));
+            while (mask) {
+                unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+                if (std::memcmp(data + i + bit + 1, pattern + 1, len - 2) == 0) {
+                    return i + bit;
+                }
+                mask &= mask - 1;
+            }
+        }
+#elif defined(SCAN_BYTES_SIMD)
+        const __m128i first_v = _mm_set1_epi8(static_cast<char>(pattern[0]));
+        const __m128i last_v = _mm_set1_epi8(static_cast<char>(pattern[len - 1]));
+        for (; i + 16 <= last + 1; i += 16) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + len - 1));
+            auto mask = static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first_v), _mm_cmpeq_epi8(b, last_v))));
+            while (mask) {
+                unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+                if (std::memcmp(data + i + bit + 1, pattern + 1, len - 2) == 0) {
+                    return i + bit;
+                }
+                mask &= mask - 1;
+            }
+        }
+#endif
+
+        size_t rest = find_scalar(data + i, size - i, pattern, len);
+        return rest == npos ? npos : i + rest;
+    }
+
+    inline size_t find(const std::string &data, const std::string &pattern) {
+        return find(reinterpret_cast<const uint8_t *>(data.data()), data.size(),
+                    reinterpret_cast<const uint8_t *>(pattern.data()), pattern.size());
+    }
+
+} // namespace scan::bytes
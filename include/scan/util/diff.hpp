@@ -0,0 +1,416 @@
+#pragma once
+
+/// @file diff.hpp
+/// @brief Linear-space Myers diff over interned lines
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace scan::diff {
+
+    inline constexpr size_t npos = static_cast<size_t>(-1);
+
+    /// a[a, a + a_len) is replaced by b[b, b + b_len); everything between changes is equal
+    struct Change {
+        size_t a = 0;
+        size_t a_len = 0;
+        size_t b = 0;
+        size_t b_len = 0;
+
+        bool operator==(const Change &o) const {
+            return a == o.a && a_len == o.a_len && b == o.b && b_len == o.b_len;
+        }
+    };
+
+    /// Receives changes in order; return false to stop the diff early
+    using ChangeSink = std::function<bool(const Change &)>;
+
+    /// Line table over a text that outlives it: line i is [starts[i], starts[i + 1]) minus the newline
+    class LineIndex {
+      public:
+        LineIndex() = default;
+
+        LineIndex(const char *data, size_t size) : m_data(data) {
+            const char *p = data;
+            const char *end = data + size;
+            while (p < end) {
+                auto *nl = static_cast<const char *>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+                if (!nl) {
+                    break;
+                }
+                p = nl + 1;
+                m_starts.push_back(static_cast<size_t>(p - data));
+            }
+            if (m_starts.back() != size) {
+                m_starts.push_back(size); // Last line without trailing newline
+            }
+        }
+
+        size_t size() const { return m_starts.size() - 1; }
+
+        std::string_view operator[](size_t i) const {
+            size_t begin = m_starts[i];
+            size_t end = m_starts[i + 1];
+            if (end > begin && m_data[end - 1] == '\n') {
+                end--;
+            }
+            return {m_data + begin, end - begin};
+        }
+
+      private:
+        const char *m_data = nullptr;
+        std::vector<size_t> m_starts{0};
+    };
+
+    /// Myers' O(ND) difference algorithm in linear space
+    ///
+    /// Each step trims the common prefix and suffix, finds the middle snake by
+    /// searching forward and backward at once, and recurses on the left half
+    /// before the right, so changes come out in order while the rest is still
+    /// being computed. Like xdiff, once the edit distance of a subproblem
+    /// exceeds max_cost the furthest-reaching path is taken as the split point:
+    /// the result may then be slightly longer than minimal, but the worst case
+    /// stays near O(N sqrt N) instead of O(N^2) for completely different inputs.
+    template <typename T> class Myers {
+      public:
+        Myers(const T *a, size_t n, const T *b, size_t m, const std::atomic<bool> *cancel = nullptr)
+            : m_a(a), m_b(b), m_n(n), m_m(m), m_cancel(cancel) {
+            m_fwd.resize(n + m + 3);
+            m_bwd.resize(n + m + 3);
+            m_max_cost = std::max<long>(256, static_cast<long>(std::sqrt(static_cast<double>(n + m))));
+        }
+
+        void set_max_cost(long cost) { m_max_cost = std::max<long>(1, cost); }
+
+        /// Run the diff, calling sink for each change; false if stopped or cancelled
+        bool run(const ChangeSink &sink) {
+            m_sink = &sink;
+            m_stopped = false;
+            m_has_pending = false;
+            compare(0, m_n, 0, m_m);
+            if (m_has_pending && !m_stopped) {
+                m_stopped = !sink(m_pending);
+            }
+            return !m_stopped;
+        }
+
+      private:
+        const T *m_a;
+        const T *m_b;
+        size_t m_n;
+        size_t m_m;
+        const std::atomic<bool> *m_cancel;
+        long m_max_cost;
+        std::vector<long> m_fwd;
+        std::vector<long> m_bwd;
+        const ChangeSink *m_sink = nullptr;
+        bool m_stopped = false;
+        Change m_pending;
+        bool m_has_pending = false;
+
+        // Adjacent changes from neighbouring subproblems are merged before emitting
+        void emit(size_t a0, size_t a1, size_t b0, size_t b1) {
+            if (m_has_pending && m_pending.a + m_pending.a_len == a0 && m_pending.b + m_pending.b_len == b0) {
+                m_pending.a_len += a1 - a0;
+                m_pending.b_len += b1 - b0;
+                return;
+            }
+            if (m_has_pending && !(*m_sink)(m_pending)) {
+                m_stopped = true;
+                return;
+            }
+            m_pending = {a0, a1 - a0, b0, b1 - b0};
+            m_has_pending = true;
+        }
+
+        void compare(size_t a0, size_t a1, size_t b0, size_t b1) {
+            while (!m_stopped) {
+                if (m_cancel && m_cancel->load(std::memory_order_relaxed)) {
+                    m_stopped = true;
+                    return;
+                }
+                while (a0 < a1 && b0 < b1 && m_a[a0] == m_b[b0]) {
+                    a0++;
+                    b0++;
+                }
+                while (a0 < a1 && b0 < b1 && m_a[a1 - 1] == m_b[b1 - 1]) {
+                    a1--;
+                    b1--;
+                }
+                if (a0 == a1 || b0 == b1) {
+                    if (a0 != a1 || b0 != b1) {
+                        emit(a0, a1, b0, b1);
+                    }
+                    return;
+                }
+                auto [x, y] = split(a0, a1, b0, b1);
+                compare(a0, x, b0, y);
+                a0 = x; // Right half iteratively, so heuristic splits cannot nest deeply
+                b0 = y;
+            }
+        }
+
+        // Find a point on a (near-)optimal path strictly inside the box, in absolute coordinates
+        std::pair<size_t, size_t> split(size_t a0, size_t a1, size_t b0, size_t b1) {
+            const T *a = m_a + a0;
+            const T *b = m_b + b0;
+            const long n = static_cast<long>(a1 - a0);
+            const long m = static_cast<long>(b1 - b0);
+            const long delta = n - m;
+            const bool odd = (delta & 1) != 0;
+
+            // Diagonal k = x - y lies in [-m, n]; index k + off, with a sentinel on each side
+            long *F = m_fwd.data() + m + 1;
+            long *B = m_bwd.data() + m + 1;
+            long fmin = 0, fmax = 0, bmin = delta, bmax = delta;
+            F[0] = 0;
+            B[delta] = n;
+
+            auto result = [&](long x, long k) { return std::pair<size_t, size_t>(a0 + x, b0 + (x - k)); };
+
+            for (long d = 1;; d++) {
+                // Forward pass
+                if (fmin > -m) {
+                    F[--fmin - 1] = -1;
+                } else {
+                    ++fmin;
+                }
+                if (fmax < n) {
+                    F[++fmax + 1] = -1;
+                } else {
+                    --fmax;
+                }
+                for (long k = fmax; k >= fmin; k -= 2) {
+                    long x = F[k - 1] >= F[k + 1] ? F[k - 1] + 1 : F[k + 1];
+                    long y = x - k;
+                    while (x < n && y < m && a[x] == b[y]) {
+                        x++;
+                        y++;
+                    }
+                    F[k] = x;
+                    if (odd && k >= bmin && k <= bmax && B[k] <= x) {
+                        return result(x, k);
+                    }
+                }
+
+                // Backward pass
+                if (bmin > -m) {
+                    B[--bmin - 1] = n + 1;
+                } else {
+                    ++bmin;
+                }
+                if (bmax < n) {
+                    B[++bmax + 1] = n + 1;
+                } else {
+                    --bmax;
+                }
+                for (long k = bmax; k >= bmin; k -= 2) {
+                    long x = B[k - 1] < B[k + 1] ? B[k - 1] : B[k + 1] - 1;
+                    long y = x - k;
+                    while (x > 0 && y > 0 && a[x - 1] == b[y - 1]) {
+                        x--;
+                        y--;
+                    }
+                    B[k] = x;
+                    if (!odd && k >= fmin && k <= fmax && x <= F[k]) {
+                        return result(x, k);
+                    }
+                }
+
+                if (d < m_max_cost) {
+                    continue;
+                }
+
+                // Too expensive: split at whichever frontier point got furthest from its corner
+                long best_f = -1, best_fk = 0;
+                for (long k = fmax; k >= fmin; k -= 2) {
+                    long x = std::min(F[k], n);
+                    long y = x - k;
+                    if (y > m) {
+                        x = m + k;
+                        y = m;
+                    }
+                    if (x + y > best_f) {
+                        best_f = x + y;
+                        best_fk = k;
+                    }
+                }
+                long best_b = -1, best_bk = 0;
+                for (long k = bmax; k >= bmin; k -= 2) {
+                    long x = std::max(0L, B[k]);
+                    long y = x - k;
+                    if (y < 0) {
+                        x = k;
+                        y = 0;
+                    }
+                    long progress = n + m - (x + y);
+                    if (progress > best_b) {
+                        best_b = progress;
+                        best_bk = k;
+                    }
+                }
+                if (best_f >= best_b) {
+                    long x = std::min(F[best_fk], n);
+                    if (x - best_fk > m) {
+                        x = m + best_fk;
+                    }
+                    return result(x, best_fk);
+                }
+                long x = std::max(0L, B[best_bk]);
+                if (x - best_bk < 0) {
+                    x = best_bk;
+                }
+                return result(x, best_bk);
+            }
+        }
+    };
+
+    /// Maps equal lines to equal ids, so the diff compares integers instead of strings
+    class LineInterner {
+      public:
+        uint32_t intern(std::string_view line) {
+            auto [it, inserted] = m_ids.try_emplace(line, static_cast<uint32_t>(m_ids.size()));
+            return it->second;
+        }
+
+        void reserve(size_t lines) { m_ids.reserve(lines); }
+        void clear() { m_ids.clear(); }
+
+      private:
+        std::unordered_map<std::string_view, uint32_t> m_ids;
+    };
+
+    /// Tuning for lines()
+    struct Options {
+        size_t window = 4096;       // Lines per side in the first window
+        size_t max_window = 1 << 20; // Windows double up to this size to resynchronize
+    };
+
+    /// Diff two line tables, calling sink with each change in order
+    ///
+    /// The common prefix and suffix are skipped with plain string compares, then
+    /// the middle is diffed in windows: lines are interned and run through Myers
+    /// one window at a time, changes followed by common lines inside the window
+    /// are emitted, and the next window starts at the first unsettled change.
+    /// Windows double while no progress is made, so large insertions still
+    /// resynchronize. The first change is therefore reported after reading a
+    /// few thousand lines rather than the whole input, and memory is bounded by
+    /// the window; the price is that a change straddling a window edge may come
+    /// out slightly less than minimal. Returns false if cancelled or stopped.
+    inline bool lines(const LineIndex &a, const LineIndex &b, const ChangeSink &sink,
+                      const std::atomic<bool> *cancel = nullptr, const Options &options = {}) {
+        size_t n = a.size(), m = b.size();
+        size_t prefix = 0;
+        while (prefix < n && prefix < m && a[prefix] == b[prefix]) {
+            prefix++;
+        }
+        size_t suffix = 0;
+        while (suffix < n - prefix && suffix < m - prefix && a[n - 1 - suffix] == b[m - 1 - suffix]) {
+            suffix++;
+        }
+
+        const size_t end_a = n - suffix;
+        const size_t end_b = m - suffix;
+        size_t pa = prefix, pb = prefix;
+        size_t window = std::max<size_t>(1, options.window);
+        LineInterner interner;
+        std::vector<uint32_t> ids_a, ids_b;
+        std::vector<Change> found;
+
+        while (pa < end_a || pb < end_b) {
+            if (cancel && cancel->load(std::memory_order_relaxed)) {
+                return false;
+            }
+            size_t wa = std::min(window, end_a - pa);
+            size_t wb = std::min(window, end_b - pb);
+            bool last = pa + wa == end_a && pb + wb == end_b;
+
+            interner.clear();
+            ids_a.resize(wa);
+            ids_b.resize(wb);
+            for (size_t i = 0; i < wa; i++) {
+                ids_a[i] = interner.intern(a[pa + i]);
+            }
+            for (size_t i = 0; i < wb; i++) {
+                ids_b[i] = interner.intern(b[pb + i]);
+            }
+
+            found.clear();
+            Myers<uint32_t> myers(ids_a.data(), wa, ids_b.data(), wb, cancel);
+            if (!myers.run([&](const Change &c) {
+                    found.push_back(c);
+                    return true;
+                })) {
+                return false;
+            }
+
+            // A change running into the end of either window may just be where the window was cut
+            size_t settled = found.size();
+            if (!last && settled > 0) {
+                const Change &tail = found.back();
+                if (tail.a + tail.a_len == wa || tail.b + tail.b_len == wb) {
+                    settled--;
+                }
+            }
+            for (size_t i = 0; i < settled; i++) {
+                const Change &c = found[i];
+                if (!sink({pa + c.a, c.a_len, pb + c.b, c.b_len})) {
+                    return false;
+                }
+            }
+
+            if (settled == found.size()) {
+                pa += wa; // Everything after the last change is common to both windows
+                pb += wb;
+            } else if (found.back().a > 0 || found.back().b > 0) {
+                pa += found.back().a;
+                pb += found.back().b;
+            } else if (window < options.max_window) {
+                window *= 2;
+            } else {
+                const Change &c = found.back(); // Give up resynchronizing: take the change as is
+                if (!sink({pa + c.a, c.a_len, pb + c.b, c.b_len})) {
+                    return false;
+                }
+                pa += c.a_len;
+                pb += c.b_len;
+            }
+        }
+        return true;
+    }
+
+    /// Byte range [begin, end) of the changed middle of two lines, after trimming
+    /// their common prefix and suffix at UTF-8 character boundaries
+    struct InlineRange {
+        size_t a_begin = 0, a_end = 0;
+        size_t b_begin = 0, b_end = 0;
+    };
+
+    inline InlineRange inline_changes(std::string_view a, std::string_view b) {
+        size_t prefix = 0;
+        size_t limit = std::min(a.size(), b.size());
+        while (prefix < limit && a[prefix] == b[prefix]) {
+            prefix++;
+        }
+        while (prefix > 0 && prefix < a.size() && (static_cast<unsigned char>(a[prefix]) & 0xC0) == 0x80) {
+            prefix--; // Don't split a multi-byte character
+        }
+        size_t suffix = 0;
+        limit -= prefix;
+        while (suffix < limit && a[a.size() - 1 - suffix] == b[b.size() - 1 - suffix]) {
+            suffix++;
+        }
+        while (suffix > 0 && (static_cast<unsigned char>(a[a.size() - suffix]) & 0xC0) == 0x80) {
+            suffix--;
+        }
+        return {prefix, a.size() - suffix, prefix, b.size() - suffix};
+    }
+
+} // namespace scan::diff
@@ -0,0 +1,162 @@
+#pragma once
+
+/// @file mapped_file.hpp
+/// @brief Read-only memory-mapped files
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace scan {
+
+    /// A read-only view of a whole file, mapped into memory
+    ///
+    /// Pages are loaded by the OS on first access, so opening a multi-GB file is
+    /// instant and only the parts actually read take up (reclaimable) memory.
+    /// On platforms without mmap support the file is read into a buffer instead.
+    class MappedFile {
+      public:
+        MappedFile() = default;
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept { swap(other); }
+        MappedFile &operator=(MappedFile &&other) noexcept {
+            if (this != &other) {
+                close();
+                swap(other);
+            }
+            return *this;
+        }
+
+        ~MappedFile() { close(); }
+
+        /// Map a file; on failure returns an empty mapping with error() set
+        static MappedFile open(const std::string &path) {
+            MappedFile f;
+            f.m_path = path;
+#ifdef _WIN32
+            std::ifstream in(path, std::ios::binary);
+            if (!in) {
+                f.m_error = "cannot open " + path;
+                return f;
+            }
+            f.m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            f.m_data = reinterpret_cast<const uint8_t *>(f.m_buffer.data());
+            f.m_size = f.m_buffer.size();
+#else
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                f.m_error = path + ": " + std::strerror(errno);
+                return f;
+            }
+            struct stat st {};
+            if (::fstat(fd, &st) != 0) {
+                f.m_error = path + ": " + std::strerror(errno);
+                ::close(fd);
+                return f;
+            }
+            if (!S_ISREG(st.st_mode)) {
+                f.m_error = path + ": not a regular file";
+                ::close(fd);
+                return f;
+            }
+            f.m_size = static_cast<size_t>(st.st_size);
+            if (f.m_size > 0) {
+                void *p = ::mmap(nullptr, f.m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) {
+                    f.m_error = path + ": " + std::strerror(errno);
+                    f.m_size = 0;
+                } else {
+                    f.m_data = static_cast<const uint8_t *>(p);
+                    f.m_mapped = true;
+                }
+            }
+            ::close(fd); // The mapping stays valid
+#endif
+            return f;
+        }
+
+        /// Wrap an in-memory copy of some bytes (useful for tests and generated data)
+        static MappedFile from_bytes(std::string bytes) {
+            MappedFile f;
+            f.m_buffer = std::move(bytes);
+            f.m_data = reinterpret_cast<const uint8_t *>(f.m_buffer.data());
+            f.m_size = f.m_buffer.size();
+            return f;
+        }
+
+        /// Hint that a range will be read front to back (e.g. before searching it)
+        void advise_sequential(size_t offset, size_t length) const {
+#ifndef _WIN32
+            if (!m_mapped || offset >= m_size) {
+                return;
+            }
+            long page = ::sysconf(_SC_PAGESIZE);
+            size_t start = offset - offset % static_cast<size_t>(page);
+            length = std::min(length + (offset - start), m_size - start);
+            ::madvise(const_cast<uint8_t *>(m_data) + start, length, MADV_SEQUENTIAL);
+#else
+            (void)offset;
+            (void)length;
+#endif
+        }
+
+        const uint8_t *data() const { return m_data; }
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        bool ok() const { return m_error.empty(); }
+        const std::string &error() const { return m_error; }
+        const std::string &path() const { return m_path; }
+
+      private:
+        const uint8_t *m_data = nullptr;
+        size_t m_size = 0;
+        bool m_mapped = false;
+        std::string m_buffer;
+        std::string m_path;
+        std::string m_error;
+
+        void close() {
+#ifndef _WIN32
+            if (m_mapped) {
+                ::munmap(const_cast<uint8_t *>(m_data), m_size);
+            }
+#endif
+            m_data = nullptr;
+            m_size = 0;
+            m_mapped = false;
+            m_buffer.clear();
+        }
+
+        void swap(MappedFile &other) noexcept {
+            std::swap(m_size, other.m_size);
+            std::swap(m_mapped, other.m_mapped);
+            std::swap(m_buffer, other.m_buffer);
+            std::swap(m_path, other.m_path);
+            std::swap(m_error, other.m_error);
+            std::swap(m_data, other.m_data);
+            // Buffer-backed data must point into the buffer we now own
+            if (!m_mapped && !m_buffer.empty()) {
+                m_data = reinterpret_cast<const uint8_t *>(m_buffer.data());
+            }
+            if (!other.m_mapped && !other.m_buffer.empty()) {
+                other.m_data = reinterpret_cast<const uint8_t *>(other.m_buffer.data());
+            }
+        }
+    };
+
+} // namespace scan
@@ -0,0 +1,295 @@
+#pragma once
+
+/// @file thread_pool.hpp
+/// @brief Work-stealing thread pool for rendering and background work
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace scan {
+
+    /// Which jobs a worker takes first: interactive ones run before any background job
+    enum class Priority : uint8_t {
+        Interactive, // Something the user is waiting on: a loading tree node, a render
+        Background,  // Long-running work whose result can wait: searches, diffs, scans
+    };
+
+    /// Cooperative cancellation flag shared between whoever starts a job and the job
+    ///
+    /// A job whose token is cancelled before it starts is skipped. A running job
+    /// should poll cancelled() and return early. Copies share the same flag.
+    class CancelToken {
+      public:
+        CancelToken() : m_flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+        /// A token that can never be cancelled (and costs no allocation)
+        static CancelToken none() { return CancelToken(nullptr); }
+
+        void cancel() const {
+            if (m_flag) {
+                m_flag->store(true, std::memory_order_release);
+            }
+        }
+
+        bool cancelled() const { return m_flag && m_flag->load(std::memory_order_acquire); }
+
+      private:
+        explicit CancelToken(std::shared_ptr<std::atomic<bool>> flag) : m_flag(std::move(flag)) {}
+
+        std::shared_ptr<std::atomic<bool>> m_flag;
+    };
+
+    /// A fixed set of worker threads, each with its own job deques
+    ///
+    /// A job submitted from a worker goes to that worker's deque, where it is
+    /// taken newest-first while its data is still in cache; jobs from other
+    /// threads are spread round-robin. An idle worker steals the oldest job
+    /// from another worker's deque. Every worker looks for interactive jobs in
+    /// all deques before it starts a background one.
+    ///
+    /// Jobs should not block for long: a blocked job holds its worker.
+    class ThreadPool {
+      public:
+        /// Start `threads` workers; 0 means one per hardware thread
+        explicit ThreadPool(size_t threads = 0) {
+            if (threads == 0) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            m_queues.reserve(threads);
+            for (size_t i = 0; i < threads; i++) {
+                m_queues.push_back(std::make_unique<Queue>());
+            }
+            m_workers.reserve(threads);
+            for (size_t i = 0; i < threads; i++) {
+                m_workers.emplace_back([this, i] { work(i); });
+            }
+        }
+
+        /// Finishes every queued job that is not cancelled, then joins the workers
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(m_sleep_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (auto &worker : m_workers) {
+                worker.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        size_t size() const { return m_workers.size(); }
+
+        /// True when called from one of this pool's workers, where waiting on another job of the pool can deadlock
+        bool in_worker() const { return current_worker().has_value(); }
+
+        /// Queue a job; the future yields its result or rethrows its exception
+        ///
+        /// If the token is cancelled before the job starts, the job is dropped
+        /// and the future reports `std::future_errc::broken_promise`.
+        template <typename F>
+        auto submit(F fn, Priority priority = Priority::Interactive, CancelToken token = CancelToken::none())
+            -> std::future<std::invoke_result_t<F>> {
+            using R = std::invoke_result_t<F>;
+            auto task = std::make_shared<std::packaged_task<R()>>(std::move(fn));
+            std::future<R> result = task->get_future();
+            push(Job{[task] { (*task)(); }, std::move(token)}, priority);
+            return result;
+        }
+
+        /// Queue a job with no result; it must not throw
+        void execute(std::function<void()> fn, Priority priority = Priority::Interactive,
+                     CancelToken token = CancelToken::none()) {
+            push(Job{std::move(fn), std::move(token)}, priority);
+        }
+
+        /// Run fn(0) .. fn(n - 1) across the pool and wait for all of them
+        ///
+        /// The calling thread takes indices too, so this never waits on an idle
+        /// queue and is safe to call from inside a pool job. The first exception
+        /// thrown by fn is rethrown here once every index has finished.
+        void parallel_for(size_t n, const std::function<void(size_t)> &fn, Priority priority = Priority::Interactive) {
+            if (n == 0) {
+                return;
+            }
+            if (n == 1) {
+                fn(0);
+                return;
+            }
+
+            struct Batch {
+                std::atomic<size_t> next{0};
+                size_t done = 0;
+                std::exception_ptr error;
+                std::mutex mutex;
+                std::condition_variable finished;
+            };
+            auto batch = std::make_shared<Batch>();
+
+            // Claim indices until none are left; fn is alive until the last one is done
+            auto drain = [batch, n, &fn] {
+                size_t finished = 0;
+                std::exception_ptr error;
+                for (size_t i; (i = batch->next.fetch_add(1)) < n;) {
+                    try {
+                        fn(i);
+                    } catch (...) {
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                    }
+                    finished++;
+                }
+                if (finished == 0) {
+                    return;
+                }
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                if (error && !batch->error) {
+                    batch->error = error;
+                }
+                batch->done += finished;
+                if (batch->done == n) {
+                    batch->finished.notify_all();
+                }
+            };
+
+            size_t helpers = std::min(n - 1, size());
+            for (size_t i = 0; i < helpers; i++) {
+                push(Job{drain, CancelToken::none()}, priority);
+            }
+            drain();
+
+            std::unique_lock<std::mutex> lock(batch->mutex);
+            batch->finished.wait(lock, [&] { return batch->done == n; });
+            if (batch->error) {
+                std::rethrow_exception(batch->error);
+            }
+        }
+
+      private:
+        struct Job {
+            std::function<void()> fn;
+            CancelToken token;
+        };
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Job> jobs[2]; // Indexed by Priority
+        };
+
+        /// Index of the calling thread's worker in this pool, or none
+        std::optional<size_t> current_worker() const {
+            auto [pool, index] = worker_identity();
+            if (pool == this) {
+                return index;
+            }
+            return std::nullopt;
+        }
+
+        static std::pair<const ThreadPool *, size_t> &worker_identity() {
+            static thread_local std::pair<const ThreadPool *, size_t> identity{nullptr, 0};
+            return identity;
+        }
+
+        void push(Job job, Priority priority) {
+            size_t q = current_worker().value_or(m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size());
+            // Count the job before a worker can take it, so take()'s decrement never runs first and wraps the counter
+            m_pending.fetch_add(1);
+            {
+                std::lock_guard<std::mutex> lock(m_queues[q]->mutex);
+                m_queues[q]->jobs[static_cast<size_t>(priority)].push_back(std::move(job));
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_sleep_mutex); // Pairs with the predicate check in work()
+            }
+            m_wake.notify_one();
+        }
+
+        /// Own deque newest-first, then steal oldest-first; all interactive jobs before any background one
+        std::optional<Job> take(size_t self) {
+            size_t n = m_queues.size();
+            for (size_t p = 0; p < 2; p++) {
+                {
+                    Queue &own = *m_queues[self];
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    if (!own.jobs[p].empty()) {
+                        Job job = std::move(own.jobs[p].back());
+                        own.jobs[p].pop_back();
+                        m_pending.fetch_sub(1);
+                        return job;
+                    }
+                }
+                for (size_t k = 1; k < n; k++) {
+                    Queue &victim = *m_queues[(self + k) % n];
+                    std::lock_guard<std::mutex> lock(victim.mutex);
+                    if (!victim.jobs[p].empty()) {
+                        Job job = std::move(victim.jobs[p].front());
+                        victim.jobs[p].pop_front();
+                        m_pending.fetch_sub(1);
+                        return job;
+                    }
+                }
+            }
+            return std::nullopt;
+        }
+
+        void work(size_t self) {
+            worker_identity() = {this, self};
+            for (;;) {
+                if (auto job = take(self)) {
+                    if (!job->token.cancelled()) {
+                        job->fn();
+                    }
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(m_sleep_mutex);
+                m_wake.wait(lock, [this] { return m_stop || m_pending.load() > 0; });
+                if (m_stop && m_pending.load() == 0) {
+                    return; // Stopping and drained
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::vector<std::thread> m_workers;
+        std::atomic<size_t> m_next{0};    // Round-robin target for jobs from outside the pool
+        std::atomic<size_t> m_pending{0}; // Queued jobs not yet taken
+        std::mutex m_sleep_mutex;
+        std::condition_variable m_wake;
+        bool m_stop = false;
+    };
+
+    /// Process-wide pool shared by the components, tea::async and user code, started on first use
+    ///
+    /// It has at least two workers, so one slow job cannot hold up everything else on a single-core machine.
+    /// The pool is never destroyed: like a detached thread, a job still running at exit does not delay it.
+    inline ThreadPool &default_pool() {
+        static ThreadPool *pool = new ThreadPool(std::max(2u, std::thread::hardware_concurrency()));
+        return *pool;
+    }
+
+    /// Adapter running parallel_for on pool, for libraries that take an executor hook
+    ///
+    /// For example `argu::Command::executor(scan::parallel_executor())` checks argu's batched
+    /// paths on the shared pool instead of on threads of argu's own.
+    inline std::function<void(size_t, const std::function<void(size_t)> &)>
+    parallel_executor(ThreadPool &pool = default_pool()) {
+        return [&pool](size_t n, const std::function<void(size_t)> &body) { pool.parallel_for(n, body); };
+    }
+
+} // namespace scan
@@ -0,0 +1,32 @@
+/// @file argu.cpp
+/// @brief Compiled-library build of argu (SCAN_HEADER_ONLY=OFF)
+///
+/// The parser, help generation, validators and human-friendly parsers are
+/// compiled here once instead of in every translation unit that includes
+/// <argu/argu.hpp>.
+
+#ifndef SCAN_COMPILED_LIB
+#error "src/argu/argu.cpp is only built with SCAN_COMPILED_LIB (cmake -DSCAN_HEADER_ONLY=OFF)"
+#endif
+
+#include <argu/argu.hpp>
+
+#include <argu/core/parser_impl.hpp>
+#include <argu/core/validators_impl.hpp>
+#include <argu/parsers/duration_impl.hpp>
+#include <argu/parsers/size_impl.hpp>
+
+namespace argu::detail {
+
+    template struct Converter<std::string>;
+    template struct Converter<bool>;
+    template struct Converter<int>;
+    template struct Converter<long>;
+    template struct Converter<long long>;
+    template struct Converter<unsigned>;
+    template struct Converter<unsigned long>;
+    template struct Converter<unsigned long long>;
+    template struct Converter<float>;
+    template struct Converter<double>;
+
+} // namespace argu::detail
@@ -0,0 +1,273 @@
+#pragma once
+
+/// @file bench.hpp
+/// @brief Minimal benchmark harness shared by the scan_bench_* tools
+///
+/// Each case is calibrated until one batch runs for at least `--min-time`
+/// seconds, then reported as ns/op, bytes emitted per op (whatever the case
+/// returns) and heap allocations per op. Results go to stdout as one JSON
+/// document so runs can be diffed or fed to a dashboard; a one-line summary
+/// per case goes to stderr.
+///
+/// Include this header from exactly one translation unit per executable: it
+/// replaces the global operator new/delete to count allocations.
+
+#include <argu/argu.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+namespace bench {
+
+    namespace detail {
+        inline std::atomic<uint64_t> allocs{0};
+        inline std::atomic<uint64_t> alloc_bytes{0};
+    } // namespace detail
+
+} // namespace bench
+
+void *operator new(std::size_t size) {
+    bench::detail::allocs.fetch_add(1, std::memory_order_relaxed);
+    bench::detail::alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t size) { return operator new(size); }
+// Out of line, so GCC does not pair the inlined free() with a `new` expression and warn
+BENCH_NOINLINE void operator delete(void *p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete[](void *p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+namespace bench {
+
+    struct Result {
+        std::string name;
+        uint64_t iterations = 0;
+        double ns_per_op = 0;
+        double bytes_per_op = 0;       // Output produced, as returned by the case
+        double allocs_per_op = 0;      // Calls to operator new
+        double alloc_bytes_per_op = 0; // Bytes requested from operator new
+    };
+
+    /// A named group of benchmark cases sharing the command-line options
+    ///
+    ///     bench::Suite suite("scan_bench_render");
+    ///     if (int rc = suite.parse(argc, argv); rc >= 0) return rc;
+    ///     if (suite.wants("view/list")) {
+    ///         ListModel m = ...;                       // Setup is skipped when filtered out
+    ///         suite.run("view/list/10k", [&] { return list_view(m).size(); });
+    ///     }
+    ///     return suite.finish();
+    class Suite {
+      public:
+        explicit Suite(std::string name) : m_name(std::move(name)) {}
+
+        /// Read --min-time / --filter / --list; returns an exit code if the program should stop, else -1
+        int parse(int argc, char **argv) {
+            auto cmd = argu::Command(m_name)
+                           .about("Benchmarks; prints one JSON document with ns/op, bytes and allocations per op")
+                           .arg(argu::Arg("min-time").long_name("min-time").help("Seconds each case runs for (at least)")
+                                    .value_of(m_min_time))
+                           .arg(argu::Arg("filter").long_name("filter").short_name('f')
+                                    .help("Run only cases whose name contains this text").value_of(m_filter))
+                           .arg(argu::Arg("list").long_name("list").help("Print the case names and exit").flag(m_list));
+            auto result = cmd.parse(argc, argv);
+            if (result.should_exit()) {
+                return result.exit();
+            }
+            return -1;
+        }
+
+        /// Record a build or input property in the report, e.g. `info("simd", "avx2")`
+        Suite &info(std::string key, std::string value) {
+            m_info.emplace_back(std::move(key), std::move(value));
+            return *this;
+        }
+
+        /// True if any case starting with `prefix` passes the filter (guards expensive setup)
+        bool wants(const std::string &prefix) const {
+            return m_filter.empty() || prefix.find(m_filter) != std::string::npos ||
+                   m_filter.find(prefix) != std::string::npos;
+        }
+
+        /// Run `op` (returning the bytes it produced) in calibrated batches and record the result
+        template <typename Op> void run(const std::string &name, Op &&op) {
+            if (!m_filter.empty() && name.find(m_filter) == std::string::npos) {
+                return;
+            }
+            if (m_list) {
+                std::printf("%s\n", name.c_str());
+                return;
+            }
+
+            op(); // Warm caches and lazily built state
+            uint64_t n = 1;
+            for (;;) {
+                Result r = measure(name, n, op);
+                double seconds = r.ns_per_op * static_cast<double>(n) * 1e-9;
+                if (seconds >= m_min_time || n >= max_iterations) {
+                    std::fprintf(stderr, "%-40s %14.1f ns/op %12.0f B/op %10.1f allocs/op\n", name.c_str(), r.ns_per_op,
+                                 r.bytes_per_op, r.allocs_per_op);
+                    m_results.push_back(std::move(r));
+                    return;
+                }
+                // Aim a little past the target so the next batch is usually the last
+                double scale = seconds > 0 ? m_min_time * 1.4 / seconds : 100.0;
+                n = std::clamp(static_cast<uint64_t>(static_cast<double>(n) * scale), n + 1, n * 100);
+            }
+        }
+
+        /// Print the JSON report; returns the process exit code
+        int finish() const {
+            if (m_list) {
+                return 0;
+            }
+            std::printf("{\n  \"benchmark\": \"%s\",\n  \"min_time\": %g,\n", m_name.c_str(), m_min_time);
+            for (const auto &[key, value] : m_info) {
+                std::printf("  \"%s\": \"%s\",\n", escape(key).c_str(), escape(value).c_str());
+            }
+            std::printf("  \"results\": [");
+            for (size_t i = 0; i < m_results.size(); i++) {
+                const Result &r = m_results[i];
+                std::printf("%s\n    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.2f, \"bytes_per_op\": %.1f, "
+                            "\"allocs_per_op\": %.2f, \"alloc_bytes_per_op\": %.1f}",
+                            i > 0 ? "," : "", escape(r.name).c_str(), static_cast<unsigned long long>(r.iterations),
+                            r.ns_per_op, r.bytes_per_op, r.allocs_per_op, r.alloc_bytes_per_op);
+            }
+            std::printf("\n  ]\n}\n");
+            std::fflush(stdout);
+            return 0;
+        }
+
+        const std::vector<Result> &results() const { return m_results; }
+
+      private:
+        static constexpr uint64_t max_iterations = 1'000'000'000;
+
+        template <typename Op> Result measure(const std::string &name, uint64_t n, Op &op) {
+            uint64_t bytes = 0;
+            uint64_t allocs0 = detail::allocs.load(std::memory_order_relaxed);
+            uint64_t alloc_bytes0 = detail::alloc_bytes.load(std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < n; i++) {
+                bytes += static_cast<uint64_t>(op());
+            }
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            uint64_t allocs = detail::allocs.load(std::memory_order_relaxed) - allocs0;
+            uint64_t alloc_bytes = detail::alloc_bytes.load(std::memory_order_relaxed) - alloc_bytes0;
+            m_sink = m_sink + bytes; // Keeps the results observable so the loop isn't optimized away
+
+            double ops = static_cast<double>(n);
+            Result r;
+            r.name = name;
+            r.iterations = n;
+            r.ns_per_op = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / ops;
+            r.bytes_per_op = static_cast<double>(bytes) / ops;
+            r.allocs_per_op = static_cast<double>(allocs) / ops;
+            r.alloc_bytes_per_op = static_cast<double>(alloc_bytes) / ops;
+            return r;
+        }
+
+        static std::string escape(const std::string &s) {
+            std::string out;
+            for (char c : s) {
+                if (c == '"' || c == '\\') {
+                    out += '\\';
+                }
+                out += c;
+            }
+            return out;
+        }
+
+        std::string m_name;
+        double m_min_time = 0.2;
+        std::string m_filter;
+        bool m_list = false;
+        std::vector<std::pair<std::string, std::string>> m_info;
+        std::vector<Result> m_results;
+        volatile uint64_t m_sink = 0;
+    };
+
+#ifndef _WIN32
+    /// Redirects stdout into an in-memory file while alive, counting what is written
+    ///
+    /// Code that writes to the terminal through stdio (the Renderer) runs
+    /// unchanged; take() reports the bytes written since the previous call.
+    class StdoutSink {
+      public:
+        StdoutSink() {
+            std::fflush(stdout);
+            m_saved = ::dup(STDOUT_FILENO);
+#ifdef __linux__
+            int fd = ::memfd_create("scan-bench-sink", 0);
+#else
+            int fd = -1;
+#endif
+            if (fd < 0) {
+                std::FILE *tmp = std::tmpfile();
+                fd = tmp ? ::dup(::fileno(tmp)) : ::open("/dev/null", O_WRONLY);
+                if (tmp) {
+                    std::fclose(tmp);
+                }
+            }
+            ::dup2(fd, STDOUT_FILENO);
+            ::close(fd);
+        }
+
+        ~StdoutSink() {
+            std::fflush(stdout);
+            ::dup2(m_saved, STDOUT_FILENO);
+            ::close(m_saved);
+        }
+
+        StdoutSink(const StdoutSink &) = delete;
+        StdoutSink &operator=(const StdoutSink &) = delete;
+
+        /// Bytes written since the last call; the file is rewound once it grows large
+        size_t take() {
+            std::fflush(stdout);
+            off_t end = ::lseek(STDOUT_FILENO, 0, SEEK_CUR);
+            if (end < 0) {
+                return 0; // /dev/null fallback
+            }
+            size_t n = static_cast<size_t>(end - m_last);
+            m_last = end;
+            if (end > (64 << 20)) {
+                if (::ftruncate(STDOUT_FILENO, 0) == 0) {
+                    ::lseek(STDOUT_FILENO, 0, SEEK_SET);
+                    m_last = 0;
+                }
+            }
+            return n;
+        }
+
+      private:
+        int m_saved = -1;
+        off_t m_last = 0;
+    };
+#endif
+
+} // namespace bench
@@ -0,0 +1,287 @@
+/// @file render.cpp
+/// @brief `scan_bench_render`: cost of styling, layout, component views and terminal output
+///
+///     scan_bench_render                       run every case, JSON on stdout
+///     scan_bench_render --filter view/        only the component views
+///     scan_bench_render --min-time 1 > a.json longer, steadier runs
+///
+/// Component views are measured at the sizes they meet in practice (a 1k-row
+/// table, a 10k-item list, a 100k-line viewport) with the cursor mid-way, so
+/// any cost that grows with the content rather than the window shows up.
+/// Renderer cases write through stdio into an in-memory file, which also
+/// counts the bytes a frame puts on the terminal.
+
+#include "bench.hpp"
+
+#include <scan/scan.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace scan;
+
+namespace {
+
+    /// Deterministic line of words, about `width` columns
+    std::string words(size_t seed, size_t width = 60) {
+        static const char *vocabulary[] = {"alpha", "bravo",   "charlie", "delta", "echo",   "foxtrot", "golf",
+                                           "hotel", "india",   "juliett", "kilo",  "lima",   "mike",    "november",
+                                           "oscar", "papa",    "quebec",  "romeo", "sierra", "tango",   "uniform"};
+        std::string s;
+        uint64_t x = seed * 0x9E3779B97F4A7C15ull + 1;
+        while (s.size() < width) {
+            x ^= x >> 33;
+            x *= 0xFF51AFD7ED558CCDull;
+            x ^= x >> 29;
+            if (!s.empty()) {
+                s += ' ';
+            }
+            s += vocabulary[x % (sizeof(vocabulary) / sizeof(vocabulary[0]))];
+        }
+        return s;
+    }
+
+    std::vector<std::string> lines(size_t n, size_t width = 60) {
+        std::vector<std::string> out;
+        out.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            out.push_back(std::to_string(i) + " " + words(i, width));
+        }
+        return out;
+    }
+
+    std::string joined(size_t n, size_t width = 60) {
+        std::string out;
+        for (const auto &l : lines(n, width)) {
+            out += l;
+            out += '\n';
+        }
+        return out;
+    }
+
+    void bench_style(bench::Suite &suite) {
+        auto theme = theme_snapshot();
+        const auto &c = theme->colors;
+        std::string text = "The quick brown fox jumps over the lazy dog";
+
+        suite.run("style/render/plain", [&] { return Style().render(text).size(); });
+        suite.run("style/render/fg_bold", [&] { return Style().foreground(c.primary).bold().render(text).size(); });
+        suite.run("style/render/fg_bg_padding", [&] {
+            return Style().foreground(c.text).background(c.bg_muted).padding(0, 1).render(text).size();
+        });
+        suite.run("style/render/border_width_40", [&] {
+            return Style().border(BorderStyle::Rounded).border_foreground(c.border).padding(1).width(40).render(
+                text + "\n" + text).size();
+        });
+        suite.run("style/render/align_center_80", [&] {
+            return Style().width(80).align(Position::Center).foreground(c.secondary).render(text).size();
+        });
+
+        std::string ascii = words(1, 80);
+        std::string styled = Style().foreground(c.primary).bold().render(ascii.substr(0, 40)) +
+                             Style().foreground(c.secondary).render(ascii.substr(40));
+        std::string wide = "表格 列表 视口 数据 终端 界面 样式 宽度 渲染 组件 分页 文本 输入 确认 过滤 树形";
+        suite.run("style/visible_width/ascii_80", [&] { return static_cast<size_t>(visible_width(ascii)); });
+        suite.run("style/visible_width/ansi_80", [&] { return static_cast<size_t>(visible_width(styled)); });
+        suite.run("style/visible_width/cjk_80", [&] { return static_cast<size_t>(visible_width(wide)); });
+
+        std::vector<std::string> blocks;
+        for (size_t b = 0; b < 3; b++) {
+            blocks.push_back(Style().border(BorderStyle::Rounded).render(joined(20, 24 + b * 4)));
+        }
+        suite.run("style/join_horizontal/3x22_lines",
+                  [&] { return join_horizontal(Position::Top, blocks).size(); });
+        suite.run("style/join_vertical/3x22_lines",
+                  [&] { return join_vertical(Position::Center, blocks).size(); });
+    }
+
+    void bench_views(bench::Suite &suite) {
+        if (suite.wants("view/table")) {
+            TableModel m;
+            m.headers = {"ID", "Name", "Status", "Description"};
+            for (size_t i = 0; i < 1000; i++) {
+                m.rows.push_back({std::to_string(i), words(i, 8), i % 3 ? "ok" : "failed", words(i + 7, 40)});
+            }
+            m.height = 20;
+            m.cursor = m.offset = 500;
+            suite.run("view/table/1k_rows", [&] { return table_view(m).size(); });
+        }
+
+        if (suite.wants("view/list")) {
+            ListModel m;
+            m.items = lines(10000, 40);
+            m.height = 20;
+            m.cursor = m.offset = 5000;
+            suite.run("view/list/10k_items", [&] { return list_view(m).size(); });
+        }
+
+        if (suite.wants("view/viewport") || suite.wants("view/pager")) {
+            std::string content = joined(100000, 70);
+            ViewportModel v;
+            v.width = 100;
+            v.height = 40;
+            viewport_set_content(v, content);
+            v.y_offset = 50000;
+            suite.run("view/viewport/100k_lines", [&] { return viewport_view(v).size(); });
+
+            PagerModel p;
+            p.viewport = v;
+            p.title = "bench.log";
+            p.show_line_numbers = true;
+            suite.run("view/pager/100k_lines", [&] { return pager_view(p).size(); });
+        }
+
+        if (suite.wants("view/textinput")) {
+            TextInputModel m;
+            m.value = words(3, 30);
+            m.cursor = 12;
+            suite.run("view/textinput", [&] { return textinput_view(m).size(); });
+        }
+
+        if (suite.wants("view/textarea")) {
+            TextAreaModel m;
+            textarea_set_value(m, joined(1000, 50));
+            m.height = 20;
+            m.show_line_numbers = true;
+            m.cursor_row = m.offset_row = 500;
+            suite.run("view/textarea/1k_lines", [&] { return textarea_view(m).size(); });
+        }
+
+        if (suite.wants("view/confirm")) {
+            ConfirmModel m;
+            m.prompt = "Deploy to production?";
+            suite.run("view/confirm", [&] { return confirm_view(m).size(); });
+        }
+
+        if (suite.wants("view/filter")) {
+            FilterModel m;
+            m.items = lines(10000, 40);
+            m.height = 20;
+            m.query = "alpha";
+            filter_refresh(m);
+            suite.run("view/filter/10k_items", [&] { return filter_view(m).size(); });
+        }
+
+        if (suite.wants("view/tree")) {
+            TreeModel m;
+            std::vector<TreeItem> roots;
+            for (size_t i = 0; i < 10000; i++) {
+                roots.push_back({words(i, 20), std::to_string(i), i % 10 == 0});
+            }
+            tree_set_roots(m, roots);
+            m.height = 20;
+            m.cursor = m.offset = 5000;
+            suite.run("view/tree/10k_nodes", [&] { return tree_view(m).size(); });
+        }
+
+        if (suite.wants("view/logview")) {
+            LogViewModel m;
+            std::string text;
+            for (size_t i = 0; i < 100000; i++) {
+                text += (i % 7 == 0 ? "WARN " : "INFO ") + words(i, 60) + "\n";
+            }
+            logview_add_lines(m, text);
+            m.height = 40;
+            suite.run("view/logview/100k_lines", [&] { return logview_view(m).size(); });
+        }
+
+        if (suite.wants("view/chart") || suite.wants("view/sparkline")) {
+            ChartModel chart;
+            SparklineModel spark;
+            for (size_t i = 0; i < 100000; i++) {
+                double v = static_cast<double>((i * 7919) % 1000) / 10.0;
+                chart.series.push(v);
+                spark.series.push(v);
+            }
+            chart.width = 80;
+            chart.height = 12;
+            suite.run("view/chart/100k_points", [&] { return chart_view(chart).size(); });
+            suite.run("view/sparkline/100k_points", [&] { return sparkline_view(spark).size(); });
+        }
+
+        if (suite.wants("view/hexview")) {
+            HexViewModel m;
+            std::string bytes(1 << 20, '\0');
+            for (size_t i = 0; i < bytes.size(); i++) {
+                bytes[i] = static_cast<char>((i * 31) & 0xFF);
+            }
+            m.file = std::make_shared<MappedFile>(MappedFile::from_bytes(std::move(bytes)));
+            m.cursor = m.offset = 512 * 1024;
+            suite.run("view/hexview/1MiB", [&] { return hexview_view(m).size(); });
+        }
+
+        if (suite.wants("view/diffview")) {
+            std::vector<std::string> a = lines(10000, 50), b = a;
+            for (size_t i = 0; i < b.size(); i += 97) {
+                b[i] = "changed " + b[i];
+            }
+            std::string ta, tb;
+            for (size_t i = 0; i < a.size(); i++) {
+                ta += a[i] + "\n";
+                tb += b[i] + "\n";
+            }
+            DiffViewModel m;
+            diffview_set_texts(m, ta, tb);
+            if (auto msg = diffview_start(m)()) { // No program running: the diff completes synchronously
+                m = diffview_update(std::move(m), *msg).first;
+            }
+            m.width = 120;
+            m.height = 40;
+            m.offset = m.total_rows / 2;
+            suite.run("view/diffview/10k_lines", [&] { return diffview_view(m).size(); });
+        }
+    }
+
+#ifndef _WIN32
+    void bench_renderer(bench::Suite &suite) {
+        if (!suite.wants("renderer/")) {
+            return;
+        }
+        // Realistic frames: a 40-row list, scrolled by one line, and an unrelated 40-line page
+        ListModel list;
+        list.items = lines(1000, 60);
+        list.height = 40;
+        std::string frame = list_view(list);
+        list.cursor = 1;
+        std::string moved = list_view(list);
+        std::string other = joined(40, 70);
+
+        bench::StdoutSink sink;
+        suite.run("renderer/first_frame/40_lines", [&] {
+            render::Renderer r;
+            r.render(frame);
+            return sink.take();
+        });
+
+        render::Renderer r;
+        bool flip = false;
+        suite.run("renderer/cursor_move/40_lines", [&] {
+            r.render((flip = !flip) ? moved : frame);
+            return sink.take();
+        });
+        suite.run("renderer/full_change/40_lines", [&] {
+            r.render((flip = !flip) ? other : frame);
+            return sink.take();
+        });
+        suite.run("renderer/unchanged/40_lines", [&] {
+            r.render(frame);
+            return sink.take();
+        });
+    }
+#endif
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bench::Suite suite("scan_bench_render");
+    if (int rc = suite.parse(argc, argv); rc >= 0) {
+        return rc;
+    }
+
+    bench_style(suite);
+    bench_views(suite);
+#ifndef _WIN32
+    bench_renderer(suite);
+#endif
+    return suite.finish();
+}
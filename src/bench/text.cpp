@@ -0,0 +1,196 @@
+/// @file text.cpp
+/// @brief `scan_bench_text`: cost of the UTF-8 and width utilities on realistic text
+///
+///     scan_bench_text                          every function, input kind and size
+///     scan_bench_text --filter /log/           only the log-like input
+///     scan_bench_text --filter display_width   one function across all inputs
+///
+/// Every function in util/utf8.hpp, plus `visible_width`, `truncate` and
+/// `pad_*`, runs over five kinds of input (ASCII, mixed Latin, CJK,
+/// emoji-heavy and colored log lines) at sizes from 16 B to 16 MiB. Positions
+/// (insert, erase, byte_index, ...) are mid-string, where offset lookups cost
+/// the most. `bytes_per_op` is the input size, so bytes_per_op / ns_per_op
+/// is the throughput in GB/s.
+///
+/// The report's "simd" field says which byte-search path was compiled in;
+/// build once with `-DSCAN_ENABLE_SIMD=ON` and once with `OFF` and compare.
+/// The `bytes/find` cases put the vector and scalar search side by side in
+/// the same run.
+
+#include "bench.hpp"
+
+#include <scan/scan.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace scan;
+
+namespace {
+
+    struct Input {
+        std::string kind;
+        std::string size; // Label: "16B", "4KiB", ...
+        std::string text;
+        size_t length = 0; // Codepoints
+        size_t width = 0;  // Visible columns
+    };
+
+    /// Deterministic text of one kind, built from pieces until it reaches `bytes`
+    std::string generate(const std::string &kind, size_t bytes) {
+        static const std::vector<const char *> ascii = {"alpha", "bravo", "charlie", "delta", "echo", "foxtrot",
+                                                        "request", "timeout", "42", "done", "/var/log/app"};
+        static const std::vector<const char *> latin = {"café", "naïve", "Übermaß", "señor", "Ærøskøbing",
+                                                        "déjà", "vu", "über", "façade", "and", "the"};
+        static const std::vector<const char *> cjk = {"日本語", "中文", "한국어", "表格", "终端", "界面",
+                                                      "ｆｕｌｌ", "データ", "文字列", "幅"};
+        static const std::vector<const char *> emoji = {"🚀", "✨", "🔥", "👍", "🎉", "✅", "ok", "👨‍💻",
+                                                        "done", "🇩🇪", "❤️"};
+
+        std::string s;
+        s.reserve(bytes + 128);
+        uint64_t x = 0x9E3779B97F4A7C15ull;
+        auto next = [&x] {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            return x;
+        };
+        if (kind == "log") {
+            static const char *levels[] = {"\033[32mINFO\033[0m ", "\033[33mWARN\033[0m ", "\033[31mERROR\033[0m",
+                                           "\033[2mDEBUG\033[0m"};
+            for (uint64_t line = 0; s.size() < bytes; line++) {
+                s += "2026-03-14T09:26:";
+                s += std::to_string(10 + line % 50);
+                s += ".";
+                s += std::to_string(100 + line % 900);
+                s += "Z ";
+                s += levels[next() % 4];
+                s += " [worker-" + std::to_string(line % 8) + "] ";
+                s += ascii[next() % ascii.size()];
+                s += next() % 5 == 0 ? " café ✓ 完了" : " id=";
+                s += std::to_string(next() % 100000);
+                s += " took " + std::to_string(next() % 500) + "ms\n";
+            }
+        } else {
+            const auto &pieces = kind == "ascii" ? ascii : kind == "latin" ? latin : kind == "cjk" ? cjk : emoji;
+            while (s.size() < bytes) {
+                // Mixed inputs keep some ASCII between the other pieces, as real text does
+                bool plain = kind == "latin" || kind == "emoji" ? next() % 3 == 0 : false;
+                s += plain ? ascii[next() % ascii.size()] : pieces[next() % pieces.size()];
+                s += ' ';
+            }
+        }
+        // Cut at a character boundary at or below the target size
+        size_t cut = std::min(bytes, s.size());
+        while (cut > 0 && cut < s.size() && utf8::is_continuation(static_cast<unsigned char>(s[cut]))) {
+            cut--;
+        }
+        s.resize(cut);
+        return s;
+    }
+
+    std::string size_label(size_t bytes) {
+        if (bytes >= (1u << 20)) {
+            return std::to_string(bytes >> 20) + "MiB";
+        }
+        if (bytes >= (1u << 10)) {
+            return std::to_string(bytes >> 10) + "KiB";
+        }
+        return std::to_string(bytes) + "B";
+    }
+
+    std::vector<Input> inputs() {
+        std::vector<Input> out;
+        for (const char *kind : {"ascii", "latin", "cjk", "emoji", "log"}) {
+            std::string all = generate(kind, 16u << 20);
+            for (size_t bytes = 16; bytes <= (16u << 20); bytes *= 16) {
+                Input in;
+                in.kind = kind;
+                in.size = size_label(bytes);
+                in.text = all.substr(0, bytes);
+                while (!in.text.empty() && in.text.size() < all.size() &&
+                       utf8::is_continuation(static_cast<unsigned char>(all[in.text.size()]))) {
+                    in.text.pop_back();
+                }
+                in.length = utf8::length(in.text);
+                in.width = visible_width(in.text);
+                out.push_back(std::move(in));
+            }
+        }
+        return out;
+    }
+
+    /// Run one function over every input, as "<name>/<kind>/<size>"
+    template <typename Fn> void each(bench::Suite &suite, const std::vector<Input> &all, const std::string &name, Fn fn) {
+        for (const auto &in : all) {
+            suite.run(name + "/" + in.kind + "/" + in.size, [&] {
+                fn(in);
+                return in.text.size();
+            });
+        }
+    }
+
+    /// Keeps a result alive so the call isn't optimized away
+    template <typename T> void keep(const T &value) {
+        static volatile size_t sink;
+        if constexpr (requires { value.size(); }) {
+            sink = value.size();
+        } else {
+            sink = static_cast<size_t>(value);
+        }
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bench::Suite suite("scan_bench_text");
+    if (int rc = suite.parse(argc, argv); rc >= 0) {
+        return rc;
+    }
+#if defined(SCAN_BYTES_SIMD) && defined(__AVX2__)
+    suite.info("simd", "avx2");
+#elif defined(SCAN_BYTES_SIMD)
+    suite.info("simd", "sse2");
+#else
+    suite.info("simd", "off");
+#endif
+
+    auto all = inputs();
+
+    each(suite, all, "utf8/length", [](const Input &in) { keep(utf8::length(in.text)); });
+    each(suite, all, "utf8/display_width", [](const Input &in) { keep(utf8::display_width(in.text)); });
+    each(suite, all, "utf8/decode", [](const Input &in) { keep(utf8::decode(in.text)); });
+    if (suite.wants("utf8/encode")) {
+        for (const auto &in : all) {
+            auto codepoints = utf8::decode(in.text);
+            suite.run("utf8/encode/" + in.kind + "/" + in.size, [&] {
+                keep(utf8::encode(codepoints));
+                return in.text.size();
+            });
+        }
+    }
+    each(suite, all, "utf8/substring", [](const Input &in) { keep(utf8::substring(in.text, in.length / 2, 64)); });
+    each(suite, all, "utf8/insert", [](const Input &in) { keep(utf8::insert(in.text, in.length / 2, "✓ ok")); });
+    each(suite, all, "utf8/erase", [](const Input &in) { keep(utf8::erase(in.text, in.length / 2, 8)); });
+    each(suite, all, "utf8/byte_index", [](const Input &in) { keep(utf8::byte_index(in.text, in.length / 2)); });
+
+    each(suite, all, "style/visible_width", [](const Input &in) { keep(visible_width(in.text)); });
+    each(suite, all, "style/truncate", [](const Input &in) { keep(truncate(in.text, in.width / 2)); });
+    each(suite, all, "style/pad_right", [](const Input &in) { keep(pad_right(in.text, in.width + 16)); });
+    each(suite, all, "style/pad_left", [](const Input &in) { keep(pad_left(in.text, in.width + 16)); });
+    each(suite, all, "style/pad_center", [](const Input &in) { keep(pad_center(in.text, in.width + 16)); });
+
+    // A pattern that never occurs, so the whole input is scanned
+    std::string needle = "connection reset by peer";
+    auto pattern = reinterpret_cast<const uint8_t *>(needle.data());
+    each(suite, all, "bytes/find", [&](const Input &in) {
+        keep(bytes::find(reinterpret_cast<const uint8_t *>(in.text.data()), in.text.size(), pattern, needle.size()));
+    });
+    each(suite, all, "bytes/find_scalar", [&](const Input &in) {
+        keep(bytes::find_scalar(reinterpret_cast<const uint8_t *>(in.text.data()), in.text.size(), pattern,
+                                needle.size()));
+    });
+
+    return suite.finish();
+}
@@ -0,0 +1,595 @@
+/// @file main.cpp
+/// @brief `scan` command-line tool: the components as subcommands for shell scripts
+///
+///     ls | scan filter                 fuzzy-pick one line of stdin
+///     scan choose red green blue       pick from arguments
+///     scan input --placeholder Name    read a line
+///     scan confirm "Deploy?"           exit status 0 for yes, 1 for no
+///     make 2>&1 | scan pager           scroll through output as it arrives
+///     scan table < data.csv            pick a row
+///     scan spin --title Build -- make  run a command behind a spinner
+///
+/// The interface is drawn on the terminal and only the result goes to stdout,
+/// so `x=$(... | scan filter)` works. Items piped on stdin are read on a
+/// separate thread and stream into the running view; the first frame does not
+/// wait for them. Installed as (or symlinked to) `scan-filter` etc. the tool
+/// behaves like `scan filter`.
+
+#include <argu/argu.hpp>
+#include <scan/scan.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifndef SCAN_VERSION
+#define SCAN_VERSION "0.0.0"
+#endif
+
+namespace {
+
+    /// Exit status when the user cancels with Escape or Ctrl+C
+    constexpr int exit_cancelled = 130;
+
+    /// Where items come from and where results go
+    struct Io {
+        int items = -1;         // Piped stdin, if any
+        int out = STDOUT_FILENO; // The original stdout
+    };
+
+    /// Move piped stdin / captured stdout aside and put the terminal in their place
+    ///
+    /// The components read keys from stdin and draw on stdout; when either is
+    /// redirected, it is swapped for /dev/tty and the original is kept for
+    /// reading items or writing the result.
+    Io attach_terminal() {
+        Io io;
+#ifndef _WIN32
+        bool in_tty = ::isatty(STDIN_FILENO) != 0;
+        bool out_tty = ::isatty(STDOUT_FILENO) != 0;
+        if (in_tty && out_tty) {
+            return io;
+        }
+        int tty = ::open("/dev/tty", O_RDWR | O_CLOEXEC);
+        if (tty < 0) {
+            return io;
+        }
+        if (!in_tty) {
+            io.items = ::dup(STDIN_FILENO);
+            ::dup2(tty, STDIN_FILENO);
+        }
+        if (!out_tty) {
+            std::fflush(stdout);
+            io.out = ::dup(STDOUT_FILENO);
+            ::dup2(tty, STDOUT_FILENO);
+        }
+        ::close(tty);
+#endif
+        return io;
+    }
+
+    void write_all(int fd, std::string_view s) {
+#ifndef _WIN32
+        while (!s.empty()) {
+            ssize_t n = ::write(fd, s.data(), s.size());
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return;
+            }
+            s.remove_prefix(static_cast<size_t>(n));
+        }
+#else
+        (void)fd;
+        std::fwrite(s.data(), 1, s.size(), stdout);
+#endif
+    }
+
+    void write_lines(int fd, const std::vector<std::string> &lines) {
+        std::string out;
+        for (const auto &line : lines) {
+            out += line;
+            out += '\n';
+        }
+        write_all(fd, out);
+    }
+
+    /// Read a whole file descriptor (for inputs that need every row before showing, like tables)
+    std::string read_all(int fd) {
+        std::string data;
+        scan::log_read_fd(fd)([&](std::string_view text) {
+            data.append(text);
+            return true;
+        });
+        return data;
+    }
+
+    /// Run a program while lines from fd stream into it as LogMsg{id} batches
+    template <typename Model> Model run_fed(scan::tea::Program<Model> &program, int fd, int id) {
+        return scan::run_with_producer(program, fd < 0 ? scan::LogProducer() : scan::log_read_fd(fd), id);
+    }
+
+    /// Split one CSV-style record; double quotes group separators and "" is a literal quote
+    std::vector<std::string> split_record(std::string_view line, char sep) {
+        std::vector<std::string> fields(1);
+        bool quoted = false;
+        for (size_t i = 0; i < line.size(); i++) {
+            char c = line[i];
+            if (c == '"') {
+                if (quoted && i + 1 < line.size() && line[i + 1] == '"') {
+                    fields.back() += '"';
+                    i++;
+                } else {
+                    quoted = !quoted;
+                }
+            } else if (c == sep && !quoted) {
+                fields.emplace_back();
+            } else if (c != '\r') {
+                fields.back() += c;
+            }
+        }
+        return fields;
+    }
+
+    // ========== Subcommands ==========
+
+    struct FilterArgs {
+        std::string prompt = "> ";
+        std::string placeholder = "Type to filter...";
+        std::string value;
+        int height = 10;
+        size_t limit = 1;
+        bool no_limit = false;
+        bool case_sensitive = false;
+    };
+
+    int run_filter(const FilterArgs &a, const std::vector<std::string> &items, const Io &io) {
+        if (items.empty() && io.items < 0) {
+            std::fprintf(stderr, "scan filter: no items (pass them as arguments or pipe them on stdin)\n");
+            return 2;
+        }
+        scan::Filter filter;
+        filter.items(items).prompt(a.prompt).placeholder(a.placeholder).height(a.height).case_sensitive(
+            a.case_sensitive);
+        if (!a.value.empty()) {
+            filter.query(a.value);
+        }
+        scan::FilterModel model = filter.model();
+        model.limit = a.no_limit ? 0 : a.limit;
+        model.loading = io.items >= 0;
+
+        auto init = [&]() -> std::pair<scan::FilterModel, scan::tea::Cmd> { return {model, scan::tea::none()}; };
+        auto update = [](scan::FilterModel m, scan::tea::Msg msg) { return scan::filter_update(std::move(m), msg); };
+        auto view = [](const scan::FilterModel &m) { return scan::filter_view(m); };
+        scan::tea::Program<scan::FilterModel> program(init, update, view);
+        auto result = run_fed(program, io.items, model.id);
+
+        if (result.cancelled) {
+            return exit_cancelled;
+        }
+        std::vector<std::string> chosen;
+        for (size_t idx : result.selected) {
+            if (idx < result.items.size()) {
+                chosen.push_back(result.items[idx]);
+            }
+        }
+        write_lines(io.out, chosen);
+        return chosen.empty() ? 1 : 0;
+    }
+
+    struct ChooseArgs {
+        int height = 10;
+        size_t limit = 1;
+        bool no_limit = false;
+        std::string cursor = ">";
+    };
+
+    int run_choose(const ChooseArgs &a, const std::vector<std::string> &items, const Io &io) {
+        if (items.empty() && io.items < 0) {
+            std::fprintf(stderr, "scan choose: no items (pass them as arguments or pipe them on stdin)\n");
+            return 2;
+        }
+        scan::ListModel model = scan::List().items(items).height(a.height).cursor(a.cursor).model();
+        model.limit = a.no_limit ? 0 : a.limit;
+
+        auto init = [&]() -> std::pair<scan::ListModel, scan::tea::Cmd> { return {model, scan::tea::none()}; };
+        auto update = [](scan::ListModel m, scan::tea::Msg msg) { return scan::list_update(std::move(m), msg); };
+        auto view = [](const scan::ListModel &m) { return scan::list_view(m); };
+        scan::tea::Program<scan::ListModel> program(init, update, view);
+        auto result = run_fed(program, io.items, model.id);
+
+        if (result.cancelled) {
+            return exit_cancelled;
+        }
+        std::vector<std::string> chosen;
+        for (size_t idx : result.selected) {
+            if (idx < result.item_count()) {
+                chosen.push_back(result.get_title(idx));
+            }
+        }
+        write_lines(io.out, chosen);
+        return chosen.empty() ? 1 : 0;
+    }
+
+    struct InputArgs {
+        std::string prompt = "> ";
+        std::string placeholder;
+        std::string value;
+        int char_limit = 0;
+        int width = 0;
+        bool password = false;
+    };
+
+    int run_input(const InputArgs &a, const Io &io) {
+        scan::TextInput input;
+        input.prompt(a.prompt).placeholder(a.placeholder).value(a.value).password(a.password).char_limit(
+            a.char_limit);
+        if (a.width > 0) {
+            input.width(a.width);
+        }
+        auto value = input.run();
+        if (!value) {
+            return exit_cancelled;
+        }
+        write_lines(io.out, {*value});
+        return 0;
+    }
+
+    struct ConfirmArgs {
+        std::string prompt = "Are you sure?";
+        std::string affirmative = "Yes";
+        std::string negative = "No";
+        std::string fallback = "yes";
+    };
+
+    int run_confirm(const ConfirmArgs &a) {
+        auto answer = scan::Confirm()
+                          .prompt(a.prompt)
+                          .affirmative(a.affirmative)
+                          .negative(a.negative)
+                          .default_value(a.fallback == "yes")
+                          .run();
+        if (!answer) {
+            return exit_cancelled;
+        }
+        return *answer ? 0 : 1;
+    }
+
+    struct PagerArgs {
+        std::string file;
+        std::string title;
+        bool line_numbers = false;
+        bool no_status = false;
+    };
+
+    int run_pager(const PagerArgs &a, const Io &io) {
+        int fd = io.items;
+#ifndef _WIN32
+        if (!a.file.empty()) {
+            fd = ::open(a.file.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                std::perror(("scan pager: " + a.file).c_str());
+                return 2;
+            }
+        }
+#endif
+        if (fd < 0) {
+            std::fprintf(stderr, "scan pager: nothing to show (pass a file or pipe text on stdin)\n");
+            return 2;
+        }
+        scan::PagerModel model =
+            scan::Pager().title(a.title.empty() ? a.file : a.title).line_numbers(a.line_numbers).status_bar(
+                !a.no_status).model();
+        scan::pager_init(model);
+
+        auto init = [&]() -> std::pair<scan::PagerModel, scan::tea::Cmd> { return {model, scan::tea::none()}; };
+        auto update = [](scan::PagerModel m, scan::tea::Msg msg) { return scan::pager_update(std::move(m), msg); };
+        auto view = [](const scan::PagerModel &m) { return scan::pager_view(m); };
+        scan::tea::Program<scan::PagerModel> program(init, update, view);
+        program.with_alt_screen(true);
+        run_fed(program, fd, model.id);
+#ifndef _WIN32
+        if (fd != io.items) {
+            ::close(fd);
+        }
+#endif
+        return 0;
+    }
+
+    struct TableArgs {
+        std::string file;
+        std::string separator = ",";
+        int height = 10;
+        std::string border = "rounded";
+        bool print = false;
+    };
+
+    int run_table(const TableArgs &a, const Io &io) {
+        // Column widths depend on every row, so the table is read in full before it is shown
+        int fd = io.items;
+#ifndef _WIN32
+        if (!a.file.empty()) {
+            fd = ::open(a.file.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                std::perror(("scan table: " + a.file).c_str());
+                return 2;
+            }
+        }
+#endif
+        if (fd < 0) {
+            std::fprintf(stderr, "scan table: no data (pass a file or pipe rows on stdin)\n");
+            return 2;
+        }
+        std::string data = read_all(fd);
+#ifndef _WIN32
+        if (fd != io.items) {
+            ::close(fd);
+        }
+#endif
+
+        char sep = a.separator.empty() ? ',' : a.separator[0];
+        std::vector<std::string> lines;
+        std::vector<std::vector<std::string>> rows;
+        scan::tea::for_each_line(data, [&](std::string_view line) {
+            if (!line.empty()) {
+                lines.emplace_back(line);
+                rows.push_back(split_record(line, sep));
+            }
+        });
+        if (rows.empty()) {
+            return 1;
+        }
+        std::vector<std::string> headers = std::move(rows.front());
+        rows.erase(rows.begin());
+
+        scan::BorderStyle border = scan::BorderStyle::Rounded;
+        if (a.border == "normal") {
+            border = scan::BorderStyle::Normal;
+        } else if (a.border == "double") {
+            border = scan::BorderStyle::Double;
+        } else if (a.border == "thick") {
+            border = scan::BorderStyle::Thick;
+        } else if (a.border == "none") {
+            border = scan::BorderStyle::None;
+        }
+
+        scan::Table table;
+        table.headers(headers).rows(rows).height(a.height).border(border);
+        if (a.print) {
+            write_all(io.out, table.render() + "\n");
+            return 0;
+        }
+        auto row = table.run();
+        if (!row) {
+            return exit_cancelled;
+        }
+        if (*row + 1 < lines.size()) {
+            write_lines(io.out, {lines[*row + 1]});
+        }
+        return 0;
+    }
+
+    /// Spinner frames plus the output of the command it waits on
+    struct SpinModel {
+        std::string title;
+        size_t frame = 0;
+        std::string out;
+        std::string err;
+        int exit_code = -1;
+        bool cancelled = false;
+        scan::Color color = scan::current_theme().colors.primary;
+    };
+
+    constexpr const char *spin_frames[] = {"⠋", "⠙", "⠹", "⠸", "⠼", "⠴", "⠦", "⠧", "⠇", "⠏"};
+    constexpr int spin_id = 1;
+
+    scan::tea::Cmd spin_tick() {
+        return scan::tea::async([]() -> std::optional<scan::tea::Msg> {
+            std::this_thread::sleep_for(std::chrono::milliseconds(80));
+            return scan::tea::TickMsg{spin_id};
+        });
+    }
+
+    int run_spin(const std::string &title, const std::vector<std::string> &command, bool show_output, const Io &io) {
+        SpinModel model;
+        model.title = title;
+
+        auto init = [&]() -> std::pair<SpinModel, scan::tea::Cmd> {
+            return {model, scan::tea::batch({scan::tea::exec(command, spin_id), spin_tick()})};
+        };
+        auto update = [](SpinModel m, scan::tea::Msg msg) -> std::pair<SpinModel, scan::tea::Cmd> {
+            if (auto *out = scan::tea::try_as<scan::tea::ExecOutputMsg>(msg)) {
+                (out->from_stderr ? m.err : m.out) += out->data;
+            } else if (auto *exit = scan::tea::try_as<scan::tea::ExecExitMsg>(msg)) {
+                m.exit_code = exit->exit_code;
+                if (!exit->error.empty()) {
+                    m.err += exit->error + "\n";
+                }
+                return {std::move(m), scan::tea::quit()};
+            } else if (scan::tea::is<scan::tea::TickMsg>(msg)) {
+                m.frame++;
+                return {std::move(m), spin_tick()};
+            } else if (auto *key = scan::tea::try_as<scan::tea::KeyMsg>(msg)) {
+                if (key->key == scan::input::Key::CtrlC || key->key == scan::input::Key::Escape) {
+                    m.cancelled = true;
+                    return {std::move(m), scan::tea::batch({scan::tea::exec_kill(spin_id), scan::tea::quit()})};
+                }
+            }
+            return {std::move(m), scan::tea::none()};
+        };
+        auto view = [](const SpinModel &m) {
+            size_t n = sizeof(spin_frames) / sizeof(spin_frames[0]);
+            return scan::Style().foreground(m.color).render(spin_frames[m.frame % n]) + " " + m.title;
+        };
+
+        scan::tea::Program<SpinModel> program(init, update, view);
+        program.with_hidden_cursor(true);
+        auto result = program.run();
+        // The spinner line is cleared rather than left behind
+        scan::terminal::write("\r\033[2K");
+        std::fflush(stdout);
+
+        if (result.cancelled) {
+            return exit_cancelled;
+        }
+        if (show_output) {
+            write_all(io.out, result.out);
+            write_all(STDERR_FILENO, result.err);
+        }
+        return result.exit_code < 0 ? 1 : result.exit_code;
+    }
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    // Multi-call: `scan-filter ...` is `scan filter ...`
+    std::string self = argc > 0 ? argv[0] : "scan";
+    self = self.substr(self.find_last_of('/') + 1);
+    if (self.rfind("scan-", 0) == 0) {
+        args.insert(args.begin(), self.substr(5));
+    }
+
+    FilterArgs filter_args;
+    ChooseArgs choose_args;
+    InputArgs input_args;
+    ConfirmArgs confirm_args;
+    PagerArgs pager_args;
+    TableArgs table_args;
+    std::string spin_title = "Loading...";
+    bool spin_output = false;
+
+    auto items_arg = []() {
+        return argu::Arg("items").positional().takes_multiple().help("Items to pick from (default: lines of stdin)");
+    };
+
+    auto filter_cmd =
+        argu::Command("filter")
+            .about("Fuzzy-filter items and print the chosen ones")
+            .arg(items_arg())
+            .arg(argu::Arg("prompt").long_name("prompt").help("Prompt before the query").value_of(filter_args.prompt))
+            .arg(argu::Arg("placeholder").long_name("placeholder").help("Text shown while the query is empty")
+                     .value_of(filter_args.placeholder))
+            .arg(argu::Arg("value").long_name("value").help("Initial query").value_of(filter_args.value))
+            .arg(argu::Arg("height").long_name("height").help("Visible items").value_of(filter_args.height))
+            .arg(argu::Arg("limit").long_name("limit").help("Maximum items to choose").value_of(filter_args.limit))
+            .arg(argu::Arg("no-limit").long_name("no-limit").help("Choose any number of items (Tab to mark)")
+                     .flag(filter_args.no_limit))
+            .arg(argu::Arg("case-sensitive").long_name("case-sensitive").help("Match case exactly")
+                     .flag(filter_args.case_sensitive));
+
+    auto choose_cmd =
+        argu::Command("choose")
+            .about("Choose from a list and print the chosen items")
+            .arg(items_arg())
+            .arg(argu::Arg("height").long_name("height").help("Visible items").value_of(choose_args.height))
+            .arg(argu::Arg("limit").long_name("limit").help("Maximum items to choose").value_of(choose_args.limit))
+            .arg(argu::Arg("no-limit").long_name("no-limit").help("Choose any number of items (Space to mark)")
+                     .flag(choose_args.no_limit))
+            .arg(argu::Arg("cursor").long_name("cursor").help("Cursor indicator").value_of(choose_args.cursor));
+
+    auto input_cmd =
+        argu::Command("input")
+            .about("Read a line of text and print it")
+            .arg(argu::Arg("prompt").long_name("prompt").help("Prompt before the text").value_of(input_args.prompt))
+            .arg(argu::Arg("placeholder").long_name("placeholder").help("Text shown while empty")
+                     .value_of(input_args.placeholder))
+            .arg(argu::Arg("value").long_name("value").help("Initial text").value_of(input_args.value))
+            .arg(argu::Arg("char-limit").long_name("char-limit").help("Maximum characters (0 = none)")
+                     .value_of(input_args.char_limit))
+            .arg(argu::Arg("width").long_name("width").help("Input width").value_of(input_args.width))
+            .arg(argu::Arg("password").long_name("password").help("Mask the text").flag(input_args.password));
+
+    auto confirm_cmd =
+        argu::Command("confirm")
+            .about("Ask a yes/no question; exit status 0 means yes")
+            .arg(argu::Arg("prompt").positional().help("Question to ask").value_of(confirm_args.prompt))
+            .arg(argu::Arg("affirmative").long_name("affirmative").help("Label of the yes button")
+                     .value_of(confirm_args.affirmative))
+            .arg(argu::Arg("negative").long_name("negative").help("Label of the no button")
+                     .value_of(confirm_args.negative))
+            .arg(argu::Arg("default").long_name("default").help("Preselected answer").choices({"yes", "no"})
+                     .value_of(confirm_args.fallback));
+
+    auto pager_cmd =
+        argu::Command("pager")
+            .about("Scroll through a file or stdin, shown as it arrives")
+            .arg(argu::Arg("file").positional().help("File to show (default: stdin)").value_of(pager_args.file))
+            .arg(argu::Arg("title").long_name("title").help("Title line").value_of(pager_args.title))
+            .arg(argu::Arg("line-numbers").long_name("line-numbers").help("Show line numbers")
+                     .flag(pager_args.line_numbers))
+            .arg(argu::Arg("no-status").long_name("no-status").help("Hide the status bar").flag(pager_args.no_status));
+
+    auto table_cmd =
+        argu::Command("table")
+            .about("Show delimited rows (first row is the header) and print the chosen row")
+            .arg(argu::Arg("file").positional().help("File to read (default: stdin)").value_of(table_args.file))
+            .arg(argu::Arg("separator").long_name("separator").help("Column separator").value_of(table_args.separator))
+            .arg(argu::Arg("height").long_name("height").help("Visible rows").value_of(table_args.height))
+            .arg(argu::Arg("border").long_name("border").help("Border style")
+                     .choices({"rounded", "normal", "double", "thick", "none"}).value_of(table_args.border))
+            .arg(argu::Arg("print").long_name("print").help("Print the table instead of choosing a row")
+                     .flag(table_args.print));
+
+    auto spin_cmd =
+        argu::Command("spin")
+            .about("Show a spinner while a command runs; exits with the command's status")
+            .arg(argu::Arg("command").positional().required().takes_one_or_more().help("Command to run (after --)"))
+            .arg(argu::Arg("title").long_name("title").help("Text next to the spinner").value_of(spin_title))
+            .arg(argu::Arg("show-output").long_name("show-output").help("Print the command's output afterwards")
+                     .flag(spin_output));
+
+    auto cmd = argu::Command("scan")
+                   .version(SCAN_VERSION)
+                   .about("Terminal UI components for shell scripts")
+                   .subcommand(std::move(filter_cmd))
+                   .subcommand(std::move(choose_cmd))
+                   .subcommand(std::move(input_cmd))
+                   .subcommand(std::move(confirm_cmd))
+                   .subcommand(std::move(pager_cmd))
+                   .subcommand(std::move(table_cmd))
+                   .subcommand(std::move(spin_cmd))
+                   .subcommand_required(true);
+
+    auto result = cmd.parse(args);
+    if (result.should_exit()) {
+        return result.exit();
+    }
+
+    const auto &matches = cmd.matches();
+    std::string sub = matches.subcommand().value_or("");
+    const argu::Matches *sm = matches.subcommand_matches();
+    Io io = attach_terminal();
+
+    if (sub == "filter") {
+        return run_filter(filter_args, sm->get_many("items"), io);
+    }
+    if (sub == "choose") {
+        return run_choose(choose_args, sm->get_many("items"), io);
+    }
+    if (sub == "input") {
+        return run_input(input_args, io);
+    }
+    if (sub == "confirm") {
+        return run_confirm(confirm_args);
+    }
+    if (sub == "pager") {
+        return run_pager(pager_args, io);
+    }
+    if (sub == "table") {
+        return run_table(table_args, io);
+    }
+    if (sub == "spin") {
+        return run_spin(spin_title, sm->get_many("command"), spin_output, io);
+    }
+    return 2;
+}
@@ -0,0 +1,88 @@
+/// @file scan.cppm
+/// @brief `import scan;` - module interface unit built from the scan headers
+///
+/// Everything the headers include from outside scan goes in the global module
+/// fragment, so only scan's own declarations become part of the module. The
+/// headers are then included once more inside an export block, which exports
+/// every declaration they contain. Keep the lists below in step with the
+/// headers' includes.
+
+module;
+
+// Lets headers skip declarations the module gets from these includes
+#define SCAN_MODULE_INTERFACE
+
+#include <algorithm>
+#include <any>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#ifdef _WIN32
+#include <conio.h>
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+#if !defined(SCAN_SIMD_DISABLED) && (defined(__AVX2__) || defined(__SSE2__))
+#include <immintrin.h>
+#endif
+
+#include <echo/echo.hpp>
+#include <echo/widget.hpp>
+
+export module scan;
+
+export {
+#include <scan/scan.hpp>
+}
@@ -0,0 +1,12 @@
+/// @file scan.cpp
+/// @brief Compiled-library build of scan (SCAN_HEADER_ONLY=OFF)
+///
+/// Key reading and escape sequence parsing, and fuzzy matching, are compiled
+/// here once instead of in every translation unit that includes them.
+
+#ifndef SCAN_COMPILED_LIB
+#error "src/scan/scan.cpp is only built with SCAN_COMPILED_LIB (cmake -DSCAN_HEADER_ONLY=OFF)"
+#endif
+
+#include <scan/input/reader_impl.hpp>
+#include <scan/util/fuzzy_impl.hpp>
@@ -4,8 +4,15 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 #include <argu/argu.hpp>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
 #include <vector>
 #include <string>
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#endif
 
 // Helper to create args from string literals
 std::vector<std::string> make_args(std::initializer_list<const char*> args) {
@@ -513,6 +520,54 @@ TEST_SUITE("Argue Error Handling") {
         CHECK_FALSE(result.success());
         CHECK(result.message().find("requires") != std::string::npos);
     }
+
+    TEST_CASE("First error ends the parse") {
+        std::string mode;
+        bool verbose = false;
+        auto cmd = argu::Command("test")
+            .arg(argu::Arg("mode").long_name("mode").value_of(mode).choices({"fast", "slow"}))
+            .arg(argu::Arg("verbose").long_name("verbose").flag(verbose));
+
+        auto result = cmd.parse(make_args({"--mode", "medium", "--verbose"}));
+        CHECK_FALSE(result.success());
+        CHECK(result.exit_code() == static_cast<int>(argu::ExitCode::UsageError));
+        CHECK(result.message().find("medium") != std::string::npos);
+        CHECK_FALSE(verbose);
+    }
+
+    TEST_CASE("Nested subcommand errors and help reach the top-level result") {
+        auto make = [] {
+            return argu::Command("app").subcommand(
+                argu::Command("remote").subcommand(argu::Command("add").arg(argu::Arg("name").positional().required())));
+        };
+
+        auto cmd = make();
+        auto missing = cmd.parse(make_args({"remote", "add"}));
+        CHECK_FALSE(missing.success());
+        CHECK(missing.exit_code() == static_cast<int>(argu::ExitCode::UsageError));
+        CHECK(missing.message().find("name") != std::string::npos);
+
+        cmd = make();
+        auto help = cmd.parse(make_args({"remote", "add", "--help"}));
+        CHECK(help.success());
+        CHECK(help.exit_code() == 0);
+        CHECK(help.message().find("add") != std::string::npos);
+    }
+
+    TEST_CASE("Config syntax errors are returned, not thrown") {
+        auto bad = argu::ConfigParser::try_parse_string("[section\nkey = value\n");
+        REQUIRE_FALSE(bad);
+        CHECK(bad.error().reason().find("line 1") != std::string::npos);
+        CHECK(bad.error().exit_code_int() == static_cast<int>(argu::ExitCode::ConfigError));
+
+        auto good = argu::ConfigParser::try_parse_string(R"({"name": "x", "tags": ["a", "b"]})", argu::ConfigFormat::Json);
+        REQUIRE(good);
+        CHECK(good->get("name") == "x");
+        CHECK(good->get_many("tags").size() == 2);
+
+        CHECK_FALSE(argu::ConfigParser::try_parse_string(R"({"name": "x)", argu::ConfigFormat::Json));
+        CHECK_FALSE(argu::ConfigParser::try_parse_file("/nonexistent/argu.ini"));
+    }
 }
 
 // =============================================================================
@@ -585,6 +640,91 @@ TEST_SUITE("Argue Matches API") {
     }
 }
 
+// =============================================================================
+// Typed Handle Tests
+// =============================================================================
+
+TEST_SUITE("Typed Handles") {
+
+    TEST_CASE("ArgRef holds converted values after parsing") {
+        argu::ArgRef<int> jobs;
+        argu::ArgRef<std::string> files;
+        argu::ArgRef<bool> verbose;
+        argu::ArgRef<double> ratio;
+        auto cmd = argu::Command("make")
+            .arg(argu::Arg("jobs").short_name('j').bind(jobs))
+            .arg(argu::Arg("file").short_name('f').takes_multiple().bind(files))
+            .arg(argu::Arg("verbose").short_name('v').flag().bind(verbose))
+            .arg(argu::Arg("ratio").long_name("ratio").default_value("0.5").bind(ratio));
+
+        CHECK(cmd.parse(make_args({"-j", "8", "-f", "a", "-f", "b", "-v"})).success());
+        CHECK(jobs.present());
+        CHECK(*jobs == 8);
+        CHECK(jobs.source() == argu::ValueSource::CommandLine);
+        REQUIRE(files.values().size() == 2);
+        CHECK(files.values()[1] == "b");
+        CHECK(files->size() == 1); // First value, "a"
+        CHECK(verbose.get());
+        CHECK(ratio.present());
+        CHECK(*ratio == doctest::Approx(0.5));
+
+        // Copies share storage, so a handle can be passed around by value
+        argu::ArgRef<int> copy = jobs;
+        CHECK(&copy.get() == &jobs.get());
+    }
+
+    TEST_CASE("ArgRef of an absent argument is empty") {
+        argu::ArgRef<int> level;
+        argu::ArgRef<bool> quiet;
+        auto cmd = argu::Command("app")
+            .arg(argu::Arg("level").long_name("level").bind(level))
+            .arg(argu::Arg("quiet").short_name('q').flag().bind(quiet));
+
+        CHECK(cmd.parse(make_args({})).success());
+        CHECK(!level);
+        CHECK(level.get() == 0);
+        CHECK(level.values().empty());
+        CHECK(!quiet.get());
+    }
+
+    TEST_CASE("A value that does not convert fails the parse") {
+        argu::ArgRef<int> port;
+        auto cmd = argu::Command("srv").arg(argu::Arg("port").long_name("port").bind(port));
+
+        auto result = cmd.parse(make_args({"--port", "http"}));
+        CHECK(!result.success());
+        CHECK(result.message().find("http") != std::string::npos);
+    }
+
+    TEST_CASE("Handles in subcommands are filled when the subcommand runs") {
+        argu::ArgRef<std::string> url;
+        auto cmd = argu::Command("git")
+            .subcommand(argu::Command("clone").arg(argu::Arg("url").positional().bind(url)));
+
+        CHECK(cmd.parse(make_args({"clone", "https://example.com/repo.git"})).success());
+        CHECK(*url == "https://example.com/repo.git");
+        CHECK(cmd.matches().subcommand_matches()->get_one("url").value() == "https://example.com/repo.git");
+    }
+
+    TEST_CASE("Arguments get dense IDs in registration order") {
+        auto cmd = argu::Command("app")
+            .arg(argu::Arg("a").long_name("a"))
+            .arg(argu::Arg("b").long_name("b"))
+            .arg(argu::Arg("c").long_name("c"));
+
+        const auto &args = cmd.get_args();
+        REQUIRE(args.size() == 4); // Including the automatic --help
+        for (std::size_t i = 0; i < args.size(); ++i) {
+            CHECK(args[i].id() == i);
+        }
+
+        CHECK(cmd.parse(make_args({"--b", "x"})).success());
+        CHECK(cmd.matches().get_many("b").size() == 1);
+        CHECK(cmd.matches().get_many("missing").empty());
+        CHECK(!cmd.matches().contains("a"));
+    }
+}
+
 // =============================================================================
 // Type Conversion Tests
 // =============================================================================
@@ -1756,6 +1896,438 @@ TEST_SUITE("Subcommand Prefix Matching") {
     }
 }
 
+// =============================================================================
+// Name Lookup Tests
+// =============================================================================
+
+TEST_SUITE("Name Lookup") {
+
+    TEST_CASE("Large commands resolve every long, short and subcommand name") {
+        std::vector<int> values(600, 0);
+        auto cmd = argu::Command("gen");
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            auto arg = argu::Arg("opt" + std::to_string(i))
+                .long_name("option-" + std::to_string(i))
+                .value_of(values[i]);
+            if (i < 26) {
+                arg.short_name(static_cast<char>('a' + i));
+            }
+            if (i % 50 == 0) {
+                arg.hidden_alias("legacy-" + std::to_string(i));
+            }
+            cmd.arg(std::move(arg));
+        }
+        for (int i = 0; i < 150; ++i) {
+            cmd.subcommand(argu::Command("sub" + std::to_string(i)).alias("s" + std::to_string(i)));
+        }
+
+        auto result = cmd.parse(make_args({"--option-599", "7", "-c", "3", "--legacy-300=9", "--option-42=1", "s149"}));
+        CHECK(result.success());
+        CHECK(values[599] == 7);
+        CHECK(values[2] == 3);
+        CHECK(values[300] == 9);
+        CHECK(values[42] == 1);
+        CHECK(cmd.matches().subcommand().value() == "sub149");
+
+        CHECK(!cmd.parse(make_args({"--option-600", "1"})).success());
+        CHECK(!cmd.parse(make_args({"-Z"})).success());
+    }
+
+    TEST_CASE("Partial matching accepts only unambiguous prefixes") {
+        bool color = false, column = false;
+        auto cmd = argu::Command("app")
+            .allow_partial_matching(true)
+            .arg(argu::Arg("color").long_name("color").flag(color))
+            .arg(argu::Arg("column").long_name("column").visible_alias("cols").flag(column));
+
+        CHECK(cmd.parse(make_args({"--colu"})).success());
+        CHECK(column);
+        CHECK(!color);
+        CHECK(!cmd.parse(make_args({"--co"})).success());  // color, column and cols
+        CHECK(!cmd.parse(make_args({"--col"})).success()); // Still ambiguous
+        CHECK(cmd.parse(make_args({"--colo"})).success());
+        CHECK(color);
+    }
+
+    TEST_CASE("First declaration wins when names collide") {
+        std::string first, second;
+        auto cmd = argu::Command("app")
+            .arg(argu::Arg("first").short_name('x').long_name("same").value_of(first))
+            .arg(argu::Arg("second").short_name('x').long_name("same").value_of(second));
+
+        CHECK(cmd.parse(make_args({"--same", "a", "-x", "b"})).success());
+        CHECK(first == "b");
+        CHECK(second.empty());
+    }
+
+    TEST_CASE("Lookup follows arguments added after a parse") {
+        bool late = false;
+        auto cmd = argu::Command("app").arg(argu::Arg("early").long_name("early").flag());
+        CHECK(cmd.parse(make_args({"--early"})).success());
+        CHECK(!cmd.parse(make_args({"--late"})).success());
+
+        cmd.arg(argu::Arg("late").long_name("late").short_name('l').flag(late));
+        CHECK(cmd.parse(make_args({"-l"})).success());
+        CHECK(late);
+
+        auto copy = cmd;
+        CHECK(copy.parse(make_args({"--late", "--early"})).success());
+        CHECK(copy.find_arg_by_name("late") != nullptr);
+        CHECK(copy.find_arg_by_name("missing") == nullptr);
+    }
+
+    TEST_CASE("Negatable and renamed options resolve through the index") {
+        bool color = true;
+        std::string out;
+        auto cmd = argu::Command("app")
+            .arg(argu::Arg("color").long_name("color").negatable().flag(color))
+            .arg(argu::Arg("output").long_name("output").renamed_from("out").value_of(out));
+
+        CHECK(cmd.parse(make_args({"--no-color", "--out", "a.txt"})).success());
+        CHECK(!color);
+        CHECK(out == "a.txt");
+    }
+}
+
+TEST_SUITE("Argv Parsing") {
+
+    TEST_CASE("argv is parsed in place through nested subcommands") {
+        std::vector<std::string> store = {"prog", "a", "b", "--level=3", "--tags=x,y", "c"};
+        for (int i = 0; i < 2000; ++i) {
+            store.push_back("file" + std::to_string(i));
+        }
+        store.push_back("--");
+        store.push_back("--not-an-option");
+        std::vector<char *> argv;
+        for (auto &s : store) {
+            argv.push_back(s.data());
+        }
+
+        int level = 0;
+        std::vector<std::string> tags, files;
+        auto c = argu::Command("c").arg(argu::Arg("files").positional().takes_multiple().value_of(files));
+        auto b = argu::Command("b")
+                     .arg(argu::Arg("level").long_name("level").value_of(level))
+                     .arg(argu::Arg("tags").long_name("tags").value_delimiter(',').value_of(tags))
+                     .subcommand(std::move(c));
+        auto cmd = argu::Command("prog").subcommand(argu::Command("a").subcommand(std::move(b)));
+
+        auto result = cmd.parse(static_cast<int>(argv.size()), argv.data());
+        REQUIRE(result.success());
+        CHECK(level == 3);
+        CHECK(tags == std::vector<std::string>{"x", "y"});
+        REQUIRE(files.size() == 2001);
+        CHECK(files.front() == "file0");
+        CHECK(files[1999] == "file1999");
+        CHECK(files.back() == "--not-an-option"); // After --
+    }
+
+    TEST_CASE("Validators see every value of a repeated positional once") {
+        int calls = 0;
+        std::vector<std::string> items;
+        auto cmd = argu::Command("app").arg(argu::Arg("items")
+                                                .positional()
+                                                .takes_multiple()
+                                                .validate([&](const std::string &) -> std::optional<std::string> {
+                                                    ++calls;
+                                                    return std::nullopt;
+                                                })
+                                                .value_of(items));
+
+        CHECK(cmd.parse(make_args({"a", "b", "c", "d"})).success());
+        CHECK(items.size() == 4);
+        CHECK(calls == 4);
+    }
+}
+
+TEST_SUITE("Response Files") {
+    namespace fs = std::filesystem;
+
+    // Write a response file into a fresh temporary directory
+    fs::path write_file(const std::string &name, const std::string &content) {
+        fs::path dir = fs::temp_directory_path() / "argu_response_files";
+        fs::create_directories(dir);
+        fs::path path = dir / name;
+        std::ofstream(path, std::ios::binary) << content;
+        return path;
+    }
+
+    TEST_CASE("@file is replaced by the arguments in the file") {
+        auto list = write_file("list.txt", "--level\r\n3\n\nb c\n@" +
+                                               write_file("more.txt", "d\n--name=x").string() + "\ne\n");
+        int level = 0;
+        std::string name;
+        std::vector<std::string> items;
+        auto cmd = argu::Command("app")
+                       .response_files()
+                       .arg(argu::Arg("level").long_name("level").value_of(level))
+                       .arg(argu::Arg("name").long_name("name").value_of(name))
+                       .arg(argu::Arg("items").positional().takes_multiple().value_of(items));
+
+        auto result = cmd.parse(make_args({"a", ("@" + list.string()).c_str(), "f", "--", "@literal"}));
+        REQUIRE(result.success());
+        CHECK(level == 3);
+        CHECK(name == "x");
+        CHECK(items == std::vector<std::string>{"a", "b c", "d", "e", "f", "@literal"});
+
+        // Without response_files(), @file is an ordinary value
+        items.clear();
+        auto plain = argu::Command("app").arg(argu::Arg("items").positional().takes_multiple().value_of(items));
+        REQUIRE(plain.parse(make_args({("@" + list.string()).c_str()})).success());
+        CHECK(items == std::vector<std::string>{"@" + list.string()});
+    }
+
+    TEST_CASE("NUL-separated files keep newlines and empty arguments") {
+        auto list = write_file("nul.bin", std::string("one\0two\nlines\0\0three\0", 21));
+        std::vector<std::string> items;
+        auto cmd = argu::Command("app").response_files().arg(
+            argu::Arg("items").positional().takes_multiple().value_of(items));
+
+        REQUIRE(cmd.parse(make_args({("@" + list.string()).c_str()})).success());
+        CHECK(items == std::vector<std::string>{"one", "two\nlines", "", "three"});
+    }
+
+    TEST_CASE("Unreadable and endlessly nested response files are errors") {
+        auto loop = write_file("loop.txt", "");
+        write_file("loop.txt", "x\n@" + loop.string() + "\n");
+        auto cmd = argu::Command("app").response_files(true, 4).arg(
+            argu::Arg("items").positional().takes_multiple());
+
+        auto result = cmd.parse(make_args({("@" + loop.string()).c_str()}));
+        CHECK(!result.success());
+        CHECK(result.message().find("nested more than 4 levels") != std::string::npos);
+
+        result = cmd.parse(make_args({"@/nonexistent/argu/list"}));
+        CHECK(!result.success());
+        CHECK(result.message().find("Error in response file '/nonexistent/argu/list'") != std::string::npos);
+    }
+
+    TEST_CASE("--args-from reads a file given as the next argument or after =") {
+        auto list = write_file("args.txt", "-v\nsub\n");
+        bool verbose = false;
+        std::vector<std::string> items;
+        auto cmd = argu::Command("app")
+                       .args_from()
+                       .arg(argu::Arg("verbose").short_name('v').flag().value_of(verbose))
+                       .subcommand(argu::Command("sub").arg(
+                           argu::Arg("items").positional().takes_multiple().value_of(items)));
+
+        REQUIRE(cmd.parse(make_args({"--args-from", list.string().c_str(), "x"})).success());
+        CHECK(verbose);
+        CHECK(cmd.matches().subcommand() == "sub");
+        CHECK(items == std::vector<std::string>{"x"});
+
+        items.clear();
+        REQUIRE(cmd.parse(make_args({("--args-from=" + list.string()).c_str(), "y"})).success());
+        CHECK(items == std::vector<std::string>{"y"});
+
+        CHECK(!cmd.parse(make_args({"--args-from"})).success());
+    }
+
+#if !defined(_WIN32)
+    TEST_CASE("Pipes are read in chunks, arguments longer than a chunk included") {
+        fs::path fifo = fs::temp_directory_path() / "argu_response_files" / "pipe";
+        fs::create_directories(fifo.parent_path());
+        fs::remove(fifo);
+        REQUIRE(::mkfifo(fifo.c_str(), 0600) == 0);
+
+        std::string big(200 * 1024, 'x');
+        std::thread writer([&] {
+            std::ofstream out(fifo, std::ios::binary);
+            for (int i = 0; i < 20000; ++i) {
+                out << "path/" << i << '\0';
+            }
+            out << big << '\0';
+        });
+
+        std::size_t count = 0;
+        std::string last;
+        auto cmd = argu::Command("app").args_from().arg(
+            argu::Arg("paths").positional().takes_multiple().stream_to([&](const std::string &path) {
+                ++count;
+                last = path;
+            }));
+        auto result = cmd.parse(make_args({"--args-from", fifo.c_str()}));
+        writer.join();
+        fs::remove(fifo);
+
+        REQUIRE(result.success());
+        CHECK(count == 20001);
+        CHECK(last == big);
+    }
+#endif
+
+    TEST_CASE("Streamed positionals go to the sink and are not stored") {
+        std::string content;
+        for (int i = 0; i < 10000; ++i) {
+            content += "f" + std::to_string(i) + "\n";
+        }
+        auto list = write_file("stream.txt", content);
+
+        std::size_t count = 0;
+        std::string first;
+        std::string out;
+        auto cmd = argu::Command("app")
+                       .response_files()
+                       .arg(argu::Arg("out").positional().required().value_of(out))
+                       .arg(argu::Arg("files")
+                                .positional()
+                                .takes_multiple()
+                                .required()
+                                .transform([](const std::string &s) { return s + ".txt"; })
+                                .stream_to([&](const std::string &file) {
+                                    if (count++ == 0)
+                                        first = file;
+                                }));
+
+        REQUIRE(cmd.parse(make_args({"dest", ("@" + list.string()).c_str()})).success());
+        CHECK(out == "dest");
+        CHECK(count == 10000);
+        CHECK(first == "f0.txt");
+        CHECK(cmd.matches().occurrences("files") == 10000);
+        CHECK(cmd.matches().get_many("files").empty());
+
+        // Values are validated before they reach the sink
+        count = 0;
+        auto checked = argu::Command("app").arg(
+            argu::Arg("files").positional().takes_multiple().validate(argu::validators::path_exists()).stream_to(
+                [&](const std::string &) { ++count; }));
+        auto result = checked.parse(make_args({list.string().c_str(), "/nonexistent/argu/file"}));
+        CHECK(!result.success());
+        CHECK(count == 1);
+    }
+}
+
+TEST_SUITE("Shared Commands") {
+
+    TEST_CASE("A finalized command parses on several threads at once") {
+        auto cmd = argu::Command("tool")
+                       .version("1.0")
+                       .arg(argu::Arg("verbose").short_name('v').long_name("verbose").flag().global())
+                       .subcommand(argu::Command("run")
+                                       .arg(argu::Arg("jobs").short_name('j').value_name("N").default_value("1"))
+                                       .arg(argu::Arg("target").positional().required()));
+        cmd.finalize();
+        REQUIRE(cmd.is_finalized());
+
+        std::atomic<int> failures{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&cmd, &failures, t] {
+                for (int i = 0; i < 200; ++i) {
+                    std::string jobs = std::to_string(t * 1000 + i);
+                    argu::Matches matches;
+                    auto result = cmd.parse(make_args({"run", "-v", "-j", jobs.c_str(), "all"}), matches);
+                    const auto *run = matches.subcommand_matches("run");
+                    if (!result.success() || !run || run->get_one("jobs") != jobs || !run->get_flag("verbose") ||
+                        run->get_one("target") != "all") {
+                        ++failures;
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        CHECK(failures == 0);
+    }
+
+    TEST_CASE("A const parse writes only the caller's matches") {
+        int jobs = 0;
+        argu::ArgRef<int> handle;
+        auto cmd = argu::Command("tool").arg(argu::Arg("jobs").short_name('j').value_of(jobs).bind(handle));
+
+        argu::Matches matches;
+        CHECK(!cmd.parse(make_args({"-j", "4"}), matches).success()); // Not finalized yet
+
+        cmd.finalize();
+        CHECK(cmd.parse(make_args({"-j", "4"}), matches).success());
+        CHECK(matches.get<int>("jobs") == 4);
+        CHECK(jobs == 0);
+        CHECK(!handle.present());
+        CHECK(!cmd.matches().contains("jobs"));
+
+        cmd.arg(argu::Arg("extra").long_name("extra").flag());
+        CHECK(!cmd.is_finalized());
+    }
+
+    TEST_CASE("Repeated parses start from empty matches and inherit globals once") {
+        auto cmd = argu::Command("tool")
+                       .arg(argu::Arg("verbose").short_name('v').flag().global())
+                       .arg(argu::Arg("tag").short_name('t').takes_multiple())
+                       .subcommand(argu::Command("run"));
+
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(cmd.parse(make_args({"-t", "a", "run", "-v"})).success());
+            CHECK(cmd.matches().get_many("tag").size() == 1);
+            CHECK(cmd.matches().subcommand_matches()->get_flag("verbose"));
+        }
+        const auto &run = *cmd.get_subcommands().front();
+        CHECK(std::count_if(run.get_args().begin(), run.get_args().end(),
+                            [](const argu::Arg &arg) { return arg.name() == "verbose"; }) == 1);
+    }
+}
+
+TEST_SUITE("Lazy Subcommands") {
+
+    TEST_CASE("Only the subcommand on the parsed path is built") {
+        int built_logs = 0, built_exec = 0;
+        auto cmd = argu::Command("kube")
+                       .arg(argu::Arg("namespace").short_name('n').global())
+                       .subcommand(argu::Command("logs").about("Print logs").alias("log"),
+                                   [&built_logs] {
+                                       ++built_logs;
+                                       return argu::Command("logs").alias("log").arg(
+                                           argu::Arg("follow").short_name('f').flag());
+                                   })
+                       .subcommand(argu::Command("exec").about("Run a command"), [&built_exec] {
+                           ++built_exec;
+                           return argu::Command("exec");
+                       });
+
+        CHECK(cmd.get_subcommands().front()->is_lazy());
+        CHECK(cmd.help().find("Print logs") != std::string::npos);
+        CHECK(built_logs == 0);
+
+        REQUIRE(cmd.parse(make_args({"log", "-f", "-n", "prod"})).success());
+        const auto *logs = cmd.matches().subcommand_matches("logs");
+        REQUIRE(logs != nullptr);
+        CHECK(logs->get_flag("follow"));
+        CHECK(logs->get_one("namespace") == "prod");
+        CHECK(built_logs == 1);
+        CHECK(built_exec == 0);
+
+        REQUIRE(cmd.parse(make_args({"logs"})).success());
+        CHECK(built_logs == 1); // Built once, then kept
+    }
+
+    TEST_CASE("finalize and completions build the whole tree") {
+        int built = 0;
+        auto make = [&built](std::string name) {
+            return [&built, name] {
+                ++built;
+                return argu::Command(name).arg(argu::Arg("deep").long_name("deep-" + name).flag());
+            };
+        };
+        auto cmd = argu::Command("app")
+                       .subcommand(argu::Command("a"), make("a"))
+                       .subcommand(argu::Command("b"), [&built, make] {
+                           ++built;
+                           return argu::Command("b").subcommand(argu::Command("c"), make("c"));
+                       });
+
+        auto script = cmd.generate_completions(argu::Shell::Zsh);
+        CHECK(built == 3);
+        CHECK(script.find("deep-a") != std::string::npos);
+
+        cmd.finalize();
+        argu::Matches matches;
+        REQUIRE(cmd.parse(make_args({"b", "c", "--deep-c"}), matches).success());
+        CHECK(matches.subcommand_chain() == std::vector<std::string>{"b", "c"});
+        CHECK(built == 3);
+    }
+}
+
 // =============================================================================
 // Global Arguments Tests
 // =============================================================================
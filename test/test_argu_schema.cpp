@@ -0,0 +1,143 @@
+/// @file test_argu_schema.cpp
+/// @brief Tests for compile-time argument schemas
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <argu/argu.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Count heap allocations so the tests can check that parsing makes none
+static std::atomic<std::size_t> g_allocations{0};
+
+void *operator new(std::size_t size) {
+    ++g_allocations;
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    ++g_allocations;
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+    struct Options {
+        bool verbose = false;
+        int level = 0;
+        int jobs = 1;
+        double ratio = 0.5;
+        std::string_view mode = "fast";
+        std::array<int, 2> size{};
+        std::optional<unsigned> seed;
+        std::string_view input;
+        std::string_view output;
+    };
+
+    constexpr auto cli = argu::schema<Options>("tool",
+                                               argu::opt("verbose", &Options::verbose).short_name('v').help("Verbose output"),
+                                               argu::opt("level", &Options::level).short_name('l').count(),
+                                               argu::opt("jobs", &Options::jobs).short_name('j').value_name("N"),
+                                               argu::opt("ratio", &Options::ratio),
+                                               argu::opt("mode", &Options::mode).choices({"fast", "slow"}),
+                                               argu::opt("size", &Options::size).short_name('s'),
+                                               argu::opt("seed", &Options::seed),
+                                               argu::positional("input", &Options::input).required(),
+                                               argu::positional("output", &Options::output))
+                             .about("Schema test tool")
+                             .version("1.2.3");
+
+    argu::ParseResult parse(Options &options, std::initializer_list<std::string_view> args) {
+        std::vector<std::string_view> tokens(args);
+        return cli.parse(options, tokens);
+    }
+
+} // namespace
+
+TEST_SUITE("Compile-Time Schema") {
+
+    TEST_CASE("Options and positionals are written into the struct") {
+        Options options;
+        auto result = parse(options, {"-vll", "-j8", "--ratio=0.25", "--mode", "slow", "--size", "800", "600",
+                                      "--seed=0x10", "in.txt", "out.txt"});
+        REQUIRE(result.success());
+        CHECK(options.verbose);
+        CHECK(options.level == 2);
+        CHECK(options.jobs == 8);
+        CHECK(options.ratio == doctest::Approx(0.25));
+        CHECK(options.mode == "slow");
+        CHECK(options.size == std::array<int, 2>{800, 600});
+        CHECK(options.seed == 16u);
+        CHECK(options.input == "in.txt");
+        CHECK(options.output == "out.txt");
+    }
+
+    TEST_CASE("Parsing argv allocates nothing") {
+        std::array<std::string, 8> store = {"tool", "-v", "--jobs", "4", "-s", "1", "2", "file"};
+        std::array<char *, 8> argv{};
+        for (std::size_t i = 0; i < store.size(); ++i) {
+            argv[i] = store[i].data();
+        }
+
+        Options options;
+        std::size_t before = g_allocations.load();
+        auto result = cli.parse(options, static_cast<int>(argv.size()), argv.data());
+        std::size_t after = g_allocations.load();
+
+        CHECK(result.success());
+        CHECK(after == before);
+        CHECK(options.jobs == 4);
+        CHECK(options.input == "file");
+    }
+
+    TEST_CASE("Errors use the argu error types") {
+        Options options;
+        auto unknown = parse(options, {"--job", "3", "x"});
+        CHECK(!unknown.success());
+        CHECK(unknown.message().find("Unknown argument: --job") != std::string::npos);
+        CHECK(unknown.message().find("--jobs") != std::string::npos);
+
+        CHECK(parse(options, {"--mode", "medium", "x"}).message().find("medium") != std::string::npos);
+        CHECK(!parse(options, {"-j", "many", "x"}).success());
+        CHECK(!parse(options, {"--size", "1"}).success());
+        CHECK(!parse(options, {"-v"}).success()); // input is required
+        CHECK(!parse(options, {"a", "b", "c"}).success());
+        CHECK(!parse(options, {"--verbose=yes", "x"}).success());
+    }
+
+    TEST_CASE("Help and version come from the runtime view") {
+        Options options;
+        auto help = parse(options, {"--help"});
+        CHECK(help.success());
+        CHECK(help.should_exit());
+        CHECK(help.message().find("Verbose output") != std::string::npos);
+        CHECK(help.message().find("--jobs") != std::string::npos);
+
+        auto version = parse(options, {"-V"});
+        CHECK(version.message().find("1.2.3") != std::string::npos);
+
+        auto cmd = cli.command();
+        CHECK(cmd.find_arg_by_name("mode") != nullptr);
+        CHECK(cmd.find_arg_by_name("mode")->get_choices().size() == 2);
+    }
+
+    TEST_CASE("Tokens after -- are positional") {
+        Options options;
+        REQUIRE(parse(options, {"--", "-v", "-"}).success());
+        CHECK(!options.verbose);
+        CHECK(options.input == "-v");
+        CHECK(options.output == "-");
+    }
+}
@@ -4,8 +4,12 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 #include <argu/argu.hpp>
+#include <algorithm>
 #include <fstream>
 #include <filesystem>
+#include <regex>
+#include <string_view>
+#include <thread>
 
 // Helper to create args from string literals
 std::vector<std::string> make_args(std::initializer_list<const char*> args) {
@@ -110,6 +114,115 @@ TEST_SUITE("Argue File Validators") {
         auto result = cmd.parse(make_args({"--out", "/tmp"}));
         CHECK_FALSE(result.success());
     }
+
+    TEST_CASE("Batched path checks report the first missing path in argument order") {
+        namespace fs = std::filesystem;
+        fs::path dir = fs::temp_directory_path() / "argu_batch_paths";
+        fs::create_directories(dir);
+
+        std::vector<std::string> args;
+        for (int i = 0; i < 200; ++i) {
+            auto file = (dir / ("f" + std::to_string(i))).string();
+            if (i != 150 && i != 180) {
+                std::ofstream(file) << i;
+            }
+            args.push_back(file);
+        }
+
+        for (std::size_t threads : {1, 8, 64}) {
+            std::vector<std::string> files;
+            auto cmd = argu::Command("test").validation_threads(threads).arg(
+                argu::Arg("files").positional().takes_multiple().value_of(files).validate(
+                    argu::validators::file_exists()));
+
+            auto result = cmd.parse(args);
+            CHECK_FALSE(result.success());
+            CHECK(result.message().find("f150") != std::string::npos);
+        }
+
+        std::vector<std::string> present(args.begin(), args.begin() + 150);
+        std::vector<std::string> files;
+        auto cmd = argu::Command("test").validation_threads(8).arg(
+            argu::Arg("files").positional().takes_multiple().value_of(files).validate(argu::validators::file_exists()));
+        // Repeated parses reuse the same pool threads
+        for (int i = 0; i < 3; ++i) {
+            files.clear();
+            CHECK(cmd.parse(present).success());
+            CHECK(files.size() == 150);
+        }
+
+        fs::remove_all(dir);
+    }
+
+    TEST_CASE("A path error wins over a later parse error and stops before subcommands") {
+        bool ran = false;
+        std::string path;
+        auto cmd = argu::Command("test")
+            .validation_threads(4)
+            .arg(argu::Arg("in").long_name("in").value_of(path).validate(argu::validators::path_exists()))
+            .subcommand(argu::Command("run").callback([&ran](const argu::Matches &) { ran = true; }));
+
+        auto unknown = cmd.parse(make_args({"--in", "/nonexistent/argu", "--bogus"}));
+        CHECK_FALSE(unknown.success());
+        CHECK(unknown.message().find("does not exist") != std::string::npos);
+
+        auto sub = cmd.parse(make_args({"--in", "/nonexistent/argu", "run"}));
+        CHECK_FALSE(sub.success());
+        CHECK_FALSE(ran);
+
+        CHECK(cmd.parse(make_args({"--in", "/tmp", "run"})).success());
+        CHECK(ran);
+    }
+
+    TEST_CASE("Batched path checks run on the command's executor") {
+        namespace fs = std::filesystem;
+        fs::path dir = fs::temp_directory_path() / "argu_batch_executor";
+        fs::create_directories(dir);
+        std::vector<std::string> args{"run"};
+        for (int i = 0; i < 64; ++i) {
+            auto file = (dir / ("f" + std::to_string(i))).string();
+            std::ofstream(file) << i;
+            args.push_back(file);
+        }
+
+        int batches = 0;
+        std::size_t checked = 0;
+        std::vector<std::string> files;
+        auto cmd = argu::Command("test")
+                       .executor([&](std::size_t n, const std::function<void(std::size_t)> &body) {
+                           ++batches;
+                           for (std::size_t i = 0; i < n; ++i, ++checked) {
+                               body(i);
+                           }
+                       })
+                       .subcommand(argu::Command("run").validation_threads(4).arg(
+                           argu::Arg("files").positional().takes_multiple().value_of(files).validate(
+                               argu::validators::file_exists())));
+
+        CHECK(cmd.parse(args).success());
+        CHECK(batches == 1); // Inherited by the subcommand
+        CHECK(checked == 64);
+        CHECK(files.size() == 64);
+
+        fs::remove_all(dir);
+    }
+
+    TEST_CASE("The shared worker pool serves concurrent batches") {
+        auto &pool = argu::detail::WorkerPool::shared();
+        std::vector<std::vector<int>> seen(4, std::vector<int>(1000, 0));
+        std::vector<std::thread> callers;
+        for (std::size_t c = 0; c < seen.size(); ++c) {
+            callers.emplace_back([&pool, &seen, c] {
+                pool.parallel_for(seen[c].size(), 3, [&seen, c](std::size_t i) { ++seen[c][i]; });
+            });
+        }
+        for (auto &caller : callers) {
+            caller.join();
+        }
+        for (const auto &counts : seen) {
+            CHECK(std::all_of(counts.begin(), counts.end(), [](int n) { return n == 1; }));
+        }
+    }
 }
 
 // =============================================================================
@@ -894,6 +1007,112 @@ TEST_SUITE("Semantic Version Validator") {
     }
 }
 
+// =============================================================================
+// Format Matcher Tests
+// =============================================================================
+
+namespace {
+
+    // Every string over `alphabet` with up to `max_len` characters
+    std::vector<std::string> all_strings(std::string_view alphabet, std::size_t max_len) {
+        std::vector<std::string> result = {""};
+        for (std::size_t begin = 0, len = 0; len < max_len; ++len) {
+            std::size_t end = result.size();
+            for (std::size_t i = begin; i < end; ++i) {
+                for (char c : alphabet) {
+                    result.push_back(result[i] + c);
+                }
+            }
+            begin = end;
+        }
+        return result;
+    }
+
+    // Check a validator accepts exactly what the std::regex it replaced accepted
+    void check_same_as_regex(const argu::Validator &validator, const char *pattern,
+                             const std::vector<std::string> &inputs) {
+        std::regex re(pattern);
+        for (const auto &input : inputs) {
+            CHECK(!validator(input).has_value() == std::regex_match(input, re));
+        }
+    }
+
+} // namespace
+
+TEST_SUITE("Format Matchers") {
+
+    TEST_CASE("Built-in validators accept what their original patterns accepted") {
+        namespace v = argu::validators;
+
+        check_same_as_regex(v::kebab_case(), R"(^[a-z][a-z0-9]*(-[a-z0-9]+)*$)", all_strings("aZ1-_", 6));
+        check_same_as_regex(v::snake_case(), R"(^[a-z][a-z0-9]*(_[a-z0-9]+)*$)", all_strings("aZ1-_", 6));
+        auto durations = all_strings("1dhms", 6);
+        durations.erase(durations.begin()); // duration() has always rejected "" on top of its pattern
+        check_same_as_regex(v::duration(), R"(^(\d+d)?(\d+h)?(\d+m)?(\d+s)?(\d+ms)?$)", durations);
+        CHECK(v::duration()("").has_value());
+        check_same_as_regex(v::hex_color(), R"(^#([0-9a-fA-F]{3}|[0-9a-fA-F]{6})$)", all_strings("#aG1", 7));
+        check_same_as_regex(v::ipv6(), R"(([0-9a-fA-F]{0,4}:){2,7}[0-9a-fA-F]{0,4})", all_strings(":a1g", 7));
+        check_same_as_regex(v::email(), R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})", all_strings("a1.@-+", 6));
+        check_same_as_regex(v::date_iso(), R"(^\d{4}-(0[1-9]|1[0-2])-(0[1-9]|[12]\d|3[01])$)",
+                            {"2024-01-31", "2024-12-01", "2024-00-10", "2024-13-10", "2024-02-00", "2024-02-32",
+                             "2024-1-10", "24-01-10", "2024/01/10", "2024-01-10x", ""});
+        check_same_as_regex(v::time_iso(), R"(^([01]\d|2[0-3]):([0-5]\d):([0-5]\d)$)",
+                            {"00:00:00", "23:59:59", "24:00:00", "12:60:00", "12:00:60", "1:00:00", "12-00-00", ""});
+        check_same_as_regex(v::uuid(),
+                            R"(^[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}$)",
+                            {"550e8400-e29b-41d4-a716-446655440000", "550E8400-E29B-41D4-A716-446655440000",
+                             "550e8400e29b41d4a716446655440000", "550e8400-e29b-41d4-a716-44665544000",
+                             "550e8400-e29b-41d4-a716-4466554400000", "g50e8400-e29b-41d4-a716-446655440000", ""});
+        check_same_as_regex(v::uuid_v4(),
+                            R"(^[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-4[0-9a-fA-F]{3}-[89abAB][0-9a-fA-F]{3}-[0-9a-fA-F]{12}$)",
+                            {"550e8400-e29b-41d4-a716-446655440000", "550e8400-e29b-41d4-c716-446655440000",
+                             "550e8400-e29b-31d4-a716-446655440000", "550e8400-e29b-41d4-B716-446655440000"});
+        check_same_as_regex(v::url(), R"(https?://[^\s/$.?#].[^\s]*)",
+                            {"http://a.b", "https://example.com/path?q=1", "http://", "http://a", "http:// x",
+                             "http://a b", "http://ab c", "http:///x", "http://.x", "ftp://a.b", "https://x\ny",
+                             "http://x\n", "HTTP://a.b"});
+        check_same_as_regex(
+            v::semver(),
+            R"(^(0|[1-9]\d*)\.(0|[1-9]\d*)\.(0|[1-9]\d*)(?:-((?:0|[1-9]\d*|\d*[a-zA-Z-][0-9a-zA-Z-]*)(?:\.(?:0|[1-9]\d*|\d*[a-zA-Z-][0-9a-zA-Z-]*))*))?(?:\+([0-9a-zA-Z-]+(?:\.[0-9a-zA-Z-]+)*))?$)",
+            {"1.0.0", "0.0.0", "10.20.30", "01.0.0", "1.0", "1.0.0.0", "1.0.0-alpha", "1.0.0-alpha.1", "1.0.0-0",
+             "1.0.0-00", "1.0.0-01a", "1.0.0--", "1.0.0-", "1.0.0-a..b", "1.0.0+build", "1.0.0+001",
+             "1.0.0+", "1.0.0-rc.1+build.5", "1.0.0+a+b", "1.0.0-a_b", "v1.0.0", "1.a.0", ""});
+    }
+
+    TEST_CASE("Hostname and IPv4 matchers") {
+        const char *hostname =
+            R"(^[a-zA-Z0-9]([a-zA-Z0-9-]{0,61}[a-zA-Z0-9])?(\.[a-zA-Z0-9]([a-zA-Z0-9-]{0,61}[a-zA-Z0-9])?)*$)";
+        std::regex hostname_re(hostname);
+        auto hosts = all_strings("a-.", 6);
+        hosts.push_back(std::string(63, 'a'));
+        hosts.push_back(std::string(64, 'a'));
+        for (const auto &host : hosts) {
+            CHECK(argu::detail::match_hostname(host) == std::regex_match(host, hostname_re));
+        }
+
+        std::regex ipv4_re(R"((\d{1,3}\.){3}\d{1,3})");
+        for (const auto &ip : all_strings("1.", 8)) {
+            bool well_formed = argu::detail::match_ipv4(ip) != argu::detail::Ipv4Match::BadFormat;
+            CHECK(well_formed == std::regex_match(ip, ipv4_re));
+        }
+        CHECK(argu::detail::match_ipv4("192.168.0.255") == argu::detail::Ipv4Match::Ok);
+        CHECK(argu::detail::match_ipv4("192.168.0.256") == argu::detail::Ipv4Match::OutOfRange);
+        // Long digit runs are rejected before they overflow the octet value
+        CHECK(argu::detail::match_ipv4("99999999999.1.1.1") == argu::detail::Ipv4Match::BadFormat);
+        CHECK(argu::detail::match_ipv4("1.1.1." + std::string(40, '9')) == argu::detail::Ipv4Match::BadFormat);
+        static_assert(argu::detail::match_ipv4("0999.1.1.1") == argu::detail::Ipv4Match::BadFormat);
+        CHECK(argu::validators::ipv4()("1.2.3.999") == "invalid IPv4 address: octet out of range");
+    }
+
+    TEST_CASE("regex validator compiles its pattern once") {
+        auto digits = argu::validators::regex("[0-9]+", "digits only");
+        auto copy = digits;
+        CHECK_FALSE(copy("12345").has_value());
+        CHECK(copy("12a") == "digits only");
+        CHECK_THROWS_AS(argu::validators::regex("(unclosed"), std::regex_error);
+    }
+}
+
 // =============================================================================
 // Duration Parser Tests
 // =============================================================================
@@ -0,0 +1,114 @@
+/// @file test_chart.cpp
+/// @brief Tests for Series downsampling, Sparkline and Chart
+
+#include <doctest/doctest.h>
+#include <scan/bubbles/chart.hpp>
+
+#include <cmath>
+
+using namespace scan;
+
+TEST_CASE("series range matches a brute-force scan") {
+    Series s;
+    std::vector<double> raw;
+    for (int i = 0; i < 1000; i++) {
+        double v = std::sin(i * 0.37) * 100 + (i % 17);
+        s.push(v);
+        raw.push_back(v);
+    }
+
+    for (size_t a = 0; a < raw.size(); a += 37) {
+        for (size_t b = a + 1; b <= raw.size(); b += 53) {
+            auto r = s.range(a, b);
+            auto [lo, hi] = std::minmax_element(raw.begin() + static_cast<long>(a), raw.begin() + static_cast<long>(b));
+            CHECK(r.min == *lo);
+            CHECK(r.max == *hi);
+        }
+    }
+    CHECK(s.range(5, 5).empty());
+    CHECK(s.range(990, 5000).max == s.range(990, 1000).max);
+}
+
+TEST_CASE("series treats NaN as gaps") {
+    std::vector<double> values = {1, NAN, 5, NAN};
+    Series s;
+    s.append(values.begin(), values.end());
+    CHECK(s.range(0, 4).min == 1);
+    CHECK(s.range(0, 4).max == 5);
+    CHECK(s.range(3, 4).empty());
+}
+
+TEST_CASE("series trims to max_points") {
+    Series s(100);
+    for (int i = 0; i < 1000; i++) {
+        s.push(i);
+        CHECK(s.size() < 200);
+    }
+    CHECK(s.size() + s.dropped() == 1000);
+    CHECK(s[s.size() - 1] == 999);
+    CHECK(s.bounds().max == 999);
+    CHECK(s.bounds().min == static_cast<double>(s.dropped()));
+}
+
+TEST_CASE("lttb keeps endpoints and peaks") {
+    std::vector<double> values(1000, 0.0);
+    values[500] = 100.0;
+    auto idx = lttb(values, 20);
+    CHECK(idx.size() == 20);
+    CHECK(idx.front() == 0);
+    CHECK(idx.back() == 999);
+    CHECK(std::find(idx.begin(), idx.end(), 500) != idx.end());
+    CHECK(std::is_sorted(idx.begin(), idx.end()));
+    CHECK(lttb(values, 2000).size() == 1000);
+}
+
+TEST_CASE("sparkline scales to its width") {
+    SparklineModel m;
+    m.width = 8;
+    for (int i = 0; i < 8; i++) {
+        m.series.push(i);
+    }
+    std::string view = sparkline_view(m);
+    CHECK(view.find("▁") != std::string::npos);
+    CHECK(view.find("█") != std::string::npos);
+
+    // A spike among a million points survives downsampling
+    SparklineModel big;
+    big.width = 50;
+    for (int i = 0; i < 1000000; i++) {
+        big.series.push(i == 654321 ? 10.0 : 0.0);
+    }
+    std::string big_view = sparkline_view(big);
+    CHECK(big_view.find("█") != std::string::npos);
+}
+
+TEST_CASE("chart draws braille cells within bounds") {
+    ChartModel m;
+    m.width = 30;
+    m.height = 4;
+    m.show_axis = false;
+    for (int i = 0; i < 100000; i++) {
+        m.series.push(std::sin(i / 5000.0));
+    }
+    std::string view = chart_view(m);
+    CHECK(std::count(view.begin(), view.end(), '\n') == 3);
+    // Every cell is a Braille glyph and at least some dots are set
+    CHECK(view.find("\xE2\xA0\x80") != std::string::npos);
+    CHECK(view.find("\xE2\xA3") != std::string::npos);
+
+    m.show_axis = true;
+    m.title = "load";
+    std::string with_axis = chart_view(m);
+    CHECK(with_axis.find("load") != std::string::npos);
+    CHECK(with_axis.find("┤") != std::string::npos);
+}
+
+TEST_CASE("chart handles empty and flat series") {
+    ChartModel m;
+    m.width = 10;
+    m.height = 2;
+    CHECK_FALSE(chart_view(m).empty());
+    m.series.push(3.0);
+    m.series.push(3.0);
+    CHECK(chart_view(m).find("3") != std::string::npos);
+}
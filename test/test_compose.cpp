@@ -0,0 +1,192 @@
+/// @file test_compose.cpp
+/// @brief Tests for component composition and focus management
+
+#include <doctest/doctest.h>
+#include <scan/bubbles/form.hpp>
+
+using namespace scan;
+
+namespace {
+
+    tea::KeyMsg rune(char32_t c) {
+        tea::KeyMsg k;
+        k.key = input::Key::Rune;
+        k.rune = c;
+        return k;
+    }
+
+    tea::KeyMsg key(input::Key k) {
+        tea::KeyMsg msg;
+        msg.key = k;
+        return msg;
+    }
+
+    // Feed a message and run the returned command the way Program does
+    tea::CompositeModel step(tea::CompositeModel m, const tea::Msg &msg, bool *quit = nullptr) {
+        auto [next, cmd] = tea::composite_update(std::move(m), msg);
+        if (cmd) {
+            if (auto out = cmd()) {
+                if (tea::is<tea::QuitMsg>(*out)) {
+                    if (quit) {
+                        *quit = true;
+                    }
+                } else {
+                    auto [again, c2] = tea::composite_update(std::move(next), *out);
+                    return std::move(again);
+                }
+            }
+        }
+        return std::move(next);
+    }
+
+    tea::CompositeModel three_inputs() {
+        tea::CompositeModel m;
+        tea::composite_add(m, "", tea::Component::text("Sign up"));
+        for (const char *name : {"user", "email", "city"}) {
+            TextInputModel input;
+            input.prompt = std::string(name) + ": ";
+            tea::composite_add(m, name, tea::Component(input, textinput_update, textinput_view));
+        }
+        tea::composite_init(m);
+        return m;
+    }
+
+} // namespace
+
+TEST_CASE("composite focuses the first focusable component") {
+    auto m = three_inputs();
+    CHECK(m.focus == 1);
+    CHECK(m.find("user")->get<TextInputModel>()->focused);
+    CHECK_FALSE(m.find("email")->get<TextInputModel>()->focused);
+    CHECK(m.find("nope") == nullptr);
+}
+
+TEST_CASE("keys reach only the focused component") {
+    auto m = three_inputs();
+    m = step(std::move(m), rune('a'));
+    m = step(std::move(m), rune('b'));
+    CHECK(m.find("user")->get<TextInputModel>()->value == "ab");
+    CHECK(m.find("email")->get<TextInputModel>()->value.empty());
+
+    m = step(std::move(m), key(input::Key::Tab));
+    CHECK(m.focus == 2);
+    m = step(std::move(m), rune('x'));
+    CHECK(m.find("email")->get<TextInputModel>()->value == "x");
+    CHECK(m.find("user")->get<TextInputModel>()->value == "ab");
+
+    // Shift+Tab wraps past the static heading
+    m = step(std::move(m), key(input::Key::ShiftTab));
+    m = step(std::move(m), key(input::Key::ShiftTab));
+    CHECK(m.focus == 3);
+}
+
+TEST_CASE("only changed components re-render") {
+    auto m = three_inputs();
+    std::string first = tea::composite_view(m);
+    CHECK(first.find("Sign up") != std::string::npos);
+    CHECK(first.find("city: ") != std::string::npos);
+
+    size_t user = m.find("user")->render_count();
+    size_t city = m.find("city")->render_count();
+    for (char c : std::string("hello")) {
+        m = step(std::move(m), rune(static_cast<unsigned char>(c)));
+        tea::composite_view(m);
+    }
+    CHECK(m.find("user")->render_count() == user + 5);
+    CHECK(m.find("city")->render_count() == city);
+    CHECK(tea::composite_view(m).find("hello") != std::string::npos);
+}
+
+TEST_CASE("enter advances focus and the last field submits") {
+    auto m = three_inputs();
+    bool quit = false;
+    m = step(std::move(m), key(input::Key::Enter), &quit);
+    CHECK(m.focus == 2);
+    CHECK_FALSE(quit);
+    m = step(std::move(m), key(input::Key::Enter), &quit);
+    CHECK(m.focus == 3);
+    m = step(std::move(m), key(input::Key::Enter), &quit);
+    CHECK(quit);
+    CHECK(m.submitted);
+    CHECK_FALSE(m.cancelled);
+}
+
+TEST_CASE("escape cancels the whole composite") {
+    auto m = three_inputs();
+    bool quit = false;
+    m = step(std::move(m), key(input::Key::Escape), &quit);
+    CHECK(quit);
+    CHECK(m.cancelled);
+}
+
+TEST_CASE("broadcast messages reach every component") {
+    struct Counter {
+        int ticks = 0;
+    };
+    auto update = [](Counter c, const tea::Msg &msg) -> std::pair<Counter, tea::Cmd> {
+        if (tea::is<tea::TickMsg>(msg)) {
+            c.ticks++;
+        }
+        return {c, tea::none()};
+    };
+    auto view = [](const Counter &c) { return std::to_string(c.ticks); };
+
+    tea::CompositeModel m;
+    tea::composite_add(m, "a", tea::Component(Counter{}, update, view));
+    tea::composite_add(m, "b", tea::Component(Counter{}, update, view, false));
+    tea::composite_init(m);
+    m = step(std::move(m), tea::TickMsg{1});
+    CHECK(m.find("a")->get<Counter>()->ticks == 1);
+    CHECK(m.find("b")->get<Counter>()->ticks == 1);
+    CHECK(tea::composite_view(m) == "1\n1");
+}
+
+TEST_CASE("form builder reads field values") {
+    Form form;
+    form.title("Register")
+        .input("name", TextInput().prompt("Name: "))
+        .list("role", List().items({"Developer", "Designer"}))
+        .confirm("agree", Confirm().prompt("Agree?"));
+    auto &m = form.model();
+    tea::composite_init(m);
+
+    m = step(std::move(m), rune('Z'));
+    m = step(std::move(m), key(input::Key::Enter));
+    m = step(std::move(m), key(input::Key::Down));
+    m = step(std::move(m), key(input::Key::Enter));
+    CHECK(form.value("name") == std::string("Z"));
+    CHECK(form.value("role") == std::string("Designer"));
+    CHECK(form.value("agree") == std::string("yes"));
+    CHECK(form.get<ConfirmModel>("agree") != nullptr);
+    CHECK_FALSE(form.value("missing"));
+}
+
+TEST_CASE("parallel rendering matches serial rendering") {
+    auto view = [](const std::string &s) { return Style().foreground(current_theme().colors.primary).render(s); };
+    auto update = [](std::string s, const tea::Msg &msg) -> std::pair<std::string, tea::Cmd> {
+        if (tea::is<tea::TickMsg>(msg)) {
+            s += "+";
+        }
+        return {s, tea::none()};
+    };
+
+    tea::CompositeModel serial, parallel;
+    for (const char *pane : {"left\nmore", "middle", "right"}) {
+        tea::composite_add(serial, pane, tea::Component(std::string(pane), update, view));
+        tea::composite_add(parallel, pane, tea::Component(std::string(pane), update, view));
+    }
+    parallel.parallel = true;
+    CHECK(tea::composite_view(parallel) == tea::composite_view(serial));
+    CHECK(parallel.components[2].render_count() == 1);
+
+    // Side by side, after every pane changed
+    serial.horizontal = parallel.horizontal = true;
+    serial = step(std::move(serial), tea::TickMsg{1});
+    parallel = step(std::move(parallel), tea::TickMsg{1});
+    std::string row = tea::composite_view(parallel);
+    CHECK(row == tea::composite_view(serial));
+    CHECK(parallel.components[2].render_count() == 2);
+    CHECK(row.find("right+") != std::string::npos);
+    // "left" + gap + "middle+" + gap + "right+", and a second line for the taller pane
+    CHECK(visible_width(row.substr(0, row.find('\n'))) == 5 + 1 + 7 + 1 + 6);
+}
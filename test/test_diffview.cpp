@@ -0,0 +1,239 @@
+/// @file test_diffview.cpp
+/// @brief Tests for the Myers diff and the DiffView component
+
+#include <doctest/doctest.h>
+#include <scan/bubbles/diffview.hpp>
+
+#include <random>
+
+using namespace scan;
+
+namespace {
+
+    std::string join(const std::vector<std::string> &lines) {
+        std::string out;
+        for (const auto &l : lines) {
+            out += l + "\n";
+        }
+        return out;
+    }
+
+    // Apply the changes to a and check the result is b
+    bool reconstructs(const std::vector<std::string> &a, const std::vector<std::string> &b,
+                      const std::vector<diff::Change> &changes) {
+        std::vector<std::string> out;
+        size_t pa = 0, pb = 0;
+        for (const auto &c : changes) {
+            if (c.a < pa || c.b < pb || c.a - pa != c.b - pb || c.a + c.a_len > a.size() || c.b + c.b_len > b.size()) {
+                return false;
+            }
+            for (size_t i = pa; i < c.a; i++) {
+                if (a[i] != b[pb + (i - pa)]) {
+                    return false;
+                }
+                out.push_back(a[i]);
+            }
+            out.insert(out.end(), b.begin() + static_cast<long>(c.b), b.begin() + static_cast<long>(c.b + c.b_len));
+            pa = c.a + c.a_len;
+            pb = c.b + c.b_len;
+        }
+        out.insert(out.end(), a.begin() + static_cast<long>(pa), a.end());
+        return out == b;
+    }
+
+    std::vector<diff::Change> diff_lines(const std::string &a, const std::string &b, diff::Options options = {}) {
+        diff::LineIndex la(a.data(), a.size()), lb(b.data(), b.size());
+        std::vector<diff::Change> changes;
+        diff::lines(
+            la, lb,
+            [&](const diff::Change &c) {
+                changes.push_back(c);
+                return true;
+            },
+            nullptr, options);
+        return changes;
+    }
+
+    DiffViewModel started(const std::string &a, const std::string &b) {
+        DiffViewModel m;
+        diffview_set_texts(m, a, b);
+        auto cmd = diffview_start(m);
+        auto msg = cmd(); // No program running: the diff completes synchronously
+        REQUIRE(msg);
+        auto [done, c] = diffview_update(std::move(m), *msg);
+        return std::move(done);
+    }
+
+} // namespace
+
+TEST_CASE("line index splits on newlines") {
+    std::string text = "one\ntwo\n\nlast";
+    diff::LineIndex lines(text.data(), text.size());
+    REQUIRE(lines.size() == 4);
+    CHECK(lines[0] == "one");
+    CHECK(lines[2] == "");
+    CHECK(lines[3] == "last");
+    CHECK(diff::LineIndex("", 0).size() == 0);
+    CHECK(diff::LineIndex("x\n", 2).size() == 1);
+}
+
+TEST_CASE("myers finds minimal edit scripts") {
+    std::mt19937 rng(7);
+    for (int trial = 0; trial < 500; trial++) {
+        std::vector<int> a(rng() % 40), b;
+        for (auto &x : a) {
+            x = static_cast<int>(rng() % 4);
+        }
+        b = a;
+        int edits = static_cast<int>(rng() % 5);
+        for (int e = 0; e < edits; e++) {
+            if (!b.empty() && rng() % 2) {
+                b.erase(b.begin() + static_cast<long>(rng() % b.size()));
+            } else {
+                b.insert(b.begin() + static_cast<long>(b.empty() ? 0 : rng() % b.size()), 9);
+            }
+        }
+        diff::Myers<int> myers(a.data(), a.size(), b.data(), b.size());
+        size_t cost = 0;
+        myers.run([&](const diff::Change &c) {
+            cost += c.a_len + c.b_len;
+            return true;
+        });
+        CHECK(cost <= static_cast<size_t>(edits));
+    }
+}
+
+TEST_CASE("windowed line diff always reconstructs the target") {
+    std::mt19937 rng(11);
+    for (int trial = 0; trial < 300; trial++) {
+        std::vector<std::string> a(rng() % 200);
+        for (auto &l : a) {
+            l = std::to_string(rng() % 20);
+        }
+        auto b = a;
+        for (int e = static_cast<int>(rng() % 10); e > 0; e--) {
+            size_t at = b.empty() ? 0 : rng() % b.size();
+            if (rng() % 2 && !b.empty()) {
+                b.erase(b.begin() + static_cast<long>(at), b.begin() + static_cast<long>(std::min(b.size(), at + rng() % 20)));
+            } else {
+                b.insert(b.begin() + static_cast<long>(at), rng() % 30, "new");
+            }
+        }
+        diff::Options options;
+        options.window = 1 + rng() % 16;
+        options.max_window = options.window * 4;
+        CHECK(reconstructs(a, b, diff_lines(join(a), join(b), options)));
+    }
+}
+
+TEST_CASE("inline changes trim common prefix and suffix") {
+    auto r = diff::inline_changes("port = 8080", "port = 9090");
+    CHECK(r.a_begin == 7);
+    CHECK(r.a_end == 10);
+    CHECK(r.b_end == 10);
+
+    // Never split a multi-byte character
+    auto u = diff::inline_changes("caf\xC3\xA9", "caf\xC3\xA8");
+    CHECK(u.a_begin == 3);
+    CHECK(u.a_end == 5);
+}
+
+TEST_CASE("diffview groups changes into hunks with context") {
+    std::vector<std::string> a;
+    for (int i = 0; i < 100; i++) {
+        a.push_back("line " + std::to_string(i));
+    }
+    auto b = a;
+    b[10] = "changed 10";
+    b[12] = "changed 12"; // Within 2 * context: same hunk
+    b.erase(b.begin() + 60);
+
+    auto m = started(join(a), join(b));
+    CHECK(m.done);
+    REQUIRE(m.hunks.size() == 2);
+    CHECK(m.hunks[0].a == 7);
+    CHECK(m.hunks[0].a_end == 16);
+    CHECK(m.hunks[0].count == 2);
+    CHECK(m.added == 2);
+    CHECK(m.removed == 3);
+    // header + 3 context + (-1 +1) + 1 context + (-1 +1) + 3 context
+    CHECK(m.hunks[0].rows == 12);
+    CHECK(m.hunks[1].row == 12);
+    CHECK(m.total_rows == 12 + 1 + 6 + 1);
+
+    m.height = 30;
+    m.width = 80;
+    std::string view = diffview_view(m);
+    CHECK(view.find("@@ -8,9 +8,9 @@") != std::string::npos);
+    CHECK(view.find("line 60") != std::string::npos);
+    CHECK(view.find("line 30") == std::string::npos); // Outside every hunk
+}
+
+TEST_CASE("diffview renders only the visible rows") {
+    std::vector<std::string> a, b;
+    for (int i = 0; i < 1000; i++) {
+        a.push_back("a" + std::to_string(i));
+        b.push_back(i % 50 == 0 ? "b" + std::to_string(i) : a.back());
+    }
+    auto m = started(join(a), join(b));
+    REQUIRE(m.hunks.size() == 20);
+    m.height = 5;
+    m.offset = m.hunks[10].row;
+    auto rows = diffview_visible_rows(m);
+    REQUIRE(rows.size() == 5);
+    CHECK(rows[0].kind == DiffRow::Kind::Header);
+    CHECK(rows[0].hunk == &m.hunks[10]);
+    CHECK(rows[4].kind == DiffRow::Kind::Delete);
+    CHECK(rows[4].a == 500);
+    CHECK(rows[4].partner == 500);
+
+    // Starting mid-hunk
+    m.offset = m.hunks[10].row + 5;
+    rows = diffview_visible_rows(m);
+    CHECK(rows[0].kind == DiffRow::Kind::Insert);
+    CHECK(rows[0].b == 500);
+}
+
+TEST_CASE("diffview navigation and side-by-side layout") {
+    std::vector<std::string> a, b;
+    for (int i = 0; i < 200; i++) {
+        a.push_back("x" + std::to_string(i));
+        b.push_back(i % 40 == 5 ? "y" + std::to_string(i) : a.back());
+    }
+    auto m = started(join(a), join(b));
+    m.height = 4;
+    REQUIRE(m.hunks.size() == 5);
+
+    tea::KeyMsg next;
+    next.key = input::Key::Rune;
+    next.rune = 'n';
+    auto [m1, c1] = diffview_update(std::move(m), next);
+    CHECK(m1.offset == m1.hunks[1].row);
+    auto [m2, c2] = diffview_update(std::move(m1), next);
+    CHECK(m2.offset == m2.hunks[2].row);
+
+    tea::KeyMsg toggle;
+    toggle.key = input::Key::Rune;
+    toggle.rune = 's';
+    size_t unified_rows = m2.total_rows;
+    auto [m3, c3] = diffview_update(std::move(m2), toggle);
+    CHECK(m3.side_by_side);
+    CHECK(m3.total_rows == unified_rows - 5); // Each replaced line pairs up on one row
+    CHECK(m3.offset == m3.hunks[2].row);
+
+    m3.width = 60;
+    std::string view = diffview_view(m3);
+    CHECK(view.find("│") != std::string::npos);
+    CHECK(view.find("85") != std::string::npos);
+}
+
+TEST_CASE("diffview reports identical inputs and ignores stale jobs") {
+    auto same = started("a\nb\n", "a\nb\n");
+    CHECK(same.done);
+    CHECK(same.hunks.empty());
+    CHECK(diffview_view(same).find("no differences") != std::string::npos);
+
+    DiffJob other;
+    auto [m, c] = diffview_update(std::move(same), tea::TaskMsg{0, DiffProgress{&other}});
+    CHECK(m.hunks.empty());
+}
@@ -0,0 +1,255 @@
+/// @file test_execview.cpp
+/// @brief Tests for the exec service and ExecView component
+
+#include <doctest/doctest.h>
+#include <scan/bubbles/execview.hpp>
+
+#include <chrono>
+
+namespace {
+
+    // Pump the exec service until the process with the given id reports its exit
+    std::vector<scan::tea::Msg> run_to_exit(int id) {
+        auto &svc = scan::tea::exec_service();
+        std::vector<scan::tea::Msg> msgs;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (std::chrono::steady_clock::now() < deadline) {
+            svc.poll(20);
+            for (auto &msg : svc.take_messages()) {
+                msgs.push_back(msg);
+                if (auto *done = scan::tea::try_as<scan::tea::ExecExitMsg>(msg); done && done->id == id) {
+                    return msgs;
+                }
+            }
+        }
+        return msgs;
+    }
+
+} // namespace
+
+TEST_CASE("exec service streams stdout and stderr separately") {
+    auto &svc = scan::tea::exec_service();
+    REQUIRE(svc.spawn(1, {"sh", "-c", "echo out; echo err 1>&2; exit 3"}));
+
+    std::string out, err;
+    int exit_code = -100;
+    for (auto &msg : run_to_exit(1)) {
+        if (auto *o = scan::tea::try_as<scan::tea::ExecOutputMsg>(msg)) {
+            (o->from_stderr ? err : out) += o->data;
+        } else if (auto *done = scan::tea::try_as<scan::tea::ExecExitMsg>(msg)) {
+            exit_code = done->exit_code;
+            CHECK(done->error.empty());
+        }
+    }
+
+    CHECK(out == "out\n");
+    CHECK(err == "err\n");
+    CHECK(exit_code == 3);
+    CHECK_FALSE(svc.active());
+}
+
+TEST_CASE("exec service reports spawn failures as exit messages") {
+    auto &svc = scan::tea::exec_service();
+    CHECK_FALSE(svc.spawn(2, {"scan-test-no-such-command"}));
+
+    auto msgs = run_to_exit(2);
+    REQUIRE(msgs.size() == 1);
+    auto *done = scan::tea::try_as<scan::tea::ExecExitMsg>(msgs[0]);
+    REQUIRE(done != nullptr);
+    CHECK(done->exit_code == -1);
+    CHECK_FALSE(done->error.empty());
+}
+
+TEST_CASE("exec service bounds buffered output") {
+    auto &svc = scan::tea::exec_service();
+    scan::tea::ExecOptions opts;
+    opts.max_pending = 64 * 1024;
+    REQUIRE(svc.spawn(3, {"sh", "-c", "head -c 1048576 /dev/zero"}, opts));
+
+    size_t total = 0;
+    size_t largest = 0;
+    for (auto &msg : run_to_exit(3)) {
+        if (auto *o = scan::tea::try_as<scan::tea::ExecOutputMsg>(msg)) {
+            total += o->data.size();
+            largest = std::max(largest, o->data.size());
+        }
+    }
+
+    CHECK(total == 1048576);
+    CHECK(largest <= opts.max_pending);
+}
+
+TEST_CASE("exec service reports the terminating signal") {
+    auto &svc = scan::tea::exec_service();
+    REQUIRE(svc.spawn(4, {"sleep", "10"}));
+    CHECK(svc.kill(4, SIGKILL));
+
+    auto msgs = run_to_exit(4);
+    REQUIRE_FALSE(msgs.empty());
+    auto *done = scan::tea::try_as<scan::tea::ExecExitMsg>(msgs.back());
+    REQUIRE(done != nullptr);
+    CHECK(done->signal == SIGKILL);
+}
+
+TEST_CASE("exec service kills only the processes of the given owner") {
+    auto &svc = scan::tea::exec_service();
+    int a = 0, b = 0;
+    REQUIRE(svc.spawn(7, {"sleep", "10"}, {}, &a));
+    REQUIRE(svc.spawn(8, {"sleep", "10"}, {}, &b));
+
+    svc.kill_owned(&a);
+    REQUIRE(svc.active());
+    CHECK(svc.kill(8, SIGKILL));
+    CHECK_FALSE(svc.kill(7, SIGKILL));
+
+    auto msgs = run_to_exit(8);
+    REQUIRE_FALSE(msgs.empty());
+    auto *done = scan::tea::try_as<scan::tea::ExecExitMsg>(msgs.back());
+    REQUIRE(done != nullptr);
+    CHECK(done->id == 8);
+    CHECK_FALSE(svc.active());
+}
+
+TEST_CASE("exec service delivers each owner only its own messages") {
+    auto &svc = scan::tea::exec_service();
+    int a = 0, b = 0;
+    REQUIRE(svc.spawn(9, {"sh", "-c", "echo from-a"}, {}, &a));
+    REQUIRE(svc.spawn(10, {"sh", "-c", "echo from-b"}, {}, &b));
+
+    // Drain only a until its process exits; b's output and exit must wait for b
+    std::string out_a;
+    bool a_done = false;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!a_done && std::chrono::steady_clock::now() < deadline) {
+        svc.poll(20);
+        for (auto &msg : svc.take_messages(&a)) {
+            if (auto *o = scan::tea::try_as<scan::tea::ExecOutputMsg>(msg)) {
+                CHECK(o->id == 9);
+                out_a += o->data;
+            } else if (auto *done = scan::tea::try_as<scan::tea::ExecExitMsg>(msg)) {
+                CHECK(done->id == 9);
+                a_done = true;
+            }
+        }
+    }
+    CHECK(a_done);
+    CHECK(out_a == "from-a\n");
+    REQUIRE(svc.active());
+
+    std::string out_b;
+    bool b_done = false;
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!b_done && std::chrono::steady_clock::now() < deadline) {
+        svc.poll(20);
+        for (auto &msg : svc.take_messages(&b)) {
+            if (auto *o = scan::tea::try_as<scan::tea::ExecOutputMsg>(msg)) {
+                out_b += o->data;
+            } else if (auto *done = scan::tea::try_as<scan::tea::ExecExitMsg>(msg)) {
+                CHECK(done->id == 10);
+                b_done = true;
+            }
+        }
+    }
+    CHECK(b_done);
+    CHECK(out_b == "from-b\n");
+    CHECK_FALSE(svc.active());
+}
+
+TEST_CASE("execview_append splits chunks into lines") {
+    scan::ExecViewModel m;
+    m.viewport.wrap = false;
+
+    scan::execview_append(m, "first\nsec");
+    CHECK(m.viewport.lines.size() == 1);
+    CHECK(m.partial[0] == "sec");
+
+    scan::execview_append(m, "ond\nthird\n");
+    REQUIRE(m.viewport.lines.size() == 3);
+    CHECK(m.viewport.lines[1] == "second");
+    CHECK(m.viewport.lines[2] == "third");
+    CHECK(m.partial[0].empty());
+    CHECK(m.bytes_received == 19);
+}
+
+TEST_CASE("execview_append keeps the text after carriage returns") {
+    scan::ExecViewModel m;
+    scan::execview_append(m, "10%\r50%\r100%\nwindows\r\n");
+
+    REQUIRE(m.viewport.lines.size() == 2);
+    CHECK(m.viewport.lines[0] == "100%");
+    CHECK(m.viewport.lines[1] == "windows");
+}
+
+TEST_CASE("execview_append bounds lines that never end") {
+    scan::ExecViewModel m;
+    m.viewport.wrap = false;
+    m.max_partial = 1024;
+
+    // A progress bar only ever redraws its line
+    for (int i = 0; i <= 100000; i++) {
+        scan::execview_append(m, std::to_string(i % 100) + "%\r");
+    }
+    scan::execview_append(m, "100%\r");
+    CHECK(m.viewport.lines.empty());
+    CHECK(m.partial[0] == "100%\r");
+    scan::execview_append(m, "\ndone\n");
+    REQUIRE(m.viewport.lines.size() == 2);
+    CHECK(m.viewport.lines[0] == "100%");
+
+    // Binary data without newlines is broken into max_partial-byte lines
+    scan::execview_append(m, std::string(10 * 1024 + 5, 'x'));
+    CHECK(m.viewport.lines.size() == 12);
+    CHECK(m.viewport.lines.back().size() == 1024);
+    CHECK(m.partial[0].size() == 5);
+}
+
+TEST_CASE("execview_append enforces max_lines") {
+    scan::ExecViewModel m;
+    m.max_lines = 100;
+    m.viewport.height = 10;
+
+    std::string chunk;
+    for (int i = 0; i < 1000; i++) {
+        chunk += "line " + std::to_string(i) + "\n";
+    }
+    scan::execview_append(m, chunk);
+
+    CHECK(m.viewport.lines.size() <= 100 + 64);
+    CHECK(m.viewport.lines.back() == "line 999");
+    CHECK(m.lines_dropped + m.viewport.lines.size() == 1000);
+    CHECK(scan::viewport_at_bottom(m.viewport));
+}
+
+TEST_CASE("execview_update handles output and exit messages") {
+    scan::ExecViewModel m;
+    m.id = 5;
+    m.running = true;
+
+    auto [m1, c1] = scan::execview_update(m, scan::tea::ExecOutputMsg{5, "hello\npartial", false});
+    auto [m2, c2] = scan::execview_update(m1, scan::tea::ExecOutputMsg{6, "other\n", false});
+    CHECK(m2.viewport.lines.size() == 1);
+
+    auto [m3, c3] = scan::execview_update(m2, scan::tea::ExecExitMsg{5, 0, 0, ""});
+    CHECK_FALSE(m3.running);
+    CHECK(m3.exited);
+    REQUIRE(m3.viewport.lines.size() == 2);
+    CHECK(m3.viewport.lines[1] == "partial");
+    CHECK(c3 == nullptr);
+}
+
+TEST_CASE("execview_update pauses follow when scrolled up") {
+    scan::ExecViewModel m;
+    m.viewport.height = 2;
+    scan::execview_append(m, "1\n2\n3\n4\n5\n");
+    CHECK(m.follow);
+
+    scan::tea::KeyMsg up;
+    up.key = scan::input::Key::Up;
+    auto [m1, c1] = scan::execview_update(m, up);
+    CHECK_FALSE(m1.follow);
+
+    scan::tea::KeyMsg end;
+    end.key = scan::input::Key::End;
+    auto [m2, c2] = scan::execview_update(m1, end);
+    CHECK(m2.follow);
+}
@@ -108,3 +108,26 @@ TEST_CASE("Filter query filtering") {
     // All items with 'a' should be in filtered (apple, apricot, banana)
     CHECK(new_model.filtered.size() <= 4);
 }
+
+TEST_CASE("Filter items stream in and merge by score") {
+    scan::FilterModel model;
+    model.loading = true;
+    model.query = "ap";
+    scan::filter_refresh(model);
+
+    auto [m1, c1] = scan::filter_update(model, scan::tea::LogMsg{0, "grape\nbanana\n", false});
+    REQUIRE(m1.filtered.size() == 1);
+    CHECK(m1.items[m1.filtered[0]] == "grape");
+    CHECK(m1.loading);
+
+    // A better match arriving later is ranked ahead of the earlier one
+    auto [m2, c2] = scan::filter_update(m1, scan::tea::LogMsg{0, "apple", true});
+    REQUIRE(m2.filtered.size() == 2);
+    CHECK(m2.items[m2.filtered[0]] == "apple");
+    CHECK(m2.filtered == scan::fuzzy::filter(m2.items, "ap"));
+    CHECK_FALSE(m2.loading);
+
+    // Items for another source are ignored
+    auto [m3, c3] = scan::filter_update(m2, scan::tea::LogMsg{7, "apex", false});
+    CHECK(m3.items.size() == 3);
+}
@@ -0,0 +1,217 @@
+/// @file test_hexview.cpp
+/// @brief Tests for byte search, memory mapping and the HexView component
+
+#include <doctest/doctest.h>
+#include <scan/bubbles/hexview.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+using namespace scan;
+
+namespace {
+
+    tea::KeyMsg rune(char32_t c) {
+        tea::KeyMsg k;
+        k.key = input::Key::Rune;
+        k.rune = c;
+        return k;
+    }
+
+    tea::KeyMsg key(input::Key k) {
+        tea::KeyMsg msg;
+        msg.key = k;
+        return msg;
+    }
+
+    HexViewModel type(HexViewModel m, const std::string &text) {
+        for (char c : text) {
+            auto [next, cmd] = hexview_update(std::move(m), rune(static_cast<unsigned char>(c)));
+            m = std::move(next);
+        }
+        return m;
+    }
+
+    // Submit the prompt and deliver the search result (synchronous without a running program)
+    HexViewModel submit(HexViewModel m) {
+        auto [next, cmd] = hexview_update(std::move(m), key(input::Key::Enter));
+        if (cmd) {
+            if (auto msg = cmd()) {
+                auto [done, c2] = hexview_update(std::move(next), *msg);
+                return std::move(done);
+            }
+        }
+        return std::move(next);
+    }
+
+} // namespace
+
+TEST_CASE("byte search matches the scalar reference") {
+    std::mt19937 rng(42);
+    std::string data(100000, '\0');
+    for (auto &c : data) {
+        c = static_cast<char>('a' + rng() % 4); // Small alphabet: many partial matches
+    }
+    for (size_t len : {1, 2, 3, 5, 8, 17, 40}) {
+        for (int trial = 0; trial < 20; trial++) {
+            size_t at = rng() % (data.size() - len);
+            std::string pattern = data.substr(at, len);
+            size_t start = rng() % 1000;
+            auto *d = reinterpret_cast<const uint8_t *>(data.data()) + start;
+            auto *p = reinterpret_cast<const uint8_t *>(pattern.data());
+            CHECK(bytes::find(d, data.size() - start, p, len) == bytes::find_scalar(d, data.size() - start, p, len));
+        }
+    }
+    CHECK(bytes::find(std::string("hello world"), std::string("world")) == 6);
+    CHECK(bytes::find(std::string("hello"), std::string("xyz")) == bytes::npos);
+    CHECK(bytes::find(std::string("ab"), std::string("abc")) == bytes::npos);
+    // Match at the very end, past the last full vector
+    std::string tail(70, 'x');
+    tail += "needle";
+    CHECK(bytes::find(tail, std::string("needle")) == 70);
+}
+
+TEST_CASE("hex helpers") {
+    char out[2];
+    bytes::hex_byte(out, 0xaf);
+    CHECK(std::string(out, 2) == "af");
+
+    std::vector<uint8_t> pattern;
+    CHECK(bytes::parse_hex("de ad BE ef", pattern));
+    CHECK(pattern == std::vector<uint8_t>{0xde, 0xad, 0xbe, 0xef});
+    CHECK(bytes::parse_hex("0x7f45", pattern));
+    CHECK(pattern == std::vector<uint8_t>{0x7f, 0x45});
+    CHECK_FALSE(bytes::parse_hex("abc", pattern));
+    CHECK_FALSE(bytes::parse_hex("zz", pattern));
+
+    CHECK(hexview_parse_offset("0x10", 0) == size_t{16});
+    CHECK(hexview_parse_offset("100", 0) == size_t{100});
+    CHECK(hexview_parse_offset("+8", 10) == size_t{18});
+    CHECK(hexview_parse_offset("-20", 10) == size_t{0});
+    CHECK_FALSE(hexview_parse_offset("0xzz", 0));
+}
+
+TEST_CASE("mapped file reads a file from disk") {
+    std::string path = "/tmp/scan_test_hexview.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (int i = 0; i < 4096; i++) {
+            out.put(static_cast<char>(i & 0xff));
+        }
+    }
+    auto file = MappedFile::open(path);
+    REQUIRE(file.ok());
+    CHECK(file.size() == 4096);
+    CHECK(file.data()[255] == 255);
+    CHECK(file.data()[256] == 0);
+
+    MappedFile moved = std::move(file);
+    CHECK(moved.size() == 4096);
+    CHECK(file.size() == 0);
+    std::remove(path.c_str());
+
+    auto missing = MappedFile::open("/nonexistent/scan.bin");
+    CHECK_FALSE(missing.ok());
+    CHECK(missing.empty());
+
+    auto mem = MappedFile::from_bytes("abc");
+    MappedFile mem_moved = std::move(mem);
+    CHECK(std::string(reinterpret_cast<const char *>(mem_moved.data()), mem_moved.size()) == "abc");
+}
+
+TEST_CASE("hexview renders only visible rows") {
+    HexViewModel m;
+    std::string bytes;
+    for (int i = 0; i < 256; i++) {
+        bytes += static_cast<char>(i);
+    }
+    m.file = std::make_shared<MappedFile>(MappedFile::from_bytes(bytes));
+    m.height = 2;
+    m.show_status = false;
+
+    std::string view = hexview_view(m);
+    CHECK(std::count(view.begin(), view.end(), '\n') == 1);
+    CHECK(view.find("00000000") != std::string::npos);
+    CHECK(view.find("00000010") != std::string::npos);
+    CHECK(view.find("00000020") == std::string::npos);
+    CHECK(view.find("0f") != std::string::npos);
+
+    hexview_goto(m, 0x41);
+    view = hexview_view(m);
+    CHECK(m.offset == 0x30);
+    CHECK(view.find("BCDEFGHIJKLMNO") != std::string::npos); // 'A' is styled as the cursor
+}
+
+TEST_CASE("hexview navigation and goto") {
+    HexViewModel m;
+    m.file = std::make_shared<MappedFile>(MappedFile::from_bytes(std::string(1000, 'x')));
+    m.height = 4;
+
+    auto [down, c1] = hexview_update(std::move(m), key(input::Key::Down));
+    CHECK(down.cursor == 16);
+    auto [end, c2] = hexview_update(std::move(down), rune('G'));
+    CHECK(end.cursor == 999);
+    CHECK(end.offset == (999 / 16 - 3) * 16);
+
+    auto [prompt, c3] = hexview_update(std::move(end), rune(':'));
+    CHECK(prompt.prompt == HexViewModel::Prompt::Goto);
+    auto target = submit(type(std::move(prompt), "0x40"));
+    CHECK(target.cursor == 0x40);
+    CHECK(target.prompt == HexViewModel::Prompt::None);
+
+    auto [prompt2, c4] = hexview_update(std::move(target), rune(':'));
+    auto bad = submit(type(std::move(prompt2), "5000"));
+    CHECK(bad.cursor == 0x40);
+    CHECK_FALSE(bad.message.empty());
+}
+
+TEST_CASE("hexview searches text and hex patterns") {
+    std::string bytes(5000, '\0');
+    bytes.replace(100, 6, "needle");
+    bytes.replace(4000, 6, "needle");
+    bytes.replace(2000, 4, "\xde\xad\xbe\xef");
+
+    HexViewModel m;
+    m.file = std::make_shared<MappedFile>(MappedFile::from_bytes(bytes));
+
+    auto [p1, c1] = hexview_update(std::move(m), rune('/'));
+    auto first = submit(type(std::move(p1), "needle"));
+    CHECK(first.cursor == 100);
+    CHECK(first.match == 100);
+    CHECK_FALSE(first.searching);
+
+    // Next match, then wrap around
+    auto [n1, c2] = hexview_update(std::move(first), rune('n'));
+    auto second = std::move(n1);
+    if (c2) {
+        auto [r, c] = hexview_update(std::move(second), *c2());
+        second = std::move(r);
+    }
+    CHECK(second.cursor == 4000);
+    auto [n2, c3] = hexview_update(std::move(second), rune('n'));
+    auto third = std::move(n2);
+    auto [r3, c4] = hexview_update(std::move(third), *c3());
+    CHECK(r3.cursor == 100);
+    CHECK(r3.message == "search wrapped");
+
+    auto [p2, c5] = hexview_update(std::move(r3), rune('x'));
+    auto hex = submit(type(std::move(p2), "deadbeef"));
+    CHECK(hex.cursor == 2000);
+    CHECK(hexview_view(hex).find("de") != std::string::npos);
+
+    auto [p3, c6] = hexview_update(std::move(hex), rune('/'));
+    auto none = submit(type(std::move(p3), "absent"));
+    CHECK(none.message == "pattern not found");
+    CHECK(none.cursor == 2000);
+}
+
+TEST_CASE("hexview ignores stale search results") {
+    HexViewModel m;
+    m.file = std::make_shared<MappedFile>(MappedFile::from_bytes("abcabc"));
+    m.search_generation = 5;
+    m.searching = true;
+    auto [r, c] = hexview_update(std::move(m), tea::TaskMsg{0, HexSearchResult{4, 3, false}});
+    CHECK(r.cursor == 0);
+    CHECK(r.searching);
+}
@@ -314,3 +314,11 @@ TEST_CASE("List view with items") {
     std::string view = scan::list_view(m);
     CHECK(!view.empty());
 }
+
+TEST_CASE("List items stream in") {
+    scan::ListModel m;
+    auto [m1, c1] = scan::list_update(m, scan::tea::LogMsg{0, "red\ngreen\n", false});
+    auto [m2, c2] = scan::list_update(m1, scan::tea::LogMsg{0, "blue", true});
+    REQUIRE(m2.item_count() == 3);
+    CHECK(m2.get_title(2) == "blue");
+}
@@ -0,0 +1,268 @@
+/// @file test_logview.cpp
+/// @brief Tests for the LogBuffer ring and LogView component
+
+#include <doctest/doctest.h>
+#include <scan/bubbles/logview.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace scan;
+
+namespace {
+
+    tea::KeyMsg rune(char32_t c) {
+        tea::KeyMsg k;
+        k.key = input::Key::Rune;
+        k.rune = c;
+        return k;
+    }
+
+    std::vector<std::string> visible_lines(const LogViewModel &m) {
+        std::vector<std::string> out;
+        for (size_t i = m.visible_head; i < m.visible.size(); i++) {
+            out.emplace_back(m.buffer.text(m.visible[i]));
+        }
+        return out;
+    }
+
+} // namespace
+
+TEST_CASE("log level detection") {
+    CHECK(log_level_detect("2024-01-01 12:00:00 INFO started") == LogLevel::Info);
+    CHECK(log_level_detect("[warn] disk almost full") == LogLevel::Warn);
+    CHECK(log_level_detect("E: ERR something broke") == LogLevel::Error);
+    CHECK(log_level_detect("level=debug msg=hello") == LogLevel::Debug);
+    CHECK(log_level_detect("FATAL: out of memory") == LogLevel::Fatal);
+    CHECK(log_level_detect("just some information") == LogLevel::None);
+    CHECK(log_level_detect("") == LogLevel::None);
+}
+
+TEST_CASE("log buffer evicts by line count") {
+    LogBuffer buf(3, 1024);
+    for (int i = 0; i < 5; i++) {
+        buf.push("line " + std::to_string(i), LogLevel::None, 0);
+    }
+    CHECK(buf.size() == 3);
+    CHECK(buf.first() == 2);
+    CHECK(buf.end() == 5);
+    CHECK(buf.text(2) == "line 2");
+    CHECK(buf.text(4) == "line 4");
+    CHECK_FALSE(buf.contains(1));
+}
+
+TEST_CASE("log buffer evicts by bytes and wraps the arena") {
+    LogBuffer buf(100, 32);
+    std::vector<std::string> pushed;
+    for (int i = 0; i < 50; i++) {
+        std::string line(static_cast<size_t>(3 + i % 7), static_cast<char>('a' + i % 26));
+        pushed.push_back(line);
+        buf.push(line, LogLevel::Info, i);
+
+        // Every stored line must still read back intact after wrapping
+        size_t bytes = 0;
+        for (uint64_t seq = buf.first(); seq < buf.end(); seq++) {
+            CHECK(buf.text(seq) == pushed[seq]);
+            CHECK(buf.line(seq).timestamp_ms == static_cast<int64_t>(seq));
+            bytes += buf.text(seq).size();
+        }
+        CHECK(bytes <= 32);
+        CHECK(buf.end() == static_cast<uint64_t>(i + 1));
+    }
+
+    // Oversized lines are truncated to the arena
+    buf.push(std::string(100, 'x'), LogLevel::None, 0);
+    CHECK(buf.size() == 1);
+    CHECK(buf.text(buf.end() - 1).size() == 32);
+}
+
+TEST_CASE("logview filters incrementally") {
+    LogViewModel m;
+    m.height = 10;
+    logview_add_lines(m, "INFO one\nWARN two\nERROR three\n  at frame\nDEBUG four\n");
+    CHECK(logview_visible_count(m) == 5);
+    // Continuation lines inherit the previous level
+    CHECK(m.buffer.line(3).level == LogLevel::Error);
+
+    logview_set_min_level(m, LogLevel::Warn);
+    CHECK(visible_lines(m) == std::vector<std::string>{"WARN two", "ERROR three", "  at frame"});
+
+    // New lines are tested as they arrive
+    logview_add_lines(m, "INFO five\nWARN six");
+    CHECK(logview_visible_count(m) == 4);
+
+    logview_set_query(m, "t");
+    CHECK(visible_lines(m) == std::vector<std::string>{"WARN two", "ERROR three", "  at frame"});
+    logview_set_query(m, "th");
+    CHECK(visible_lines(m) == std::vector<std::string>{"ERROR three"});
+
+    // Loosening the filter rebuilds from the buffer
+    logview_set_query(m, "");
+    logview_set_min_level(m, LogLevel::None);
+    CHECK(logview_visible_count(m) == 7);
+
+    m.ignore_case = false;
+    logview_set_query(m, "warn");
+    CHECK(logview_visible_count(m) == 0);
+}
+
+TEST_CASE("logview drops evicted lines from the index") {
+    LogViewModel m;
+    m.buffer = LogBuffer(4, 1024);
+    m.height = 2;
+    m.query = "keep";
+    for (int i = 0; i < 10; i++) {
+        logview_add_lines(m, (i % 2 ? "keep " : "skip ") + std::to_string(i));
+    }
+    CHECK(m.buffer.size() == 4);
+    CHECK(visible_lines(m) == std::vector<std::string>{"keep 7", "keep 9"});
+    CHECK(m.offset == 0);
+}
+
+TEST_CASE("logview joins partial lines from raw streams") {
+    LogViewModel m;
+    logview_append(m, "hel");
+    logview_append(m, "lo\r\nwor");
+    CHECK(visible_lines(m) == std::vector<std::string>{"hello"});
+    auto [done, cmd] = logview_update(std::move(m), tea::ExecExitMsg{0, 0, 0, ""});
+    CHECK(visible_lines(done) == std::vector<std::string>{"hello", "wor"});
+    CHECK(done.done);
+}
+
+TEST_CASE("logview bounds a stream that never ends a line") {
+    LogViewModel m;
+    m.max_partial = 64 * 1024;
+    std::string chunk(60000, 'x');
+    for (int i = 0; i < 70; i++) { // ~4 MB, no newline
+        logview_append(m, chunk);
+        REQUIRE(m.partial.size() < m.max_partial);
+    }
+    CHECK(m.buffer.size() == 70 * chunk.size() / m.max_partial);
+    CHECK(m.buffer.text(m.visible.back()).size() == m.max_partial);
+
+    // A progress bar keeps only its latest redraw
+    LogViewModel bar;
+    logview_append(bar, "10%\r20%\r");
+    logview_append(bar, "30%");
+    CHECK(bar.partial == "30%");
+    logview_append(bar, "\r40%\n");
+    CHECK(visible_lines(bar) == std::vector<std::string>{"40%"});
+}
+
+TEST_CASE("log_read_fd breaks a newline-free stream into bounded pieces") {
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    const size_t total = 4 * 1024 * 1024;
+    std::thread writer([&]() {
+        std::string chunk(65536, 'y');
+        for (size_t sent = 0; sent < total; sent += chunk.size()) {
+            CHECK(::write(fds[1], chunk.data(), chunk.size()) == static_cast<ssize_t>(chunk.size()));
+        }
+        ::close(fds[1]);
+    });
+
+    size_t received = 0;
+    size_t largest = 0;
+    log_read_fd(fds[0], 100000)([&](std::string_view text) {
+        received += text.size();
+        largest = std::max(largest, text.size());
+        return true;
+    });
+    writer.join();
+    ::close(fds[0]);
+    CHECK(received == total);
+    CHECK(largest <= 100000);
+}
+
+TEST_CASE("logview follow and scrolling") {
+    LogViewModel m;
+    m.height = 3;
+    for (int i = 0; i < 10; i++) {
+        logview_add_lines(m, "line " + std::to_string(i));
+    }
+    CHECK(m.offset == 7);
+
+    auto [up, c1] = logview_update(std::move(m), rune('k'));
+    CHECK(up.offset == 6);
+    CHECK_FALSE(up.follow);
+
+    // Paused: new lines don't move the view
+    logview_add_lines(up, "line 10");
+    CHECK(up.offset == 6);
+
+    auto [bottom, c2] = logview_update(std::move(up), rune('G'));
+    CHECK(bottom.follow);
+    CHECK(bottom.offset == 8);
+}
+
+TEST_CASE("logview query editing and view") {
+    LogViewModel m;
+    m.height = 2;
+    m.width = 40;
+    logview_add_lines(m, "INFO alpha\nWARN beta\nINFO gamma");
+
+    auto [e1, c1] = logview_update(std::move(m), rune('/'));
+    CHECK(e1.editing_query);
+    auto [e2, c2] = logview_update(std::move(e1), rune('a'));
+    auto [e3, c3] = logview_update(std::move(e2), rune('l'));
+    CHECK(e3.query == "al");
+    CHECK(visible_lines(e3) == std::vector<std::string>{"INFO alpha"});
+
+    tea::KeyMsg esc;
+    esc.key = input::Key::Escape;
+    auto [e4, c4] = logview_update(std::move(e3), esc);
+    CHECK_FALSE(e4.editing_query);
+    CHECK(e4.query.empty());
+    CHECK(logview_visible_count(e4) == 3);
+
+    std::string view = logview_view(e4);
+    CHECK(view.find("gamma") != std::string::npos);
+    CHECK(view.find("alpha") == std::string::npos); // Scrolled past, only 2 rows shown
+    CHECK(view.find("3/3 lines") != std::string::npos);
+}
+
+TEST_CASE("logview ignores messages for other ids") {
+    LogViewModel m;
+    m.id = 1;
+    auto [other, c1] = logview_update(std::move(m), tea::LogMsg{2, "INFO x", false});
+    CHECK(other.buffer.empty());
+    auto [mine, c2] = logview_update(std::move(other), tea::LogMsg{1, "INFO x\nINFO y\n", true});
+    CHECK(mine.buffer.size() == 2);
+    CHECK(mine.done);
+}
+
+TEST_CASE("a bounded mailbox holds back a fast producer") {
+    tea::Mailbox mailbox;
+    mailbox.set_capacity(8);
+
+    std::thread producer([&]() {
+        for (int i = 0; i < 10000; i++) {
+            mailbox.post_wait(tea::LogMsg{1, std::to_string(i), false});
+        }
+    });
+    int received = 0;
+    size_t largest = 0;
+    while (received < 10000) {
+        auto batch = mailbox.take();
+        largest = std::max(largest, batch.size());
+        for (; !batch.empty(); batch.pop()) {
+            CHECK(tea::try_as<tea::LogMsg>(batch.front())->text == std::to_string(received++));
+        }
+    }
+    producer.join();
+    CHECK(largest <= 8);
+
+    // A full mailbox refuses try_post, and close() releases a waiting producer
+    for (int i = 0; i < 8; i++) {
+        CHECK(mailbox.try_post(tea::LogMsg{1, "x", false}));
+    }
+    CHECK_FALSE(mailbox.try_post(tea::LogMsg{1, "x", false}));
+    std::thread blocked([&]() { CHECK_FALSE(mailbox.post_wait(tea::LogMsg{1, "late", false})); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    mailbox.close();
+    blocked.join();
+    CHECK(mailbox.take().size() == 8);
+}
@@ -0,0 +1,70 @@
+/// @file test_theme.cpp
+/// @brief Tests for theme publishing, snapshots and concurrent theme access
+
+#include <doctest/doctest.h>
+#include <scan/style/style.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace scan;
+
+TEST_CASE("theme reads stay valid while the theme changes") {
+    const Theme &before = current_theme();
+    Color primary = before.colors.primary;
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> bad{0};
+    std::thread reader([&] {
+        while (!stop) {
+            Color c = theme_snapshot()->colors.primary;
+            if (c != default_theme().colors.primary && c != light_theme().colors.primary) {
+                bad++;
+            }
+            Style().foreground(current_theme().colors.secondary).render("x");
+        }
+    });
+    for (int i = 0; i < 200; i++) {
+        set_theme(i % 2 ? default_theme() : light_theme());
+    }
+    stop = true;
+    reader.join();
+
+    CHECK(bad.load() == 0);
+    CHECK(before.colors.primary == primary); // Old reads are not overwritten
+    set_theme(default_theme());
+}
+
+TEST_CASE("a theme read survives later reads after a switch") {
+    std::thread([] {
+        set_theme(light_theme());
+        const auto &held = current_theme();
+        std::thread([] { set_theme(default_theme()); }).join();
+
+        // What a component constructor does: read the (now switched) theme again
+        CHECK(theme_snapshot()->colors.primary == default_theme().colors.primary);
+        CHECK(current_theme().colors.primary == default_theme().colors.primary);
+        CHECK(held.colors.primary == light_theme().colors.primary);
+    }).join();
+    set_theme(default_theme());
+}
+
+TEST_CASE("replaced themes are freed once no snapshot holds them") {
+    std::thread([] {
+        set_theme(light_theme());
+        std::weak_ptr<const Theme> old = theme_snapshot();
+        std::shared_ptr<const Theme> held = theme_snapshot();
+        set_theme(default_theme());
+        CHECK_FALSE(old.expired());
+        CHECK(held->colors.primary == light_theme().colors.primary);
+        held.reset();
+        CHECK(theme_snapshot()->colors.primary == default_theme().colors.primary); // Drops this thread's cache
+        CHECK(old.expired());
+
+        modify_theme([](Theme &t) { t.colors.primary = {1, 2, 3}; });
+        CHECK(current_theme().colors.primary == Color(1, 2, 3));
+        CHECK(current_theme().colors.bg == default_theme().colors.bg);
+    }).join();
+    set_theme(default_theme());
+}
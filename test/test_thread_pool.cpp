@@ -0,0 +1,163 @@
+/// @file test_thread_pool.cpp
+/// @brief Tests for the thread pool
+
+#include <doctest/doctest.h>
+#include <scan/tea/task.hpp>
+#include <scan/util/thread_pool.hpp>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace scan;
+
+TEST_CASE("submit returns results through futures") {
+    ThreadPool pool(2);
+    CHECK(pool.size() == 2);
+    auto a = pool.submit([] { return 6 * 7; });
+    auto b = pool.submit([] { return std::string("done"); });
+    CHECK(a.get() == 42);
+    CHECK(b.get() == "done");
+
+    auto failing = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    CHECK_THROWS_AS(failing.get(), std::runtime_error);
+}
+
+TEST_CASE("parallel_for visits every index exactly once") {
+    ThreadPool pool(3);
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallel_for(hits.size(), [&](size_t i) { hits[i]++; });
+    for (auto &h : hits) {
+        CHECK(h.load() == 1);
+    }
+
+    // Nested use from inside a job does not deadlock
+    std::atomic<int> inner{0};
+    pool.parallel_for(4, [&](size_t) { pool.parallel_for(4, [&](size_t) { inner++; }); });
+    CHECK(inner.load() == 16);
+
+    CHECK_THROWS_AS(pool.parallel_for(8,
+                                      [](size_t i) {
+                                          if (i == 5) {
+                                              throw std::runtime_error("five");
+                                          }
+                                      }),
+                    std::runtime_error);
+}
+
+TEST_CASE("parallel_executor runs a batch on the given pool") {
+    ThreadPool pool(2);
+    auto run = parallel_executor(pool);
+    std::vector<std::atomic<int>> hits(500);
+    run(hits.size(), [&hits](size_t i) { hits[i]++; });
+    for (auto &h : hits) {
+        CHECK(h.load() == 1);
+    }
+}
+
+TEST_CASE("interactive jobs run before queued background jobs") {
+    ThreadPool pool(1);
+    std::promise<void> gate;
+    std::promise<void> started;
+    auto blocker = pool.submit([opened = gate.get_future().share(), &started] {
+        started.set_value();
+        opened.wait();
+    });
+    // The worker takes its newest job first: make sure it holds the blocker before queueing more
+    started.get_future().wait();
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto record = [&](const char *name) {
+        return [&, name] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(name);
+        };
+    };
+    auto background = pool.submit(record("background"), Priority::Background);
+    auto interactive = pool.submit(record("interactive"), Priority::Interactive);
+    gate.set_value();
+    background.get();
+    interactive.get();
+    blocker.get();
+
+    REQUIRE(order.size() == 2);
+    CHECK(order[0] == "interactive");
+    CHECK(order[1] == "background");
+}
+
+TEST_CASE("jobs cancelled before they start are skipped") {
+    ThreadPool pool(1);
+    std::promise<void> gate;
+    std::promise<void> started;
+    auto blocker = pool.submit([opened = gate.get_future().share(), &started] {
+        started.set_value();
+        opened.wait();
+    });
+    // Hold the worker before queueing, as above
+    started.get_future().wait();
+
+    CancelToken token;
+    std::atomic<int> ran{0};
+    auto dropped = pool.submit([&] { return ++ran; }, Priority::Background, token);
+    pool.execute([&] { ran++; }, Priority::Interactive, token);
+    auto kept = pool.submit([&] { return 7; }, Priority::Background);
+    token.cancel();
+    CHECK(token.cancelled());
+    gate.set_value();
+
+    CHECK(kept.get() == 7);
+    blocker.get();
+    CHECK(ran.load() == 0);
+    bool broken = false;
+    try {
+        dropped.get();
+    } catch (const std::future_error &e) {
+        broken = e.code() == std::future_errc::broken_promise;
+    }
+    CHECK(broken);
+
+    CHECK_FALSE(CancelToken::none().cancelled());
+    CancelToken::none().cancel(); // No-op
+    CHECK_FALSE(CancelToken::none().cancelled());
+}
+
+TEST_CASE("a job waiting on a job it submitted is helped by another worker") {
+    ThreadPool pool(2);
+    // The inner job lands on the outer job's own deque; the idle worker steals it
+    auto outer = pool.submit([&pool] { return pool.submit([] { return 21; }).get() * 2; });
+    CHECK(outer.get() == 42);
+
+    std::atomic<int> total{0};
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 100; i++) {
+        auto priority = i % 2 ? Priority::Background : Priority::Interactive;
+        futures.push_back(pool.submit([&total, i] { total += i; }, priority));
+    }
+    for (auto &f : futures) {
+        f.get();
+    }
+    CHECK(total.load() == 4950);
+}
+
+TEST_CASE("in_worker tells pool jobs apart from other threads") {
+    ThreadPool pool(2);
+    ThreadPool other(1);
+    CHECK_FALSE(pool.in_worker());
+    CHECK(pool.submit([&pool] { return pool.in_worker(); }).get());
+    CHECK_FALSE(other.submit([&pool] { return pool.in_worker(); }).get());
+}
+
+TEST_CASE("tea::async honours its cancel token with no program running") {
+    CancelToken token;
+    auto cmd = tea::async([]() -> std::optional<tea::Msg> { return tea::TickMsg{3}; }, Priority::Background, token);
+    auto msg = cmd();
+    REQUIRE(msg.has_value());
+    CHECK(std::get<tea::TickMsg>(*msg).id == 3);
+
+    token.cancel();
+    CHECK_FALSE(cmd().has_value());
+}
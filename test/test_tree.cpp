@@ -0,0 +1,171 @@
+/// @file test_tree.cpp
+/// @brief Tests for the lazily loaded Tree component
+
+#include <doctest/doctest.h>
+#include <scan/bubbles/tree.hpp>
+
+#include <stdexcept>
+
+using namespace scan;
+
+namespace {
+
+    tea::KeyMsg key(input::Key k) {
+        tea::KeyMsg msg;
+        msg.key = k;
+        return msg;
+    }
+
+    // Every item "n" has children "n/0" .. "n/(fanout-1)" down to a fixed depth
+    TreeLoader numbered_loader(int fanout, int max_depth, int *calls = nullptr) {
+        return [=](const TreeItem &parent) {
+            if (calls) {
+                (*calls)++;
+            }
+            int depth = static_cast<int>(std::count(parent.key.begin(), parent.key.end(), '/')) + 1;
+            std::vector<TreeItem> children;
+            for (int i = 0; i < fanout; i++) {
+                std::string k = parent.key + "/" + std::to_string(i);
+                children.emplace_back(k, k, depth < max_depth);
+            }
+            return children;
+        };
+    }
+
+    std::vector<std::string> visible_labels(const TreeModel &m) {
+        std::vector<std::string> out;
+        for (uint32_t x = tree_node_at(m, 0); x != 0 && out.size() < tree_row_count(m); x = tree_next_row(m, x)) {
+            out.push_back(m.nodes[x].item.label);
+        }
+        return out;
+    }
+
+} // namespace
+
+TEST_CASE("tree expands and collapses lazily") {
+    int calls = 0;
+    TreeModel m;
+    m.loader = numbered_loader(2, 3, &calls);
+    tree_set_roots(m, {{"a", "a", true}, {"b", "b", true}});
+    CHECK(tree_row_count(m) == 2);
+    CHECK(calls == 0);
+
+    uint32_t a = tree_node_at(m, 0);
+    tree_expand(m, a);
+    CHECK(calls == 1);
+    CHECK(visible_labels(m) == std::vector<std::string>{"a", "a/0", "a/1", "b"});
+
+    tree_expand(m, tree_node_at(m, 2)); // a/1
+    CHECK(visible_labels(m) == std::vector<std::string>{"a", "a/0", "a/1", "a/1/0", "a/1/1", "b"});
+
+    // Collapsing hides descendants; re-expanding restores them without reloading
+    tree_collapse(m, a);
+    CHECK(visible_labels(m) == std::vector<std::string>{"a", "b"});
+    tree_expand(m, a);
+    CHECK(calls == 2);
+    CHECK(tree_row_count(m) == 6);
+    CHECK(m.nodes[tree_node_at(m, 4)].item.label == "a/1/1");
+}
+
+TEST_CASE("tree row lookup matches a full walk") {
+    TreeModel m;
+    m.loader = numbered_loader(5, 4);
+    tree_set_roots(m, {{"r", "r", true}, {"s", "s", true}});
+    // Expand a scattered set of nodes at different depths
+    tree_expand(m, tree_node_at(m, 1));
+    tree_expand(m, tree_node_at(m, 0));
+    for (size_t row : {3, 1, 9, 12, 20}) {
+        if (row < tree_row_count(m)) {
+            tree_expand(m, tree_node_at(m, row));
+        }
+    }
+
+    size_t row = 0;
+    for (uint32_t x = tree_node_at(m, 0); x != 0; x = tree_next_row(m, x), row++) {
+        CHECK(tree_node_at(m, row) == x);
+        CHECK(tree_row_of(m, x) == row);
+    }
+    CHECK(row == tree_row_count(m));
+}
+
+TEST_CASE("tree handles very wide nodes") {
+    TreeModel m;
+    m.loader = numbered_loader(50000, 1);
+    tree_set_roots(m, {{"big", "big", true}, {"after", "after", false}});
+    tree_expand(m, tree_node_at(m, 0));
+    CHECK(tree_row_count(m) == 50002);
+    CHECK(m.nodes[tree_node_at(m, 25000)].item.label == "big/24999");
+    CHECK(m.nodes[tree_node_at(m, 50001)].item.label == "after");
+
+    tree_move_to(m, 40000);
+    m.height = 5;
+    tree_clamp_offset(m);
+    std::string view = tree_view(m);
+    CHECK(view.find("big/39999") != std::string::npos);
+    CHECK(view.find("big/0") == std::string::npos);
+}
+
+TEST_CASE("tree keys navigate and toggle") {
+    TreeModel m;
+    m.loader = numbered_loader(3, 2);
+    tree_set_roots(m, {{"x", "x", true}});
+
+    auto [m1, c1] = tree_update(std::move(m), key(input::Key::Right));
+    CHECK(tree_row_count(m1) == 4);
+    auto [m2, c2] = tree_update(std::move(m1), key(input::Key::Right));
+    CHECK(m2.cursor == 1);
+    auto [m3, c3] = tree_update(std::move(m2), key(input::Key::Down));
+    auto [m4, c4] = tree_update(std::move(m3), key(input::Key::Left));
+    CHECK(m4.cursor == 0); // Leaf: jump to parent
+    auto [m5, c5] = tree_update(std::move(m4), key(input::Key::Left));
+    CHECK(tree_row_count(m5) == 1);
+    auto [m6, c6] = tree_update(std::move(m5), key(input::Key::Enter));
+    CHECK(m6.submitted);
+    CHECK(tree_path(m6, tree_node_at(m6, m6.cursor)) == std::vector<std::string>{"x"});
+}
+
+TEST_CASE("tree loads asynchronously through task messages") {
+    TreeModel m;
+    m.id = 7;
+    m.async = true;
+    m.loader = numbered_loader(4, 2);
+    tree_set_roots(m, {{"a", "a", true}, {"b", "b", true}});
+    m.cursor = 1;
+
+    // Expand "a" while the cursor sits on "b"
+    auto cmd = tree_expand(m, tree_node_at(m, 0));
+    REQUIRE(cmd);
+    CHECK(m.nodes[tree_node_at(m, 0)].state == TreeModel::LoadState::Loading);
+    CHECK(tree_view(m).find("loading") != std::string::npos);
+
+    // Without a running program the task completes synchronously
+    auto msg = cmd();
+    REQUIRE(msg);
+    auto [done, c] = tree_update(std::move(m), *msg);
+    CHECK(tree_row_count(done) == 6);
+    CHECK(done.nodes[tree_node_at(done, done.cursor)].item.label == "b");
+
+    // Results for other trees are ignored
+    auto [other, c2] = tree_update(std::move(done), tea::TaskMsg{8, TreeLoadResult{1, {}, ""}});
+    CHECK(tree_row_count(other) == 6);
+}
+
+TEST_CASE("tree loader errors are shown and retried") {
+    bool fail = true;
+    TreeModel m;
+    m.loader = [&](const TreeItem &) -> std::vector<TreeItem> {
+        if (fail) {
+            throw std::runtime_error("permission denied");
+        }
+        return {{"child"}};
+    };
+    tree_set_roots(m, {{"dir", "dir", true}});
+    tree_expand(m, 1);
+    CHECK(m.nodes[1].state == TreeModel::LoadState::Failed);
+    CHECK(tree_view(m).find("permission denied") != std::string::npos);
+
+    fail = false;
+    tree_collapse(m, 1);
+    tree_expand(m, 1);
+    CHECK(visible_labels(m) == std::vector<std::string>{"dir", "child"});
+}
@@ -4,6 +4,8 @@
 #include <doctest/doctest.h>
 #include <scan/bubbles/viewport.hpp>
 
+#include <thread>
+
 TEST_CASE("ViewportModel initialization") {
     scan::ViewportModel model;
 
@@ -239,3 +241,90 @@ TEST_CASE("Viewport builder methods") {
     CHECK(viewport.at_top());
     CHECK(viewport.scroll_percent() == 0);
 }
+
+TEST_CASE("viewport lines are views into one shared buffer") {
+    auto text = std::make_shared<const std::string>("first\n\nthird line\nlast");
+    scan::ViewportModel a;
+    a.wrap = false;
+    scan::viewport_set_content(a, text);
+    REQUIRE(a.lines.size() == 4);
+    CHECK(a.lines[1].empty());
+    CHECK(a.lines[3] == "last");
+    CHECK(a.lines[2].data() == text->data() + 7); // Not copied
+
+    // Copies share the content; appending to one leaves the other as it was
+    scan::ViewportModel b = a;
+    CHECK(b.lines[0].data() == a.lines[0].data());
+    scan::viewport_append_line(b, "appended");
+    scan::viewport_append_line(a, "other");
+    CHECK(a.lines.size() == 5);
+    CHECK(b.lines.size() == 5);
+    CHECK(a.lines[4] == "other");
+    CHECK(b.lines[4] == "appended");
+    CHECK(b.lines[3] == "last");
+
+    // Trailing newline does not add an empty line, as with std::getline
+    scan::viewport_set_content(a, "x\ny\n");
+    CHECK(a.lines.size() == 2);
+    CHECK(a.lines.back() == "y");
+}
+
+TEST_CASE("viewport appends and drops lines across chunks") {
+    scan::ViewportModel model;
+    model.wrap = false;
+    std::string big(70000, 'x');
+    for (int i = 0; i < 10000; i++) {
+        scan::viewport_append_line(model, i % 1000 == 0 ? big : std::to_string(i));
+    }
+    REQUIRE(model.lines.size() == 10000);
+    CHECK(model.lines[1] == "1");
+    CHECK(model.lines[1000].size() == big.size());
+    CHECK(model.lines[9999] == "9999");
+
+    model.y_offset = 8000;
+    scan::viewport_drop_front(model, 7000);
+    CHECK(model.lines.size() == 3000);
+    CHECK(model.y_offset == 1000);
+    CHECK(model.lines[0].size() == big.size()); // Line 7000
+    CHECK(model.lines[1] == "7001");
+    CHECK(model.lines[2999] == "9999");
+    scan::viewport_append_line(model, "end");
+    CHECK(model.lines.back() == "end");
+
+    size_t n = 0;
+    for (std::string_view line : model.lines) {
+        n += line.empty() ? 0 : 1;
+    }
+    CHECK(n == 3001);
+}
+
+TEST_CASE("a copy can be rendered while the original keeps appending") {
+    scan::ViewportModel a;
+    a.wrap = false;
+    for (int i = 0; i < 100; i++) {
+        scan::viewport_append_line(a, "line " + std::to_string(i));
+    }
+
+    // b clones the index on its first append; a must then stop growing the chunk b still references
+    scan::ViewportModel b = a;
+    scan::viewport_append_line(b, "b only");
+    std::thread reader([b] {
+        for (int round = 0; round < 200; round++) {
+            size_t bytes = 0;
+            for (std::string_view line : b.lines) {
+                bytes += line.size();
+            }
+            CHECK(bytes > 0);
+        }
+    });
+    for (int i = 0; i < 1000; i++) {
+        scan::viewport_append_line(a, "more " + std::to_string(i));
+    }
+    reader.join();
+
+    CHECK(a.lines.size() == 1100);
+    CHECK(a.lines[100] == "more 0");
+    CHECK(a.lines[100].data() != a.lines[99].data() + a.lines[99].size()); // Went to a new chunk
+    CHECK(b.lines.size() == 101);
+    CHECK(b.lines[100] == "b only");
+}